@@ -126,6 +126,13 @@ function et.G_SetSpawnVar(entity, key, value) end
 ---@return string|integer|table
 function et.gentity_get(entitynum, fieldname, array_index) end
 
+---Get several entity field values with a single call
+---@param entitynum number
+---@param fieldnames string[]
+---@param array_index? number field array index used for array fields
+---@return table values keyed by field name
+function et.gentity_getmany(entitynum, fieldnames, array_index) end
+
 ---Set entity field value
 ---@param entitynum number
 ---@param fieldname string
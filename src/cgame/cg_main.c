@@ -48,6 +48,7 @@ int dll_trap_SysFlashWindow;
 int dll_trap_CommandComplete;
 int dll_trap_CmdBackup_Ext;
 int dll_trap_MatchPaused;
+int dll_trap_CvarChanges;
 
 /**
  * @brief This is the only way control passes into the module.
@@ -726,6 +727,30 @@ static qboolean CG_RegisterOrUpdateCvars(cvarTable_t *cv)
 	return qfalse;
 }
 
+static int cvarSequence = -1;   ///< position in the engine's cvar modification sequence
+
+/**
+ * @brief CG_CvarInList
+ * @param[in] handle
+ * @param[in] handles
+ * @param[in] numHandles
+ * @return
+ */
+static qboolean CG_CvarInList(cvarHandle_t handle, const int *handles, int numHandles)
+{
+	int i;
+
+	for (i = 0; i < numHandles; i++)
+	{
+		if (handles[i] == handle)
+		{
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief CG_RegisterCvars
  */
@@ -737,6 +762,9 @@ void CG_RegisterCvars(void)
 
 	CG_Printf("%d client cvars in use\n", cvarTableSize);
 
+	// some cvars are forced to update on the first run, poll them all
+	cvarSequence = -1;
+
 	trap_Cvar_Set("cg_letterbox", "0");   // force this for people who might have it in their cfg
 
 	// custom fonts, register here since these are ETL-specific features
@@ -795,16 +823,26 @@ void CG_UpdateCvars(void)
 	unsigned int i;
 	qboolean     fSetFlags = qfalse;
 	cvarTable_t  *cv;
+	int          changed[MAX_CVAR_CHANGES];
+	int          numChanged;
 
 	if (!cvarsLoaded)
 	{
 		return;
 	}
 
-	for (i = 0, cv = cvarTable ; i < cvarTableSize ; i++, cv++)
+	// -1 when the engine can't tell, then all cvars are polled
+	numChanged = trap_CvarChanges(&cvarSequence, changed, MAX_CVAR_CHANGES);
+
+	for (i = 0, cv = cvarTable ; i < cvarTableSize && numChanged ; i++, cv++)
 	{
 		if (cv->vmCvar)
 		{
+			if (numChanged > 0 && !CG_CvarInList(cv->vmCvar->handle, changed, numChanged))
+			{
+				continue;
+			}
+
 			trap_Cvar_Update(cv->vmCvar);
 			if (cv->modificationCount != cv->vmCvar->modificationCount)
 			{
@@ -863,6 +901,7 @@ void CG_UpdateCvars(void)
 						// wait for the next frame, otherwise the hud load
 						// will erase the forced value
 						cv->modificationCount = -1;
+						cvarSequence          = -1;
 					}
 					else
 					{
@@ -2882,6 +2921,7 @@ static ID_INLINE void CG_SetupExtensions(void)
 		CG_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_CommandComplete, "trap_CommandComplete_Legacy");
 		CG_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_CmdBackup_Ext, "trap_CmdBackup_Ext_Legacy");
 		CG_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_MatchPaused, "trap_MatchPaused_Legacy");
+		CG_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_CvarChanges, "trap_CvarChanges_Legacy");
 	}
 }
 
@@ -289,6 +289,7 @@ typedef enum
 
 	CG_CMDBACKUP_EXT,
 	CG_MATCHPAUSED,
+	CG_CVAR_CHANGES,
 
 } cgameImport_t;
 
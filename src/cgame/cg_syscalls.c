@@ -1983,3 +1983,19 @@ void trap_MatchPaused(qboolean matchPaused)
 		SystemCall(dll_trap_MatchPaused, matchPaused);
 	}
 }
+
+/**
+ * @brief Extension for asking the engine which cvars were modified since the last call
+ * @param[in,out] sequence - -1 initially
+ * @param[out] handles
+ * @param[in] maxHandles
+ * @return Number of changed handles, -1 if all cvars have to be updated
+ */
+int trap_CvarChanges(int *sequence, int *handles, int maxHandles)
+{
+	if (dll_trap_CvarChanges)
+	{
+		return SystemCall(dll_trap_CvarChanges, sequence, handles, maxHandles);
+	}
+	return -1;
+}
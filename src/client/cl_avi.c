@@ -80,6 +80,11 @@ typedef struct aviFileData_s
 	byte *cBuffer, *eBuffer;
 
 	qboolean pipe;
+
+	int frameSize;                  ///< size of a queued video frame
+	int jpegQuality;
+	int numDroppedFrames;
+	qboolean closing;               ///< CL_CloseAVI collects the frames still in the renderer
 } aviFileData_t;
 
 static aviFileData_t afd;
@@ -89,6 +94,85 @@ static aviFileData_t afd;
 static byte buffer[MAX_AVI_BUFFER];
 static int  bufIndex;
 
+#define PCM_BUFFER_SIZE 44100
+
+#define AVI_QUEUE_CHUNKS 32         ///< chunks waiting for the writer thread
+#define AVI_QUEUE_FRAMES 4          ///< video frames waiting for the writer thread, further frames are dropped
+
+/**
+ * @enum aviChunkType_t
+ * @brief
+ */
+typedef enum
+{
+	AVI_CHUNK_VIDEO,                ///< encoded video frame, empty for a dropped frame
+	AVI_CHUNK_PIXELS,               ///< video frame the writer thread still has to encode
+	AVI_CHUNK_AUDIO
+} aviChunkType_t;
+
+/**
+ * @struct aviChunk_s
+ * @typedef aviChunk_t
+ * @brief
+ */
+typedef struct aviChunk_s
+{
+	aviChunkType_t type;
+	byte *data;
+	int size;
+	int padding;                    ///< row padding of AVI_CHUNK_PIXELS
+} aviChunk_t;
+
+/**
+ * @struct aviWriter_s
+ * @typedef aviWriter_t
+ * @brief Queue between the producers and the thread encoding and writing the chunks
+ *
+ * Chunks are queued by the main thread, or by the render thread while the main thread
+ * waits for it. Once the writer thread runs it owns the files and the size counters
+ * of afd until it is flushed.
+ */
+typedef struct aviWriter_s
+{
+	void *thread;
+	void *mutex;                    ///< protects framesQueued and the counters of afd the writer updates
+	void *queued;                   ///< posted per queued chunk
+	void *free;                     ///< posted per written chunk
+
+	aviChunk_t chunks[AVI_QUEUE_CHUNKS];
+	int head;                       ///< next chunk to queue, producer only
+	int tail;                       ///< next chunk to write, writer only
+
+	byte *frames[AVI_QUEUE_FRAMES];
+	int framesQueued;
+	int nextFrame;                  ///< producer only
+
+	byte *audio;                    ///< PCM_BUFFER_SIZE per chunk
+	byte *encodeBuffer;             ///< writer only
+	FILE *file;                     ///< afd.f and afd.idxF, written to directly by the writer
+	FILE *indexFile;
+
+	qboolean quit;
+	qboolean failed;                ///< a write failed, the remaining chunks are skipped
+} aviWriter_t;
+
+static aviWriter_t aviWriter;
+
+/**
+ * @brief CL_AVIWriteError
+ */
+static void _attribute((noreturn)) CL_AVIWriteError(void)
+{
+	if (videoPipe)
+	{
+		Com_Error(ERR_DROP, "Failed to write avi file.\n\nMake sure the path to ffmpeg binary is part of $PATH environmental variable, or is placed next to the ETL executable.\n");
+	}
+	else
+	{
+		Com_Error(ERR_DROP, "Failed to write avi file\n");
+	}
+}
+
 /**
  * @brief SafeFS_Write
  * @param[in] buffer
@@ -99,14 +183,21 @@ static ID_INLINE void SafeFS_Write(const void *buffer, int len, fileHandle_t f)
 {
 	if (FS_Write(buffer, len, f) < len)
 	{
-		if (videoPipe)
-		{
-			Com_Error(ERR_DROP, "Failed to write avi file.\n\nMake sure the path to ffmpeg binary is part of $PATH environmental variable, or is placed next to the ETL executable.\n");
-		}
-		else
-		{
-			Com_Error(ERR_DROP, "Failed to write avi file\n");
-		}
+		CL_AVIWriteError();
+	}
+}
+
+/**
+ * @brief SafeFS_Write for the writer thread, failures are reported by the producers
+ * @param[in] buffer
+ * @param[in] len
+ * @param[in] f - aviWriter.file or aviWriter.indexFile, FS_Write may print
+ */
+static ID_INLINE void CL_AVIWrite(const void *buffer, int len, FILE *f)
+{
+	if (!aviWriter.failed && len > 0 && fwrite(buffer, 1, len, f) != (size_t)len)
+	{
+		aviWriter.failed = qtrue;
 	}
 }
 
@@ -400,6 +491,391 @@ static qboolean CL_ValidatePipeFormat(const char *s)
 	return qtrue;
 }
 
+/**
+ * @brief Writes a video chunk and its index entry, writer thread only
+ * @param[in] data
+ * @param[in] size - 0 repeats the previous frame
+ */
+static void CL_AVIWriteVideoChunk(const byte *data, int size)
+{
+	int  chunkOffset = afd.fileSize - afd.moviOffset - 8;
+	int  chunkSize   = 8 + size;
+	int  paddingSize = PAD(size, 2) - size;
+	byte padding[4]  = { 0 };
+
+	bufIndex = 0;
+	WRITE_STRING("00dc");
+	WRITE_4BYTES(size);
+
+	CL_AVIWrite(buffer, 8, aviWriter.file);
+	CL_AVIWrite(data, size, aviWriter.file);
+	CL_AVIWrite(padding, paddingSize, aviWriter.file);
+
+	Sys_LockMutex(aviWriter.mutex);
+
+	afd.numVideoFrames++;
+
+	if (size > afd.maxRecordSize)
+	{
+		afd.maxRecordSize = size;
+	}
+
+	if (!afd.pipe)
+	{
+		afd.fileSize += (chunkSize + paddingSize);
+		afd.moviSize += (chunkSize + paddingSize);
+		afd.numIndices++;
+	}
+
+	Sys_UnlockMutex(aviWriter.mutex);
+
+	if (afd.pipe)
+	{
+		return;
+	}
+
+	// Index
+	bufIndex = 0;
+	WRITE_STRING("00dc");       //dwIdentifier
+	WRITE_4BYTES(0x00000010);   //dwFlags (all frames are KeyFrames)
+	WRITE_4BYTES(chunkOffset);  //dwOffset
+	WRITE_4BYTES(size);         //dwLength
+	CL_AVIWrite(buffer, 16, aviWriter.indexFile);
+}
+
+/**
+ * @brief Writes an audio chunk and its index entry, writer thread only
+ * @param[in] data
+ * @param[in] size
+ */
+static void CL_AVIWriteAudioChunk(const byte *data, int size)
+{
+	int  chunkOffset = afd.fileSize - afd.moviOffset - 8;
+	int  chunkSize   = 8 + size;
+	int  paddingSize = PAD(size, 2) - size;
+	byte padding[4]  = { 0 };
+
+	bufIndex = 0;
+	WRITE_STRING("01wb");
+	WRITE_4BYTES(size);
+
+	CL_AVIWrite(buffer, 8, aviWriter.file);
+	CL_AVIWrite(data, size, aviWriter.file);
+	CL_AVIWrite(padding, paddingSize, aviWriter.file);
+
+	Sys_LockMutex(aviWriter.mutex);
+
+	afd.numAudioFrames++;
+
+	if (!afd.pipe)
+	{
+		afd.fileSize     += (chunkSize + paddingSize);
+		afd.moviSize     += (chunkSize + paddingSize);
+		afd.a.totalBytes += size;
+		afd.numIndices++;
+	}
+
+	Sys_UnlockMutex(aviWriter.mutex);
+
+	if (afd.pipe)
+	{
+		return;
+	}
+
+	// Index
+	bufIndex = 0;
+	WRITE_STRING("01wb");       //dwIdentifier
+	WRITE_4BYTES(0);            //dwFlags
+	WRITE_4BYTES(chunkOffset);  //dwOffset
+	WRITE_4BYTES(size);         //dwLength
+	CL_AVIWrite(buffer, 16, aviWriter.indexFile);
+}
+
+/**
+ * @brief Encodes a frame queued by CL_WriteAVIVideoPixels into aviWriter.encodeBuffer
+ * @param[in] chunk
+ * @return Size of the encoded frame
+ */
+static int CL_AVIEncodeFrame(const aviChunk_t *chunk)
+{
+	int  linelen, avipadwidth, avipadlen;
+	byte *srcptr, *destptr, *lineend, *memend;
+
+	if (afd.motionJpeg)
+	{
+		return (int)re.SaveJPGToBuffer(aviWriter.encodeBuffer, afd.frameSize, afd.jpegQuality,
+		                               afd.width, afd.height, chunk->data, chunk->padding);
+	}
+
+	linelen     = afd.width * 3;
+	avipadwidth = PAD(linelen, AVI_LINE_PADDING);
+	avipadlen   = avipadwidth - linelen;
+
+	srcptr  = chunk->data;
+	destptr = aviWriter.encodeBuffer;
+	memend  = srcptr + chunk->size;
+
+	// swap R and B and remove line paddings
+	while (srcptr < memend)
+	{
+		lineend = srcptr + linelen;
+		while (srcptr < lineend)
+		{
+			*destptr++ = srcptr[2];
+			*destptr++ = srcptr[1];
+			*destptr++ = srcptr[0];
+			srcptr    += 3;
+		}
+
+		Com_Memset(destptr, '\0', avipadlen);
+		destptr += avipadlen;
+
+		srcptr += chunk->padding;
+	}
+
+	return avipadwidth * afd.height;
+}
+
+/**
+ * @brief Encodes and writes the queued chunks in order
+ * @param arg - unused
+ */
+static void CL_AVIWriterThread(void *arg)
+{
+	aviChunk_t *chunk;
+
+	while (1)
+	{
+		Sys_SemaphoreWait(aviWriter.queued);
+
+		if (aviWriter.quit)
+		{
+			return;
+		}
+
+		chunk = &aviWriter.chunks[aviWriter.tail++ % AVI_QUEUE_CHUNKS];
+
+		switch (chunk->type)
+		{
+		case AVI_CHUNK_PIXELS:
+			CL_AVIWriteVideoChunk(aviWriter.encodeBuffer, CL_AVIEncodeFrame(chunk));
+			break;
+		case AVI_CHUNK_VIDEO:
+			CL_AVIWriteVideoChunk(chunk->data, chunk->size);
+			break;
+		case AVI_CHUNK_AUDIO:
+			CL_AVIWriteAudioChunk(chunk->data, chunk->size);
+			break;
+		}
+
+		if (chunk->type != AVI_CHUNK_AUDIO && chunk->data)
+		{
+			Sys_LockMutex(aviWriter.mutex);
+			aviWriter.framesQueued--;
+			Sys_UnlockMutex(aviWriter.mutex);
+		}
+
+		Sys_SemaphorePost(aviWriter.free);
+	}
+}
+
+/**
+ * @brief Waits until the writer thread has written everything queued so far
+ */
+static void CL_FlushAVIWriter(void)
+{
+	int i;
+
+	for (i = 0; i < AVI_QUEUE_CHUNKS; i++)
+	{
+		Sys_SemaphoreWait(aviWriter.free);
+	}
+	for (i = 0; i < AVI_QUEUE_CHUNKS; i++)
+	{
+		Sys_SemaphorePost(aviWriter.free);
+	}
+}
+
+/**
+ * @brief Allocates the queue and starts the writer thread
+ * @return qfalse if any of it failed
+ */
+static qboolean CL_StartAVIWriter(void)
+{
+	int i;
+
+	Com_Memset(&aviWriter, 0, sizeof(aviWriter));
+
+	// big enough for an encoded frame as well as glReadPixels rows with padding
+	afd.frameSize = afd.width * afd.height * 4;
+
+	for (i = 0; i < AVI_QUEUE_FRAMES; i++)
+	{
+		if (!(aviWriter.frames[i] = Com_Allocate(afd.frameSize)))
+		{
+			return qfalse;
+		}
+	}
+
+	if (!(aviWriter.encodeBuffer = Com_Allocate(afd.frameSize)))
+	{
+		return qfalse;
+	}
+
+	if (afd.audio && !(aviWriter.audio = Com_Allocate(AVI_QUEUE_CHUNKS * PCM_BUFFER_SIZE)))
+	{
+		return qfalse;
+	}
+
+	aviWriter.mutex  = Sys_CreateMutex();
+	aviWriter.queued = Sys_CreateSemaphore(0);
+	aviWriter.free   = Sys_CreateSemaphore(AVI_QUEUE_CHUNKS);
+
+	if (!aviWriter.mutex || !aviWriter.queued || !aviWriter.free)
+	{
+		return qfalse;
+	}
+
+	aviWriter.file      = FS_FileForHandle(afd.f);
+	aviWriter.indexFile = afd.idxF ? FS_FileForHandle(afd.idxF) : NULL;
+
+	aviWriter.thread = Sys_CreateThread(CL_AVIWriterThread, NULL);
+
+	return aviWriter.thread != NULL;
+}
+
+/**
+ * @brief Writes out the queue and stops the writer thread
+ */
+static void CL_StopAVIWriter(void)
+{
+	int i;
+
+	if (aviWriter.thread)
+	{
+		CL_FlushAVIWriter();
+
+		aviWriter.quit = qtrue;
+		Sys_SemaphorePost(aviWriter.queued);
+		Sys_JoinThread(aviWriter.thread);
+	}
+
+	if (aviWriter.mutex)
+	{
+		Sys_DestroyMutex(aviWriter.mutex);
+	}
+	if (aviWriter.queued)
+	{
+		Sys_DestroySemaphore(aviWriter.queued);
+	}
+	if (aviWriter.free)
+	{
+		Sys_DestroySemaphore(aviWriter.free);
+	}
+
+	for (i = 0; i < AVI_QUEUE_FRAMES; i++)
+	{
+		if (aviWriter.frames[i])
+		{
+			Com_Dealloc(aviWriter.frames[i]);
+		}
+	}
+	if (aviWriter.encodeBuffer)
+	{
+		Com_Dealloc(aviWriter.encodeBuffer);
+	}
+	if (aviWriter.audio)
+	{
+		Com_Dealloc(aviWriter.audio);
+	}
+
+	Com_Memset(&aviWriter, 0, sizeof(aviWriter));
+}
+
+/**
+ * @brief Raises the error of a failed write on the producer side
+ */
+static void CL_CheckAVIWriter(void)
+{
+	if (aviWriter.failed)
+	{
+		CL_CloseAVI();
+		CL_AVIWriteError();
+	}
+}
+
+/**
+ * @brief Waits for a free chunk in the queue
+ * @param[in] type
+ * @return
+ */
+static aviChunk_t *CL_AllocAVIChunk(aviChunkType_t type)
+{
+	aviChunk_t *chunk;
+
+	Sys_SemaphoreWait(aviWriter.free);
+
+	chunk          = &aviWriter.chunks[aviWriter.head % AVI_QUEUE_CHUNKS];
+	chunk->type    = type;
+	chunk->data    = NULL;
+	chunk->size    = 0;
+	chunk->padding = 0;
+
+	return chunk;
+}
+
+/**
+ * @brief Hands the chunk returned by CL_AllocAVIChunk to the writer thread
+ */
+static void CL_QueueAVIChunk(void)
+{
+	aviWriter.head++;
+	Sys_SemaphorePost(aviWriter.queued);
+}
+
+/**
+ * @brief Queues a video frame, or an empty one if the writer thread is too far behind
+ * @param[in] type
+ * @param[in] data
+ * @param[in] size
+ * @param[in] padding
+ */
+static void CL_QueueAVIVideoFrame(aviChunkType_t type, const byte *data, int size, int padding)
+{
+	aviChunk_t *chunk;
+	qboolean   drop;
+
+	if (size > afd.frameSize)
+	{
+		Com_Error(ERR_DROP, "CL_QueueAVIVideoFrame: frame too large (%i bytes)", size);
+	}
+
+	Sys_LockMutex(aviWriter.mutex);
+	drop = aviWriter.framesQueued == AVI_QUEUE_FRAMES;
+	if (!drop)
+	{
+		aviWriter.framesQueued++;
+	}
+	Sys_UnlockMutex(aviWriter.mutex);
+
+	if (drop)
+	{
+		// an empty chunk repeats the previous frame, which keeps the audio in sync
+		CL_AllocAVIChunk(AVI_CHUNK_VIDEO);
+		afd.numDroppedFrames++;
+	}
+	else
+	{
+		chunk          = CL_AllocAVIChunk(type);
+		chunk->data    = aviWriter.frames[aviWriter.nextFrame++ % AVI_QUEUE_FRAMES];
+		chunk->size    = size;
+		chunk->padding = padding;
+		Com_Memcpy(chunk->data, data, size);
+	}
+
+	CL_QueueAVIChunk();
+}
+
 /**
  * @brief Creates an AVI file and gets it into a state where
  * writing the actual data can begin
@@ -469,6 +945,8 @@ qboolean CL_OpenAVIForWriting(const char *fileName, qboolean pipe)
 	afd.cBuffer = Z_Malloc(afd.width * afd.height * 4);
 	afd.eBuffer = Z_Malloc(afd.width * afd.height * 4);
 
+	afd.jpegQuality = Cvar_VariableIntegerValue("r_screenshotJpegQuality");
+
 	afd.a.rate       = dma.speed;
 	afd.a.format     = WAV_FORMAT_PCM;
 	afd.a.channels   = dma.channels;
@@ -532,6 +1010,13 @@ qboolean CL_OpenAVIForWriting(const char *fileName, qboolean pipe)
 
 	afd.fileOpen = qtrue;
 
+	if (!CL_StartAVIWriter())
+	{
+		Com_Printf(S_COLOR_RED "Failed to start the avi writer thread\n");
+		CL_CloseAVI();
+		return qfalse;
+	}
+
 	return qtrue;
 }
 
@@ -549,13 +1034,33 @@ static qboolean CL_CheckFileSize(int bytesToAdd)
 		return qfalse;
 	}
 
+	// the writer thread may still add a full queue on top of the current size
+	Sys_LockMutex(aviWriter.mutex);
+	newFileSize = afd.fileSize + bytesToAdd + ((afd.numIndices + AVI_QUEUE_CHUNKS) * 16) + 4
+	              + AVI_QUEUE_FRAMES * (afd.frameSize + 10) + AVI_QUEUE_CHUNKS * (PCM_BUFFER_SIZE + 10);
+	Sys_UnlockMutex(aviWriter.mutex);
+
+	if (newFileSize > INT_MAX)
+	{
+		// close to the limit, find out exactly
+		CL_FlushAVIWriter();
+	}
+
 	// current file size + what we want to add + the index + the index size
+	Sys_LockMutex(aviWriter.mutex);
 	newFileSize = afd.fileSize + bytesToAdd + (afd.numIndices * 16) + 4;
+	Sys_UnlockMutex(aviWriter.mutex);
 
 	// I assume all the operating systems
 	// we target can handle a 2Gb file
 	if (newFileSize > INT_MAX)
 	{
+		// the file is being closed already, the frame is left out
+		if (afd.closing)
+		{
+			return qtrue;
+		}
+
 		// Close the current file...
 		CL_CloseAVI();
 
@@ -575,58 +1080,48 @@ static qboolean CL_CheckFileSize(int bytesToAdd)
  */
 void CL_WriteAVIVideoFrame(const byte *imageBuffer, int size)
 {
-	int  chunkOffset = afd.fileSize - afd.moviOffset - 8;
-	int  chunkSize   = 8 + size;
-	int  paddingSize = PAD(size, 2) - size;
-	byte padding[4]  = { 0 };
-
 	if (!afd.fileOpen)
 	{
 		return;
 	}
 
+	CL_CheckAVIWriter();
+
 	// Chunk header + contents + padding
 	if (CL_CheckFileSize(8 + size + 2))
 	{
 		return;
 	}
 
-	bufIndex = 0;
-	WRITE_STRING("00dc");
-	WRITE_4BYTES(size);
-
-	SafeFS_Write(buffer, 8, afd.f);
-	SafeFS_Write(imageBuffer, size, afd.f);
-	SafeFS_Write(padding, paddingSize, afd.f);
+	CL_QueueAVIVideoFrame(AVI_CHUNK_VIDEO, imageBuffer, size, 0);
+}
 
-	afd.numVideoFrames++;
+/**
+ * @brief Queues a frame for the writer thread to encode, the renderer calls it
+ *        from RE_EndFrame on the main thread
+ * @param[in] pixels - afd.height bottom-up RGB rows as returned by glReadPixels
+ * @param[in] padding - bytes at the end of each row
+ */
+void CL_WriteAVIVideoPixels(const byte *pixels, int padding)
+{
+	int size = (afd.width * 3 + padding) * afd.height;
 
-	if (size > afd.maxRecordSize)
+	if (!afd.fileOpen)
 	{
-		afd.maxRecordSize = size;
+		return;
 	}
 
-	if (afd.pipe)
+	CL_CheckAVIWriter();
+
+	// Chunk header + contents + padding, encoding never makes it bigger
+	if (CL_CheckFileSize(8 + afd.frameSize + 2))
 	{
 		return;
 	}
 
-	afd.fileSize += (chunkSize + paddingSize);
-	afd.moviSize += (chunkSize + paddingSize);
-
-	// Index
-	bufIndex = 0;
-	WRITE_STRING("00dc");       //dwIdentifier
-	WRITE_4BYTES(0x00000010);   //dwFlags (all frames are KeyFrames)
-	WRITE_4BYTES(chunkOffset);  //dwOffset
-	WRITE_4BYTES(size);         //dwLength
-	SafeFS_Write(buffer, 16, afd.idxF);
-
-	afd.numIndices++;
+	CL_QueueAVIVideoFrame(AVI_CHUNK_PIXELS, pixels, size, padding);
 }
 
-#define PCM_BUFFER_SIZE 44100
-
 /**
  * @brief CL_WriteAVIAudioFrame
  * @param[in] pcmBuffer
@@ -647,6 +1142,8 @@ void CL_WriteAVIAudioFrame(const byte *pcmBuffer, int size)
 		return;
 	}
 
+	CL_CheckAVIWriter();
+
 	// Chunk header + contents + padding
 	if (CL_CheckFileSize(8 + bytesInBuffer + size + 2))
 	{
@@ -665,36 +1162,13 @@ void CL_WriteAVIAudioFrame(const byte *pcmBuffer, int size)
 	// Only write if we have a frame's worth of audio
 	if (bytesInBuffer >= (int)(ceil((double)afd.a.rate / (double)afd.frameRate) * afd.a.sampleSize))
 	{
-		int  chunkOffset = afd.fileSize - afd.moviOffset - 8;
-		int  chunkSize   = 8 + bytesInBuffer;
-		int  paddingSize = PAD(bytesInBuffer, 2) - bytesInBuffer;
-		byte padding[4]  = { 0 };
+		aviChunk_t *chunk = CL_AllocAVIChunk(AVI_CHUNK_AUDIO);
 
-		bufIndex = 0;
-		WRITE_STRING("01wb");
-		WRITE_4BYTES(bytesInBuffer);
+		chunk->data = aviWriter.audio + (aviWriter.head % AVI_QUEUE_CHUNKS) * PCM_BUFFER_SIZE;
+		chunk->size = bytesInBuffer;
+		Com_Memcpy(chunk->data, pcmCaptureBuffer, bytesInBuffer);
 
-		SafeFS_Write(buffer, 8, afd.f);
-		SafeFS_Write(pcmCaptureBuffer, bytesInBuffer, afd.f);
-		SafeFS_Write(padding, paddingSize, afd.f);
-		afd.numAudioFrames++;
-
-		if (!afd.pipe)
-		{
-			afd.fileSize     += (chunkSize + paddingSize);
-			afd.moviSize     += (chunkSize + paddingSize);
-			afd.a.totalBytes += bytesInBuffer;
-
-			// Index
-			bufIndex = 0;
-			WRITE_STRING("01wb");   //dwIdentifier
-			WRITE_4BYTES(0);        //dwFlags
-			WRITE_4BYTES(chunkOffset);  //dwOffset
-			WRITE_4BYTES(bytesInBuffer);    //dwLength
-			SafeFS_Write(buffer, 16, afd.idxF);
-
-			afd.numIndices++;
-		}
+		CL_QueueAVIChunk();
 
 		bytesInBuffer = 0;
 	}
@@ -721,8 +1195,9 @@ void CL_TakeVideoFrame(void)
 qboolean CL_CloseAVI(void)
 {
 	int        indexRemainder;
-	int        indexSize    = afd.numIndices * 16;
+	int        indexSize;
 	const char *idxFileName = va("%s" INDEX_FILE_EXTENSION, afd.fileName);
+	qboolean   failed;
 
 	// AVI file isn't open
 	if (!afd.fileOpen)
@@ -730,9 +1205,46 @@ qboolean CL_CloseAVI(void)
 		return qfalse;
 	}
 
+	// the renderer still holds the last frames read back, queue them before the writer stops
+	if (!aviWriter.failed && !afd.closing && re.FinishVideoFrames)
+	{
+		afd.closing = qtrue;
+		re.FinishVideoFrames();
+		afd.closing = qfalse;
+
+		if (!afd.fileOpen)
+		{
+			return qfalse;
+		}
+	}
+
+	failed = aviWriter.failed;
+	CL_StopAVIWriter();
+
+	indexSize = afd.numIndices * 16;
+
 	Z_Free(afd.cBuffer);
 	Z_Free(afd.eBuffer);
 
+	if (afd.numDroppedFrames)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: %d video frames dropped, the writer thread couldn't keep up\n", afd.numDroppedFrames);
+	}
+
+	if (failed)
+	{
+		// nothing sensible left to finish, CL_CheckAVIWriter reports the error
+		FS_FCloseFile(afd.f);
+		if (afd.idxF)
+		{
+			FS_FCloseFile(afd.idxF);
+		}
+		afd.f        = 0;
+		afd.fileOpen = qfalse;
+		afd.pipe     = qfalse;
+		return qfalse;
+	}
+
 	if (afd.pipe)
 	{
 		Com_Printf("Wrote %d:%d (v:a) frames to pipe: %s\n", afd.numVideoFrames, afd.numAudioFrames, afd.fileName);
@@ -797,6 +1309,26 @@ qboolean CL_CloseAVI(void)
 	return qtrue;
 }
 
+/**
+ * @brief Prints the progress of the current recording
+ */
+void CL_AVIStatus(void)
+{
+	int frames, queued;
+
+	if (!afd.fileOpen)
+	{
+		return;
+	}
+
+	Sys_LockMutex(aviWriter.mutex);
+	frames = afd.numVideoFrames;
+	queued = aviWriter.framesQueued;
+	Sys_UnlockMutex(aviWriter.mutex);
+
+	Com_Printf("Recording %s: %d video frames written, %d queued, %d dropped\n", afd.fileName, frames, queued, afd.numDroppedFrames);
+}
+
 /**
  * @brief CL_VideoRecording
  * @return
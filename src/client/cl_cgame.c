@@ -46,6 +46,7 @@ static ext_trap_keys_t cg_extensionTraps[] =
 	{ "trap_CommandComplete_Legacy", CG_COMMAND_COMPLETE, qfalse },
 	{ "trap_CmdBackup_Ext_Legacy",   CG_CMDBACKUP_EXT,    qfalse },
 	{ "trap_MatchPaused_Legacy",     CG_MATCHPAUSED,      qfalse },
+	{ "trap_CvarChanges_Legacy",     CG_CVAR_CHANGES,     qfalse },
 	{ NULL,                          -1,                  qfalse }
 };
 
@@ -1129,6 +1130,9 @@ intptr_t CL_CgameSystemCalls(intptr_t *args)
 		S_PauseSounds(args[1]);
 		return 0;
 
+	case CG_CVAR_CHANGES:
+		return Cvar_Changes(VMA(1), VMA(2), args[3]);
+
 	default:
 		Com_Error(ERR_DROP, "Bad cgame system trap: %ld", (long int) args[0]);
 		break;
@@ -2472,6 +2472,13 @@ void CL_Video_f(void)
 		return;
 	}
 
+	// already running, report how the writer is keeping up
+	if (CL_VideoRecording())
+	{
+		CL_AVIStatus();
+		return;
+	}
+
 	if (cl_avidemo->integer != 0)
 	{
 		Com_Printf("The %s command cannot be used unless cl_avidemo is 0\n", Cmd_Argv(0));
@@ -3159,7 +3166,9 @@ void CL_InitRef(void)
 	ri.FS_FreeFileList = FS_FreeFileList;
 	ri.FS_ListFiles    = FS_ListFiles;
 	ri.FS_FileIsInPAK  = FS_FileIsInPAK;
+	ri.FS_FileOrigin   = FS_FileOrigin;
 	ri.FS_FileExists   = FS_FileExists;
+	ri.FS_Delete       = FS_Delete;
 
 	ri.FS_FOpenFileRead = FS_FOpenFileRead;
 	ri.FS_Read          = FS_Read;
@@ -3176,8 +3185,9 @@ void CL_InitRef(void)
 	ri.CIN_PlayCinematic   = CIN_PlayCinematic;
 	ri.CIN_RunCinematic    = CIN_RunCinematic;
 
-	ri.CL_VideoRecording     = CL_VideoRecording;
-	ri.CL_WriteAVIVideoFrame = CL_WriteAVIVideoFrame;
+	ri.CL_VideoRecording      = CL_VideoRecording;
+	ri.CL_WriteAVIVideoFrame  = CL_WriteAVIVideoFrame;
+	ri.CL_WriteAVIVideoPixels = CL_WriteAVIVideoPixels;
 
 #ifdef FEATURE_PNG
 	ri.zlib_crc32    = crc32;
@@ -3188,6 +3198,18 @@ void CL_InitRef(void)
 	ri.Sys_GLimpInit     = Sys_GLimpInit;
 	ri.Sys_SetEnv        = Sys_SetEnv;
 
+	ri.Sys_CreateThread     = Sys_CreateThread;
+	ri.Sys_JoinThread       = Sys_JoinThread;
+	ri.Sys_CreateMutex      = Sys_CreateMutex;
+	ri.Sys_DestroyMutex     = Sys_DestroyMutex;
+	ri.Sys_LockMutex        = Sys_LockMutex;
+	ri.Sys_UnlockMutex      = Sys_UnlockMutex;
+	ri.Sys_CreateSemaphore  = Sys_CreateSemaphore;
+	ri.Sys_DestroySemaphore = Sys_DestroySemaphore;
+	ri.Sys_SemaphorePost    = Sys_SemaphorePost;
+	ri.Sys_SemaphoreWait    = Sys_SemaphoreWait;
+	ri.Sys_NumCPUs          = Sys_NumCPUs;
+
 	ri.Cvar_VariableIntegerValue = Cvar_VariableIntegerValue;
 
 	ri.IN_Init     = IN_Init;
@@ -3198,6 +3220,9 @@ void CL_InitRef(void)
 	ri.GLimp_Init        = GLimp_Init;
 	ri.GLimp_Shutdown    = GLimp_Shutdown;
 	ri.GLimp_SwapFrame   = GLimp_EndFrame;
+	ri.GLimp_MakeCurrent  = GLimp_MakeCurrent;
+	ri.GLimp_SwapWindow   = GLimp_SwapWindow;
+	ri.GLimp_UpdateWindow = GLimp_UpdateWindow;
 	ri.GLimp_SetGamma    = GLimp_SetGamma;
 	ri.GLimp_SplashImage = GLimp_SplashImage;
 
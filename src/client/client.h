@@ -577,6 +577,8 @@ void CL_SetConsoleScale(float factor);
 qboolean CL_OpenAVIForWriting(const char *fileName, qboolean pipe);
 void CL_TakeVideoFrame(void);
 void CL_WriteAVIVideoFrame(const byte *imageBuffer, int size);
+void CL_WriteAVIVideoPixels(const byte *pixels, int padding);
+void CL_AVIStatus(void);
 void CL_WriteAVIAudioFrame(const byte *pcmBuffer, int size);
 qboolean CL_CloseAVI(void);
 qboolean CL_VideoRecording(void);
@@ -90,6 +90,7 @@ cvar_t *s_testsound;
 cvar_t *s_show;
 cvar_t *s_mixahead;
 cvar_t *s_mixOffset;
+cvar_t *s_mixSIMD;
 cvar_t *s_debugStreams;
 
 static loopSound_t loopSounds[MAX_LOOP_SOUNDS];
@@ -2354,6 +2355,7 @@ void S_Base_Shutdown(void)
 	numSfx         = 0;
 
 	Cmd_RemoveCommand("s_info");
+	Cmd_RemoveCommand("s_mixBench");
 }
 
 /**
@@ -2373,6 +2375,7 @@ qboolean S_Base_Init(soundInterface_t *si)
 
 	s_mixahead     = Cvar_Get("s_mixahead", "0.2", CVAR_ARCHIVE_ND);
 	s_mixOffset    = Cvar_Get("s_mixOffset", "0.0", CVAR_ARCHIVE_ND);
+	s_mixSIMD      = Cvar_Get("s_mixSIMD", "1", CVAR_ARCHIVE_ND);
 	s_show         = Cvar_Get("s_show", "0", CVAR_CHEAT);
 	s_testsound    = Cvar_Get("s_testsound", "0", CVAR_CHEAT);
 	s_debugStreams = Cvar_Get("s_debugStreams", "0", CVAR_TEMP);
@@ -2391,6 +2394,8 @@ qboolean S_Base_Init(soundInterface_t *si)
 		s_paintedtime = 0;
 
 		S_Base_StopAllSounds();
+
+		Cmd_AddCommand("s_mixBench", S_MixBench_f, "Compares the SIMD sound mixer against the scalar one.");
 	}
 	else
 	{
@@ -300,6 +300,7 @@ extern cvar_t *s_debugPause;
 
 extern cvar_t *s_testsound;
 extern cvar_t *s_debugStreams;
+extern cvar_t *s_mixSIMD;
 
 extern float s_volCurrent;
 
@@ -311,6 +312,7 @@ void SND_setup(void);
 void SND_shutdown(void);
 
 void S_PaintChannels(int endtime);
+void S_MixBench_f(void);
 
 void S_memoryLoad(sfx_t *sfx);
 
@@ -38,6 +38,12 @@
 #if idppc_altivec && !defined(__APPLE__)
 #include <altivec.h>
 #endif
+#ifdef ETL_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MIX_NEON 1
+#endif
 
 static portable_samplepair_t paintbuffer[PAINTBUFFER_SIZE];
 static int                   snd_vol;
@@ -46,46 +52,332 @@ int   *snd_p;
 int   snd_linear_count;
 short *snd_out;
 
-// #if !id386                                        // if configured not to use asm
+/*
+===============================================================================
+MIXING KERNELS
+
+The inner loops of the channel painters and of the paint buffer transfer.
+All variants give the same output as the scalar ones, s_mixSIMD selects
+between them at runtime and s_mixBench compares them.
+===============================================================================
+*/
+
+#define MIX_DECODE_BLOCK 256   ///< mu-law samples decoded per kernel call
 
 /**
- * @brief S_WriteLinearBlastStereo16
+ * @struct mixFuncs_t
+ * @brief
  */
-void S_WriteLinearBlastStereo16(void)
+typedef struct
+{
+	const char *name;
+	void (*mixMono16)(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol);
+	void (*mixStereo16)(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol);
+	void (*clipStereo16)(short *out, const int *in, int count);
+} mixFuncs_t;
+
+/**
+ * @brief Adds count mono samples to the paint buffer
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixMono16_scalar(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	int i, data;
+
+	for (i = 0 ; i < count ; i++)
+	{
+		data           = samples[i];
+		samp[i].left  += (data * leftvol) >> 8;
+		samp[i].right += (data * rightvol) >> 8;
+	}
+}
+
+/**
+ * @brief Adds count interleaved stereo samples to the paint buffer
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixStereo16_scalar(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	int i;
+
+	for (i = 0 ; i < count ; i++)
+	{
+		samp[i].left  += (samples[i * 2] * leftvol) >> 8;
+		samp[i].right += (samples[i * 2 + 1] * rightvol) >> 8;
+	}
+}
+
+/**
+ * @brief Scales count paint buffer values down to 16 bit and clamps them
+ * @param[out] out
+ * @param[in] in
+ * @param[in] count
+ */
+static void S_ClipStereo16_scalar(short *out, const int *in, int count)
 {
 	int i;
 	int val;
 
-	for (i = 0 ; i < snd_linear_count ; i += 2)
+	for (i = 0 ; i < count ; i++)
 	{
-		val = snd_p[i] >> 8;
+		val = in[i] >> 8;
 		if (val > 0x7fff)
 		{
-			snd_out[i] = 0x7fff;
+			out[i] = 0x7fff;
 		}
 		else if (val < -32768)
 		{
-			snd_out[i] = -32768;
+			out[i] = -32768;
 		}
 		else
 		{
-			snd_out[i] = val;
+			out[i] = val;
 		}
+	}
+}
 
-		val = snd_p[i + 1] >> 8;
-		if (val > 0x7fff)
-		{
-			snd_out[i + 1] = 0x7fff;
-		}
-		else if (val < -32768)
-		{
-			snd_out[i + 1] = -32768;
-		}
-		else
-		{
-			snd_out[i + 1] = val;
-		}
+static const mixFuncs_t mixScalar =
+{
+	"scalar",
+	S_MixMono16_scalar,
+	S_MixStereo16_scalar,
+	S_ClipStereo16_scalar
+};
+
+#ifdef ETL_SSE
+/**
+ * @brief Low 32 bits of a * b for each lane, SSE2 has no pmulld
+ * @param[in] a
+ * @param[in] b
+ * @return
+ */
+static ID_INLINE __m128i S_MulLo32_SSE(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * @brief S_MixMono16_SSE
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixMono16_SSE(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	const __m128i left  = _mm_set1_epi32(leftvol);
+	const __m128i right = _mm_set1_epi32(rightvol);
+	__m128i       *out  = (__m128i *)samp;
+	__m128i       s, s0, s1, l, r;
+	int           i;
+
+	for (i = 0 ; i + 8 <= count ; i += 8, out += 4)
+	{
+		s  = _mm_loadu_si128((const __m128i *)&samples[i]);
+		s0 = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		s1 = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+
+		l = _mm_srai_epi32(S_MulLo32_SSE(s0, left), 8);
+		r = _mm_srai_epi32(S_MulLo32_SSE(s0, right), 8);
+		_mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), _mm_unpacklo_epi32(l, r)));
+		_mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), _mm_unpackhi_epi32(l, r)));
+
+		l = _mm_srai_epi32(S_MulLo32_SSE(s1, left), 8);
+		r = _mm_srai_epi32(S_MulLo32_SSE(s1, right), 8);
+		_mm_storeu_si128(out + 2, _mm_add_epi32(_mm_loadu_si128(out + 2), _mm_unpacklo_epi32(l, r)));
+		_mm_storeu_si128(out + 3, _mm_add_epi32(_mm_loadu_si128(out + 3), _mm_unpackhi_epi32(l, r)));
+	}
+
+	S_MixMono16_scalar(samp + i, samples + i, count - i, leftvol, rightvol);
+}
+
+/**
+ * @brief S_MixStereo16_SSE
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixStereo16_SSE(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	const __m128i vol = _mm_setr_epi32(leftvol, rightvol, leftvol, rightvol);
+	__m128i       *out = (__m128i *)samp;
+	__m128i       s, s0, s1;
+	int           i;
+
+	for (i = 0 ; i + 4 <= count ; i += 4, out += 2)
+	{
+		s  = _mm_loadu_si128((const __m128i *)&samples[i * 2]);
+		s0 = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		s1 = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+
+		s0 = _mm_srai_epi32(S_MulLo32_SSE(s0, vol), 8);
+		s1 = _mm_srai_epi32(S_MulLo32_SSE(s1, vol), 8);
+		_mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), s0));
+		_mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), s1));
+	}
+
+	S_MixStereo16_scalar(samp + i, samples + i * 2, count - i, leftvol, rightvol);
+}
+
+/**
+ * @brief S_ClipStereo16_SSE
+ * @param[out] out
+ * @param[in] in
+ * @param[in] count
+ *
+ * @note packssdw saturates exactly like the scalar clamp
+ */
+static void S_ClipStereo16_SSE(short *out, const int *in, int count)
+{
+	__m128i a, b;
+	int     i;
+
+	for (i = 0 ; i + 8 <= count ; i += 8)
+	{
+		a = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&in[i]), 8);
+		b = _mm_srai_epi32(_mm_loadu_si128((const __m128i *)&in[i + 4]), 8);
+		_mm_storeu_si128((__m128i *)&out[i], _mm_packs_epi32(a, b));
+	}
+
+	S_ClipStereo16_scalar(out + i, in + i, count - i);
+}
+
+static const mixFuncs_t mixSIMD =
+{
+	"sse2",
+	S_MixMono16_SSE,
+	S_MixStereo16_SSE,
+	S_ClipStereo16_SSE
+};
+#elif defined(MIX_NEON)
+/**
+ * @brief S_MixMono16_NEON
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixMono16_NEON(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	int32_t     *out = (int32_t *)samp;
+	int32x4_t   s;
+	int32x4x2_t d;
+	int         i;
+
+	for (i = 0 ; i + 4 <= count ; i += 4, out += 8)
+	{
+		s = vmovl_s16(vld1_s16(&samples[i]));
+		d = vld2q_s32(out);
+
+		d.val[0] = vaddq_s32(d.val[0], vshrq_n_s32(vmulq_n_s32(s, leftvol), 8));
+		d.val[1] = vaddq_s32(d.val[1], vshrq_n_s32(vmulq_n_s32(s, rightvol), 8));
+		vst2q_s32(out, d);
+	}
+
+	S_MixMono16_scalar(samp + i, samples + i, count - i, leftvol, rightvol);
+}
+
+/**
+ * @brief S_MixStereo16_NEON
+ * @param[in,out] samp
+ * @param[in] samples
+ * @param[in] count
+ * @param[in] leftvol
+ * @param[in] rightvol
+ */
+static void S_MixStereo16_NEON(portable_samplepair_t *samp, const short *samples, int count, int leftvol, int rightvol)
+{
+	const int32_t vols[4] = { leftvol, rightvol, leftvol, rightvol };
+	int32x4_t     vol     = vld1q_s32(vols);
+	int32_t       *out    = (int32_t *)samp;
+	int16x8_t     s;
+	int32x4_t     s0, s1;
+	int           i;
+
+	for (i = 0 ; i + 4 <= count ; i += 4, out += 8)
+	{
+		s  = vld1q_s16(&samples[i * 2]);
+		s0 = vshrq_n_s32(vmulq_s32(vmovl_s16(vget_low_s16(s)), vol), 8);
+		s1 = vshrq_n_s32(vmulq_s32(vmovl_s16(vget_high_s16(s)), vol), 8);
+
+		vst1q_s32(out, vaddq_s32(vld1q_s32(out), s0));
+		vst1q_s32(out + 4, vaddq_s32(vld1q_s32(out + 4), s1));
+	}
+
+	S_MixStereo16_scalar(samp + i, samples + i * 2, count - i, leftvol, rightvol);
+}
+
+/**
+ * @brief S_ClipStereo16_NEON
+ * @param[out] out
+ * @param[in] in
+ * @param[in] count
+ */
+static void S_ClipStereo16_NEON(short *out, const int *in, int count)
+{
+	int16x4_t a, b;
+	int       i;
+
+	for (i = 0 ; i + 8 <= count ; i += 8)
+	{
+		a = vqmovn_s32(vshrq_n_s32(vld1q_s32(&in[i]), 8));
+		b = vqmovn_s32(vshrq_n_s32(vld1q_s32(&in[i + 4]), 8));
+		vst1q_s16(&out[i], vcombine_s16(a, b));
+	}
+
+	S_ClipStereo16_scalar(out + i, in + i, count - i);
+}
+
+static const mixFuncs_t mixSIMD =
+{
+	"neon",
+	S_MixMono16_NEON,
+	S_MixStereo16_NEON,
+	S_ClipStereo16_NEON
+};
+#endif
+
+static const mixFuncs_t *mix = &mixScalar;
+
+/**
+ * @brief S_SelectMixFuncs
+ * @param[in] simd
+ * @return Kernels to mix with, the scalar ones if there are no SIMD kernels in this build
+ */
+static const mixFuncs_t *S_SelectMixFuncs(qboolean simd)
+{
+#if defined(ETL_SSE) || defined(MIX_NEON)
+	if (simd)
+	{
+		return &mixSIMD;
 	}
+#endif
+	return &mixScalar;
+}
+
+// #if !id386                                        // if configured not to use asm
+
+/**
+ * @brief S_WriteLinearBlastStereo16
+ */
+void S_WriteLinearBlastStereo16(void)
+{
+	mix->clipStereo16(snd_out, snd_p, snd_linear_count);
 }
 // #elif defined( __GNUC__ )
 // // uses snd_mixa.s
@@ -479,16 +771,18 @@ static void S_PaintChannelFrom16_altivec(channel_t *ch, const sfx_t *sc, int cou
 #endif
 
 /**
- * @brief S_PaintChannelFrom16_scalar
+ * @brief S_PaintChannelFrom16_generic
  * @param[in] ch
  * @param[in] sc
  * @param[in] count
  * @param[in] sampleOffset
  * @param[in] bufferOffset
+ *
+ * @note The doppler path is scalar only
  */
-static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset)
+static void S_PaintChannelFrom16_generic(channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
-	int                   data, aoff, boff;
+	int                   n, aoff, boff;
 	int                   leftvol, rightvol;
 	int                   i, j;
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
@@ -531,15 +825,24 @@ static void S_PaintChannelFrom16_scalar(channel_t *ch, const sfx_t *sc, int coun
 		leftvol  = ch->leftvol * snd_vol;
 		rightvol = ch->rightvol * snd_vol;
 		samples  = chunk->sndChunk;
-		for (i = 0 ; i < count ; i++)
+		for (i = 0 ; i < count ; i += n)
 		{
-			data          = samples[sampleOffset++];
-			samp[i].left += (data * leftvol) >> 8;
-			if (sc->soundChannels == 2 && sampleOffset < SND_CHUNK_SIZE)
+			// mix up to the end of the current chunk in one go
+			n = (SND_CHUNK_SIZE - sampleOffset) / sc->soundChannels;
+			if (n > count - i)
 			{
-				data = samples[sampleOffset++];
+				n = count - i;
 			}
-			samp[i].right += (data * rightvol) >> 8;
+
+			if (sc->soundChannels == 2)
+			{
+				mix->mixStereo16(&samp[i], &samples[sampleOffset], n, leftvol, rightvol);
+			}
+			else
+			{
+				mix->mixMono16(&samp[i], &samples[sampleOffset], n, leftvol, rightvol);
+			}
+			sampleOffset += n * sc->soundChannels;
 
 			if (sampleOffset == SND_CHUNK_SIZE)
 			{
@@ -611,7 +914,7 @@ static void S_PaintChannelFrom16(channel_t *ch, const sfx_t *sc, int count, int
 		return;
 	}
 #endif
-	S_PaintChannelFrom16_scalar(ch, sc, count, sampleOffset, bufferOffset);
+	S_PaintChannelFrom16_generic(ch, sc, count, sampleOffset, bufferOffset);
 }
 
 /**
@@ -626,7 +929,7 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
 {
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
-	int                   data;
+	int                   n;
 	int                   i      = 0;
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
 	sndBuffer             *chunk = sc->soundData;
@@ -648,11 +951,16 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
 
 	samples = sfxScratchBuffer;
 
-	for (i = 0 ; i < count ; i++)
+	for (i = 0 ; i < count ; i += n)
 	{
-		data           = samples[sampleOffset++];
-		samp[i].left  += (data * leftvol) >> 8;
-		samp[i].right += (data * rightvol) >> 8;
+		n = SND_CHUNK_SIZE * 2 - sampleOffset;
+		if (n > count - i)
+		{
+			n = count - i;
+		}
+
+		mix->mixMono16(&samp[i], &samples[sampleOffset], n, leftvol, rightvol);
+		sampleOffset += n;
 
 		if (sampleOffset == SND_CHUNK_SIZE * 2)
 		{
@@ -674,7 +982,7 @@ void S_PaintChannelFromWavelet(channel_t *ch, sfx_t *sc, int count, int sampleOf
  */
 void S_PaintChannelFromADPCM(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
 {
-	int                   data;
+	int                   n;
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
 	int                   i        = 0;
@@ -703,11 +1011,16 @@ void S_PaintChannelFromADPCM(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 
 	samples = sfxScratchBuffer;
 
-	for (i = 0 ; i < count ; i++)
+	for (i = 0 ; i < count ; i += n)
 	{
-		data           = samples[sampleOffset++];
-		samp[i].left  += (data * leftvol) >> 8;
-		samp[i].right += (data * rightvol) >> 8;
+		n = SND_CHUNK_SIZE * 4 - sampleOffset;
+		if (n > count - i)
+		{
+			n = count - i;
+		}
+
+		mix->mixMono16(&samp[i], &samples[sampleOffset], n, leftvol, rightvol);
+		sampleOffset += n;
 
 		if (sampleOffset == SND_CHUNK_SIZE * 4)
 		{
@@ -733,10 +1046,11 @@ void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 	int                   data;
 	int                   leftvol  = ch->leftvol * snd_vol;
 	int                   rightvol = ch->rightvol * snd_vol;
-	int                   i;
+	int                   i, j, n;
 	portable_samplepair_t *samp  = &paintbuffer[bufferOffset];
 	sndBuffer             *chunk = sc->soundData;
 	byte                  *samples;
+	short                 decoded[MIX_DECODE_BLOCK];
 
 	while (sampleOffset >= (SND_CHUNK_SIZE * 2))
 	{
@@ -751,12 +1065,26 @@ void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 	if (!ch->doppler)
 	{
 		samples = (byte *)chunk->sndChunk + sampleOffset;
-		for (i = 0 ; i < count ; i++)
+		for (i = 0 ; i < count ; i += n)
 		{
-			data           = mulawToShort[*samples];
-			samp[i].left  += (data * leftvol) >> 8;
-			samp[i].right += (data * rightvol) >> 8;
-			samples++;
+			// decode a block through the table and mix it like 16 bit data
+			n = (byte *)chunk->sndChunk + (SND_CHUNK_SIZE * 2) - samples;
+			if (n > count - i)
+			{
+				n = count - i;
+			}
+			if (n > MIX_DECODE_BLOCK)
+			{
+				n = MIX_DECODE_BLOCK;
+			}
+
+			for (j = 0 ; j < n ; j++)
+			{
+				decoded[j] = mulawToShort[samples[j]];
+			}
+			mix->mixMono16(&samp[i], decoded, n, leftvol, rightvol);
+			samples += n;
+
 			if (samples == (byte *)chunk->sndChunk + (SND_CHUNK_SIZE * 2))
 			{
 				chunk   = chunk->next;
@@ -788,6 +1116,34 @@ void S_PaintChannelFromMuLaw(channel_t *ch, sfx_t *sc, int count, int sampleOffs
 	}
 }
 
+/**
+ * @brief Paints a channel with the painter for its sound format
+ * @param[in] ch
+ * @param[in] sc
+ * @param[in] count
+ * @param[in] sampleOffset
+ * @param[in] bufferOffset
+ */
+static void S_PaintChannel(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
+{
+	if (sc->soundCompressionMethod == 1)
+	{
+		S_PaintChannelFromADPCM(ch, sc, count, sampleOffset, bufferOffset);
+	}
+	else if (sc->soundCompressionMethod == 2)
+	{
+		S_PaintChannelFromWavelet(ch, sc, count, sampleOffset, bufferOffset);
+	}
+	else if (sc->soundCompressionMethod == 3)
+	{
+		S_PaintChannelFromMuLaw(ch, sc, count, sampleOffset, bufferOffset);
+	}
+	else
+	{
+		S_PaintChannelFrom16(ch, sc, count, sampleOffset, bufferOffset);
+	}
+}
+
 /**
  * @brief S_PaintChannels
  * @param[in] endtime
@@ -811,6 +1167,8 @@ void S_PaintChannels(int endtime)
 		snd_vol = s_volume->value * s_volCurrent * 255;
 	}
 
+	mix = S_SelectMixFuncs(s_mixSIMD->integer);
+
 	//Com_Printf ("%i to %i\n", s_paintedtime, endtime);
 	while (s_paintedtime < endtime)
 	{
@@ -868,22 +1226,7 @@ void S_PaintChannels(int endtime)
 
 			if (count > 0)
 			{
-				if (sc->soundCompressionMethod == 1)
-				{
-					S_PaintChannelFromADPCM(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-				}
-				else if (sc->soundCompressionMethod == 2)
-				{
-					S_PaintChannelFromWavelet(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-				}
-				else if (sc->soundCompressionMethod == 3)
-				{
-					S_PaintChannelFromMuLaw(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-				}
-				else
-				{
-					S_PaintChannelFrom16(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-				}
+				S_PaintChannel(ch, sc, count, sampleOffset, ltime - s_paintedtime);
 			}
 		}
 
@@ -918,22 +1261,7 @@ void S_PaintChannels(int endtime)
 
 				if (count > 0)
 				{
-					if (sc->soundCompressionMethod == 1)
-					{
-						S_PaintChannelFromADPCM(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-					}
-					else if (sc->soundCompressionMethod == 2)
-					{
-						S_PaintChannelFromWavelet(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-					}
-					else if (sc->soundCompressionMethod == 3)
-					{
-						S_PaintChannelFromMuLaw(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-					}
-					else
-					{
-						S_PaintChannelFrom16(ch, sc, count, sampleOffset, ltime - s_paintedtime);
-					}
+					S_PaintChannel(ch, sc, count, sampleOffset, ltime - s_paintedtime);
 					ltime += count;
 				}
 			}
@@ -945,3 +1273,279 @@ void S_PaintChannels(int endtime)
 		s_paintedtime = end;
 	}
 }
+
+/*
+===============================================================================
+MIXING BENCHMARK
+===============================================================================
+*/
+
+#define MIX_BENCH_SOUNDS    5
+#define MIX_BENCH_CHANNELS  32
+#define MIX_BENCH_PASSES    4
+
+/**
+ * @brief Deterministic noise for the benchmark scene
+ * @param[in,out] seed
+ * @return 0 .. 0x7fff
+ */
+static int S_MixBenchRand(unsigned int *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return (*seed >> 16) & 0x7fff;
+}
+
+/**
+ * @brief Builds a synthetic sound in one of the in memory formats
+ * @param[out] sfx
+ * @param[in] method - soundCompressionMethod
+ * @param[in] channels
+ * @param[in,out] seed
+ * @return qfalse if out of memory
+ *
+ * @note The compressed formats get random chunk data, the painters decode
+ * whatever they are given so this is enough to exercise them. The length
+ * is never a multiple of the chunk size as the decoders expect a next chunk
+ * at a chunk end.
+ */
+static qboolean S_MixBenchSound(sfx_t *sfx, int method, int channels, unsigned int *seed)
+{
+	sndBuffer *chunks;
+	int       perChunk, numChunks, i, j;
+
+	switch (method)
+	{
+	case 1:
+		perChunk = SND_CHUNK_SIZE * 4;
+		break;
+	case 2:
+	case 3:
+		perChunk = SND_CHUNK_SIZE * 2;
+		break;
+	default:
+		perChunk = SND_CHUNK_SIZE / channels;
+		break;
+	}
+
+	numChunks = 16 + S_MixBenchRand(seed) % 16;
+	chunks    = Com_Allocate(numChunks * sizeof(sndBuffer));
+	if (!chunks)
+	{
+		return qfalse;
+	}
+
+	for (i = 0; i < numChunks; i++)
+	{
+		chunks[i].next         = (i + 1 < numChunks) ? &chunks[i + 1] : NULL;
+		chunks[i].size         = SND_CHUNK_SIZE * 2;
+		chunks[i].adpcm.index  = S_MixBenchRand(seed) % 89;
+		chunks[i].adpcm.sample = 0;
+
+		for (j = 0; j < SND_CHUNK_SIZE; j++)
+		{
+			chunks[i].sndChunk[j] = S_MixBenchRand(seed) - 0x4000;
+		}
+	}
+
+	Com_Memset(sfx, 0, sizeof(*sfx));
+	Q_strncpyz(sfx->soundName, "*mixbench", sizeof(sfx->soundName));
+	sfx->soundData              = chunks;
+	sfx->inMemory               = qtrue;
+	sfx->soundCompressionMethod = method;
+	sfx->soundChannels          = channels;
+	sfx->soundLength            = numChunks * perChunk - 1 - S_MixBenchRand(seed) % (perChunk - 1);
+
+	return qtrue;
+}
+
+/**
+ * @brief Renders the benchmark scene with the given kernels
+ * @param[in] funcs
+ * @param[in] sfx
+ * @param[out] out - length stereo 16 bit samples
+ * @param[in] length
+ * @return Milliseconds for MIX_BENCH_PASSES renders
+ */
+static int S_MixBenchRender(const mixFuncs_t *funcs, sfx_t *sfx, short *out, int length)
+{
+	channel_t    channels[MIX_BENCH_CHANNELS];
+	channel_t    *ch;
+	unsigned int seed;
+	int          pass, i, t, end, ltime, count, sampleOffset;
+	int          start;
+
+	mix   = funcs;
+	start = Sys_Milliseconds();
+
+	for (pass = 0; pass < MIX_BENCH_PASSES; pass++)
+	{
+		// the script, every channel loops one of the sounds at its own volume
+		seed = 0x5eed;
+		Com_Memset(channels, 0, sizeof(channels));
+		for (i = 0, ch = channels; i < MIX_BENCH_CHANNELS; i++, ch++)
+		{
+			ch->thesfx      = &sfx[i % MIX_BENCH_SOUNDS];
+			ch->leftvol     = S_MixBenchRand(&seed) & 255;
+			ch->rightvol    = S_MixBenchRand(&seed) & 255;
+			ch->startSample = -(S_MixBenchRand(&seed) % ch->thesfx->soundLength);
+		}
+		sfxScratchPointer = NULL;
+
+		for (t = 0; t < length; t = end)
+		{
+			end = t + PAINTBUFFER_SIZE;
+			if (end > length)
+			{
+				end = length;
+			}
+
+			Com_Memset(paintbuffer, 0, (end - t) * sizeof(portable_samplepair_t));
+
+			for (i = 0, ch = channels; i < MIX_BENCH_CHANNELS; i++, ch++)
+			{
+				ltime = t;
+				do
+				{
+					sampleOffset = (ltime - ch->startSample) % ch->thesfx->soundLength;
+					count        = end - ltime;
+					if (sampleOffset + count > ch->thesfx->soundLength)
+					{
+						count = ch->thesfx->soundLength - sampleOffset;
+					}
+
+					S_PaintChannel(ch, ch->thesfx, count, sampleOffset, ltime - t);
+					ltime += count;
+				}
+				while (ltime < end);
+
+				// pan every fourth channel around
+				if (!(i & 3))
+				{
+					ch->leftvol  = (ch->leftvol + 7) & 255;
+					ch->rightvol = 255 - ch->leftvol;
+				}
+			}
+
+			funcs->clipStereo16(out + t * 2, (int *)paintbuffer, (end - t) * 2);
+		}
+	}
+
+	return Sys_Milliseconds() - start;
+}
+
+/**
+ * @brief Renders a scripted scene with the scalar and the SIMD mixer and compares the output
+ *
+ * Usage: s_mixBench [seconds]
+ */
+void S_MixBench_f(void)
+{
+	const mixFuncs_t *simd          = S_SelectMixFuncs(qtrue);
+	const mixFuncs_t *oldMix        = mix;
+	short            *oldScratch    = sfxScratchBuffer;
+	sfx_t            *oldScratchSfx = sfxScratchPointer;
+	int              oldScratchIdx  = sfxScratchIndex;
+	int              oldVol         = snd_vol;
+	int              speed          = dma.speed ? dma.speed : 22050;
+	int              seconds        = 10;
+	int              length, i, diff, first;
+	int              scalarMsec, simdMsec;
+	unsigned int     seed = 0x50bd;
+	short            *scratch, *ref, *out;
+	sfx_t            sfx[MIX_BENCH_SOUNDS];
+
+	if (Cmd_Argc() > 1)
+	{
+		seconds = atoi(Cmd_Argv(1));
+		if (seconds < 1)
+		{
+			seconds = 1;
+		}
+		else if (seconds > 600)
+		{
+			seconds = 600;
+		}
+	}
+	length = seconds * speed;
+
+	Com_Memset(sfx, 0, sizeof(sfx));
+	scratch = Com_Allocate(SND_CHUNK_SIZE * sizeof(short) * 4);
+	ref     = Com_Allocate(length * 2 * sizeof(short));
+	out     = Com_Allocate(length * 2 * sizeof(short));
+
+	if (!scratch || !ref || !out
+	    || !S_MixBenchSound(&sfx[0], 0, 1, &seed)
+	    || !S_MixBenchSound(&sfx[1], 0, 2, &seed)
+	    || !S_MixBenchSound(&sfx[2], 1, 1, &seed)
+	    || !S_MixBenchSound(&sfx[3], 2, 1, &seed)
+	    || !S_MixBenchSound(&sfx[4], 3, 1, &seed))
+	{
+		Com_Printf("s_mixBench: out of memory\n");
+		goto done;
+	}
+
+	Com_Printf("Mixing %i seconds of %i channels at %i Hz, %i passes\n", seconds, MIX_BENCH_CHANNELS, speed, MIX_BENCH_PASSES);
+
+	sfxScratchBuffer = scratch;
+	snd_vol          = 204;
+
+	scalarMsec = S_MixBenchRender(&mixScalar, sfx, ref, length);
+	Com_Printf("%8s: %5i msec\n", mixScalar.name, scalarMsec);
+
+	if (simd == &mixScalar)
+	{
+		Com_Printf("No SIMD mixer in this build\n");
+		goto done;
+	}
+
+	simdMsec = S_MixBenchRender(simd, sfx, out, length);
+	Com_Printf("%8s: %5i msec (%.2fx)\n", simd->name, simdMsec, simdMsec ? (double)scalarMsec / simdMsec : 0.0);
+
+	for (i = 0, diff = 0, first = -1; i < length * 2; i++)
+	{
+		if (ref[i] != out[i])
+		{
+			if (first < 0)
+			{
+				first = i;
+			}
+			diff++;
+		}
+	}
+
+	if (diff)
+	{
+		Com_Printf(S_COLOR_RED "%s output differs from scalar in %i of %i samples, first at sample %i\n", simd->name, diff, length * 2, first);
+	}
+	else
+	{
+		Com_Printf("%s output matches scalar\n", simd->name);
+	}
+
+done:
+	for (i = 0; i < MIX_BENCH_SOUNDS; i++)
+	{
+		if (sfx[i].soundData)
+		{
+			Com_Dealloc(sfx[i].soundData);
+		}
+	}
+	if (scratch)
+	{
+		Com_Dealloc(scratch);
+	}
+	if (ref)
+	{
+		Com_Dealloc(ref);
+	}
+	if (out)
+	{
+		Com_Dealloc(out);
+	}
+
+	mix               = oldMix;
+	snd_vol           = oldVol;
+	sfxScratchBuffer  = oldScratch;
+	sfxScratchPointer = oldScratchSfx;
+	sfxScratchIndex   = oldScratchIdx;
+}
@@ -282,15 +282,13 @@ void G_RegisterPlayerClasses(void)
 void G_UpdateCharacter(gclient_t *client)
 {
 	char           infostring[MAX_INFO_STRING];
-	char           *s;
 	int            characterIndex;
 	bg_character_t *character;
 
-	trap_GetUserinfo(client->ps.clientNum, infostring, sizeof(infostring));
-	s = Info_ValueForKey(infostring, "ch");
-	if (*s)
+	trap_GetUserinfoValue(client->ps.clientNum, "ch", infostring, sizeof(infostring));
+	if (infostring[0])
 	{
-		characterIndex = Q_atoi(s);
+		characterIndex = Q_atoi(infostring);
 		if (characterIndex < 0 || characterIndex >= MAX_CHARACTERS)
 		{
 			goto set_default_character;
@@ -451,10 +451,10 @@ qboolean G_SendScore_Add(gentity_t *ent, int i, char *buf, int bufsize)
 }
 
 /**
- * @brief Sends current scoreboard information
- * @param[in] ent
+ * @brief Builds the sc0 and sc1 commands, they are the same for all clients
+ * and are kept in frame memory until the ranks or the frame change
  */
-void G_SendScore(gentity_t *ent)
+static void G_BuildScoreCommands(void)
 {
 	int i         = 0;
 	int numSorted = level.numConnectedClients; // send the latest information on all clients
@@ -465,23 +465,12 @@ void G_SendScore(gentity_t *ent)
 	char buffer[987];
 	char startbuffer[32];
 
+	level.numScoreCommands   = 0;
+	level.scoreCommandsValid = qtrue;
+
 	*buffer      = '\0';
 	*startbuffer = '\0';
 
-#ifdef FEATURE_RATING
-	if (g_skillRating.integer)
-	{
-		G_SendSkillRating(ent);
-	}
-#endif
-
-#ifdef FEATURE_PRESTIGE
-	if (g_prestige.integer)
-	{
-		G_SendPrestige(ent);
-	}
-#endif
-
 	Q_strncpyz(startbuffer, va(
 				   "sc0 %i %i",
 				   level.teamScores[TEAM_AXIS],
@@ -500,13 +489,13 @@ void G_SendScore(gentity_t *ent)
 		{
 			break;
 		}
-		if (!G_SendScore_Add(ent, i, buffer, sizeof(buffer)))
+		if (!G_SendScore_Add(NULL, i, buffer, sizeof(buffer)))
 		{
 			break;
 		}
 		count++;
 	}
-	trap_SendServerCommand(ent - g_entities, va("%s %i%s", startbuffer, count, buffer));
+	level.scoreCommands[level.numScoreCommands++] = G_FrameString(va("%s %i%s", startbuffer, count, buffer));
 
 	if (i == numSorted)
 	{
@@ -519,7 +508,7 @@ void G_SendScore(gentity_t *ent)
 	Q_strncpyz(startbuffer, "sc1", sizeof(startbuffer));
 	for (; i < numSorted; ++i)
 	{
-		if (!G_SendScore_Add(ent, i, buffer, sizeof(buffer)))
+		if (!G_SendScore_Add(NULL, i, buffer, sizeof(buffer)))
 		{
 			G_Printf("ERROR: G_SendScore() buffer overflow\n");
 			break;
@@ -531,7 +520,40 @@ void G_SendScore(gentity_t *ent)
 		return;
 	}
 
-	trap_SendServerCommand(ent - g_entities, va("%s %i%s", startbuffer, count, buffer));
+	level.scoreCommands[level.numScoreCommands++] = G_FrameString(va("%s %i%s", startbuffer, count, buffer));
+}
+
+/**
+ * @brief Sends current scoreboard information
+ * @param[in] ent
+ */
+void G_SendScore(gentity_t *ent)
+{
+	int i;
+
+#ifdef FEATURE_RATING
+	if (g_skillRating.integer)
+	{
+		G_SendSkillRating(ent);
+	}
+#endif
+
+#ifdef FEATURE_PRESTIGE
+	if (g_prestige.integer)
+	{
+		G_SendPrestige(ent);
+	}
+#endif
+
+	if (!level.scoreCommandsValid)
+	{
+		G_BuildScoreCommands();
+	}
+
+	for (i = 0; i < level.numScoreCommands; i++)
+	{
+		trap_SendServerCommand(ent - g_entities, level.scoreCommands[i]);
+	}
 }
 
 /**
@@ -516,7 +516,7 @@ void G_players_cmd(gentity_t *ent, unsigned int dwCommand, int fDump)
 	gclient_t *cl;
 	gentity_t *cl_ent;
 	char      guid[MAX_GUID_LENGTH + 1], n2[MAX_NETNAME], rate[32], version[64];
-	char      *s, *tc, *ready, *ref, *spec, *ign, *muted, *special, userinfo[MAX_INFO_STRING], *user_version;
+	char      *tc, *ready, *ref, *spec, *ign, *muted, *special, value[MAX_INFO_VALUE];
 
 	if (g_gamestate.integer == GS_PLAYING)
 	{
@@ -585,11 +585,10 @@ void G_players_cmd(gentity_t *ent, unsigned int dwCommand, int fDump)
 		}
 		else
 		{
-			trap_GetUserinfo(idnum, userinfo, sizeof(userinfo));
-			s          = Info_ValueForKey(userinfo, "rate");
-			user_rate  = (max_rate > 0 && Q_atoi(s) > max_rate) ? max_rate : Q_atoi(s);
-			s          = Info_ValueForKey(userinfo, "snaps");
-			user_snaps = Q_atoi(s);
+			trap_GetUserinfoValue(idnum, "rate", value, sizeof(value));
+			user_rate = (max_rate > 0 && Q_atoi(value) > max_rate) ? max_rate : Q_atoi(value);
+			trap_GetUserinfoValue(idnum, "snaps", value, sizeof(value));
+			user_snaps = Q_atoi(value);
 
 			Q_strncpyz(rate, va("%5d%6d%9d%7d", cl->pers.clientTimeNudge, user_rate, cl->pers.clientMaxPackets, user_snaps), sizeof(rate));
 		}
@@ -601,17 +600,13 @@ void G_players_cmd(gentity_t *ent, unsigned int dwCommand, int fDump)
 		}
 		else
 		{
-			trap_GetUserinfo(idnum, userinfo, sizeof(userinfo));
-
-			user_version = Info_ValueForKey(userinfo, "etVersion");
+			trap_GetUserinfoValue(idnum, "etVersion", version, sizeof(version));
 
 			// no engine version found, check cgame version as a fallback
-			if (user_version[0] == 0)
+			if (version[0] == 0)
 			{
-				user_version = Info_ValueForKey(userinfo, "cg_etVersion");
+				trap_GetUserinfoValue(idnum, "cg_etVersion", version, sizeof(version));
 			}
-
-			Q_strncpyz(version, user_version, sizeof(version));
 		}
 
 		if (g_gamestate.integer != GS_PLAYING)
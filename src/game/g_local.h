@@ -1221,6 +1221,10 @@ typedef struct level_locals_s
 	int numPlayingClients;                      ///< connected, non-spectators
 	int sortedClients[MAX_CLIENTS];             ///< sorted by score
 
+	char *scoreCommands[2];                     ///< sc0 and sc1 for all clients, in frame memory
+	int numScoreCommands;
+	qboolean scoreCommandsValid;                ///< cleared each frame and by CalculateRanks
+
 	int warmupModificationCount;                ///< for detecting if g_warmup is changed
 
 	// voting
@@ -1796,8 +1800,15 @@ void QDECL G_Error(const char *fmt, ...) _attribute((noreturn, format(printf, 1,
 // extension interface
 qboolean trap_GetValue(char *value, int valueSize, const char *key);
 void trap_DemoSupport(const char *commands);
+qboolean trap_GetTrapTable(gameTrapTable_t *table, int version, int size);
+int trap_CvarChanges(int *sequence, int *handles, int maxHandles);
+void trap_GetUserinfoValue(int num, const char *key, char *buffer, int bufferSize);
 extern int dll_com_trapGetValue;
 extern int dll_trap_DemoSupport;
+extern int dll_trap_GetTrapTable;
+extern int dll_trap_CvarChanges;
+extern int dll_trap_GetUserinfoValue;
+extern gameTrapTable_t *dll_trapTable;
 
 // g_demo_legacy.c
 void G_DemoStateChanged(demoState_t demoState, int demoClientsNum);
@@ -1835,6 +1846,9 @@ qboolean OnSameTeam(gentity_t *ent1, gentity_t *ent2);
 
 // g_mem.c
 void *G_Alloc(unsigned int size);
+void *G_FrameAlloc(unsigned int size);
+char *G_FrameString(const char *string);
+void G_ResetFrameMemory(void);
 void G_InitMemory(void);
 void Svcmd_GameMem_f(void);
 
@@ -1177,32 +1177,80 @@ static const gentity_field_t gentity_fields[] =
 	{ NULL },
 };
 
-// gentity fields helper functions
-static gentity_field_t *_et_gentity_getfield(gentity_t *ent, char *fieldname)
+// gentity fields hash tables (open addressing, slot holds field index + 1)
+#define GENTITY_FIELD_HASH_SIZE 512
+
+static short    gclient_fieldHash[GENTITY_FIELD_HASH_SIZE];
+static short    gentity_fieldHash[GENTITY_FIELD_HASH_SIZE];
+static qboolean gentity_fieldHashBuilt = qfalse;
+
+static void _et_gentity_hashfields(const gentity_field_t *fields, short *table)
 {
-	int i;
+	int  i;
+	long hash;
 
-	// search through client fields first
-	if (ent->client)
+	Com_Memset(table, 0, sizeof(short) * GENTITY_FIELD_HASH_SIZE);
+
+	for (i = 0; fields[i].name; i++)
 	{
-		for (i = 0; gclient_fields[i].name; i++)
+		hash = Q_GenerateHashValue(fields[i].name, GENTITY_FIELD_HASH_SIZE, qtrue, qtrue);
+
+		while (table[hash])
 		{
-			if (Q_stricmp(fieldname, gclient_fields[i].name) == 0)
+			// keep the first entry for duplicated names, same as the linear scan did
+			if (Q_stricmp(fields[table[hash] - 1].name, fields[i].name) == 0)
 			{
-				return (gentity_field_t *)&gclient_fields[i];
+				break;
 			}
+			hash = (hash + 1) & (GENTITY_FIELD_HASH_SIZE - 1);
+		}
+
+		if (!table[hash])
+		{
+			table[hash] = (short)(i + 1);
 		}
 	}
+}
 
-	for (i = 0; gentity_fields[i].name; i++)
+static gentity_field_t *_et_gentity_findfield(const gentity_field_t *fields, const short *table, const char *fieldname)
+{
+	long hash = Q_GenerateHashValue(fieldname, GENTITY_FIELD_HASH_SIZE, qtrue, qtrue);
+
+	while (table[hash])
 	{
-		if (Q_stricmp(fieldname, gentity_fields[i].name) == 0)
+		if (Q_stricmp(fieldname, fields[table[hash] - 1].name) == 0)
 		{
-			return (gentity_field_t *)&gentity_fields[i];
+			return (gentity_field_t *)&fields[table[hash] - 1];
 		}
+		hash = (hash + 1) & (GENTITY_FIELD_HASH_SIZE - 1);
 	}
 
-	return 0;
+	return NULL;
+}
+
+// gentity fields helper functions
+static gentity_field_t *_et_gentity_getfield(gentity_t *ent, char *fieldname)
+{
+	gentity_field_t *field;
+
+	if (!gentity_fieldHashBuilt)
+	{
+		_et_gentity_hashfields(gclient_fields, gclient_fieldHash);
+		_et_gentity_hashfields(gentity_fields, gentity_fieldHash);
+		gentity_fieldHashBuilt = qtrue;
+	}
+
+	// search through client fields first
+	if (ent->client)
+	{
+		field = _et_gentity_findfield(gclient_fields, gclient_fieldHash, fieldname);
+		if (field)
+		{
+			return field;
+		}
+	}
+
+	return _et_gentity_findfield(gentity_fields, gentity_fieldHash, fieldname);
 }
 
 static void _et_gentity_getvec3(lua_State *L, vec3_t vec3)
@@ -1619,20 +1667,17 @@ static int _et_G_SetSpawnVar(lua_State *L)
 	return 0;
 }
 
-// variable = et.gentity_get( entnum, fieldname, array_index )
-static int et_gentity_get(lua_State *L)
+/**
+ * @brief Push the value of a gentity field onto the Lua stack
+ * @param[in] L
+ * @param[in] ent
+ * @param[in] field
+ * @param[in] indexArg stack position of the array index, 0 for none
+ * @return number of pushed values
+ */
+static int _et_gentity_pushfield(lua_State *L, gentity_t *ent, gentity_field_t *field, int indexArg)
 {
-	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
-	const char      *fieldname = luaL_checkstring(L, 2);
-	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
-	uintptr_t       addr;
-
-	// break on invalid gentity field
-	if (!field)
-	{
-		luaL_error(L, "tried to get invalid gentity field \"%s\"", fieldname);
-		return 0;
-	}
+	uintptr_t addr;
 
 	if (field->flags & FIELD_FLAG_GENTITY)
 	{
@@ -1689,22 +1734,85 @@ static int et_gentity_get(lua_State *L)
 		_et_gentity_getvec3(L, *(vec3_t *)addr);
 		return 1;
 	case FIELD_INT_ARRAY:
-		lua_pushinteger(L, (*(int *)(addr + (sizeof(int) * (int)luaL_optinteger(L, 3, 0)))));
+		lua_pushinteger(L, (*(int *)(addr + (sizeof(int) * (indexArg ? (int)luaL_optinteger(L, indexArg, 0) : 0)))));
 		return 1;
 	case FIELD_TRAJECTORY:
 		_et_gentity_gettrajectory(L, (trajectory_t *)addr);
 		return 1;
 	case FIELD_FLOAT_ARRAY:
-		lua_pushnumber(L, (*(float *)(addr + (sizeof(int) * (int)luaL_optinteger(L, 3, 0)))));
+		lua_pushnumber(L, (*(float *)(addr + (sizeof(int) * (indexArg ? (int)luaL_optinteger(L, indexArg, 0) : 0)))));
 		return 1;
 	case FIELD_WEAPONSTAT:
-		_et_gentity_getweaponstat(L, (weapon_stat_t *)(addr + (sizeof(weapon_stat_t) * (int)luaL_optinteger(L, 3, 0))));
+		_et_gentity_getweaponstat(L, (weapon_stat_t *)(addr + (sizeof(weapon_stat_t) * (indexArg ? (int)luaL_optinteger(L, indexArg, 0) : 0))));
 		return 1;
 
 	}
 	return 0;
 }
 
+// variable = et.gentity_get( entnum, fieldname, array_index )
+static int et_gentity_get(lua_State *L)
+{
+	gentity_t       *ent       = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname = luaL_checkstring(L, 2);
+	gentity_field_t *field     = _et_gentity_getfield(ent, (char *)fieldname);
+
+	// break on invalid gentity field
+	if (!field)
+	{
+		luaL_error(L, "tried to get invalid gentity field \"%s\"", fieldname);
+		return 0;
+	}
+
+	return _et_gentity_pushfield(L, ent, field, 3);
+}
+
+// values = et.gentity_getmany( entnum, { fieldname, ... }, array_index )
+static int et_gentity_getmany(lua_State *L)
+{
+	gentity_t       *ent = g_entities + (int)luaL_checkinteger(L, 1);
+	const char      *fieldname;
+	gentity_field_t *field;
+	int             i, count;
+
+	luaL_checktype(L, 2, LUA_TTABLE);
+	count = (int)lua_rawlen(L, 2);
+
+	// array_index stays at 3 for _et_gentity_pushfield, nil if it was left out
+	lua_settop(L, 3);
+	lua_createtable(L, 0, count);
+
+	for (i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 2, i);
+		fieldname = lua_tostring(L, -1);
+		if (!fieldname)
+		{
+			luaL_error(L, "gentity_getmany: field list entry %d is not a string", i);
+			return 0;
+		}
+
+		field = _et_gentity_getfield(ent, (char *)fieldname);
+		if (!field)
+		{
+			luaL_error(L, "tried to get invalid gentity field \"%s\"", fieldname);
+			return 0;
+		}
+
+		// the field name stays on the stack as key until the value is stored
+		if (_et_gentity_pushfield(L, ent, field, 3))
+		{
+			lua_settable(L, -3);
+		}
+		else
+		{
+			lua_pop(L, 1);
+		}
+	}
+
+	return 1;
+}
+
 // et.gentity_set( entnum, fieldname, array_index, value )
 static int et_gentity_set(lua_State *L)
 {
@@ -2063,6 +2171,7 @@ static const luaL_Reg etlib[] =
 	{ "G_GetSpawnVar",           _et_G_GetSpawnVar           },
 	{ "G_SetSpawnVar",           _et_G_SetSpawnVar           },
 	{ "gentity_get",             et_gentity_get              },
+	{ "gentity_getmany",         et_gentity_getmany          },
 	{ "gentity_set",             et_gentity_set              },
 	{ "G_AddEvent",              _et_G_AddEvent              },
 	// Shaders
@@ -2335,6 +2444,98 @@ qboolean G_LuaGetNamedFunction(lua_vm_t *vm, const char *name)
 	return qfalse;
 }
 
+static const char *g_luaHookNames[LUA_HOOK_NUM] =
+{
+	"et_InitGame",
+	"et_ShutdownGame",
+	"et_RunFrame",
+	"et_ClientConnect",
+	"et_ClientDisconnect",
+	"et_ClientBegin",
+	"et_ClientUserinfoChanged",
+	"et_ClientSpawn",
+	"et_ClientCommand",
+	"et_ConsoleCommand",
+	"et_UpgradeSkill",
+	"et_SetPlayerSkill",
+	"et_Print",
+	"et_DPrint",
+	"et_Error",
+	"et_Obituary",
+	"et_Damage",
+	"et_WeaponFire",
+	"et_FixedMGFire",
+	"et_MountedMGFire",
+	"et_AAGunFire",
+	"et_SpawnEntitiesFromString",
+	"et_Chat",
+};
+
+/*
+ * G_LuaResolveHooks( vm )
+ * Looks up the callbacks implemented by the script and keeps a registry
+ * reference to each of them, so hooks don't need a global lookup per call.
+ */
+void G_LuaResolveHooks(lua_vm_t *vm)
+{
+	int i;
+
+	for (i = 0; i < LUA_HOOK_NUM; i++)
+	{
+		if (vm->hookMask & (1 << i))
+		{
+			luaL_unref(vm->L, LUA_REGISTRYINDEX, vm->hookRef[i]);
+		}
+		vm->hookRef[i] = LUA_NOREF;
+	}
+	vm->hookMask = 0;
+
+	if (!vm->L)
+	{
+		return;
+	}
+
+	for (i = 0; i < LUA_HOOK_NUM; i++)
+	{
+		if (G_LuaGetNamedFunction(vm, g_luaHookNames[i]))
+		{
+			vm->hookRef[i] = luaL_ref(vm->L, LUA_REGISTRYINDEX);
+			vm->hookMask  |= (1 << i);
+		}
+	}
+}
+
+/*
+ * G_LuaGetHookFunction( vm, hook )
+ * Puts a resolved hook function onto the stack.
+ * If the script does not implement the hook, returns qfalse.
+ */
+qboolean G_LuaGetHookFunction(lua_vm_t *vm, luaHook_t hook)
+{
+	if (!(vm->hookMask & (1 << hook)))
+	{
+		return qfalse;
+	}
+
+	lua_rawgeti(vm->L, LUA_REGISTRYINDEX, vm->hookRef[hook]);
+	return qtrue;
+}
+
+/*
+ * G_LuaCallHook( vm, hook, nargs, nresults )
+ * Calls a hook function already on the stack and accounts for it.
+ */
+qboolean G_LuaCallHook(lua_vm_t *vm, luaHook_t hook, int nargs, int nresults)
+{
+	int      start = trap_Milliseconds();
+	qboolean ret   = G_LuaCall(vm, g_luaHookNames[hook], nargs, nresults);
+
+	vm->hookCalls[hook]++;
+	vm->hookTime[hook] += trap_Milliseconds() - start;
+
+	return ret;
+}
+
 /**
  * @brief Dump the lua stack to console
  *        Executed by the ingame "lua_api" command
@@ -2839,6 +3040,11 @@ qboolean G_LuaStartVM(lua_vm_t *vm)
 	char       gamepath[MAX_OSPATH];
 	const char *luaPath, *luaCPath;
 
+	// no callbacks until the script has been executed
+	vm->hookMask = 0;
+	Com_Memset(vm->hookCalls, 0, sizeof(vm->hookCalls));
+	Com_Memset(vm->hookTime, 0, sizeof(vm->hookTime));
+
 	// Open a new lua state
 	vm->L = luaL_newstate();
 	if (!vm->L)
@@ -2935,6 +3141,9 @@ qboolean G_LuaStartVM(lua_vm_t *vm)
 		return qfalse;
 	}
 
+	// Resolve the callbacks defined by the script
+	G_LuaResolveHooks(vm);
+
 	// Load the code
 	G_Printf("%s API: %sfile '%s' loaded into Lua VM\n", LUA_VERSION, S_COLOR_BLUE, vm->file_name);
 
@@ -3047,6 +3256,27 @@ void G_LuaStatus(gentity_t *ent)
 		}
 	}
 	G_refPrintf(ent, "-- ------------------------ ---------------------------------------- ------------------------");
+
+	G_refPrintf(ent, "%-2s %-28s %-10s %-10s", "VM", "Callback", "Calls", "Msec");
+	G_refPrintf(ent, "-- ---------------------------- ---------- ----------");
+	for (i = 0; i < LUA_NUM_VM; i++)
+	{
+		int j;
+
+		if (!lVM[i])
+		{
+			continue;
+		}
+
+		for (j = 0; j < LUA_HOOK_NUM; j++)
+		{
+			if (lVM[i]->hookMask & (1 << j))
+			{
+				G_refPrintf(ent, "%2d %-28s %10d %10d", lVM[i]->id, g_luaHookNames[j], lVM[i]->hookCalls[j], lVM[i]->hookTime[j]);
+			}
+		}
+	}
+	G_refPrintf(ent, "-- ---------------------------- ---------- ----------");
 }
 
 /*
@@ -3092,7 +3322,7 @@ void G_LuaHook_InitGame(int levelTime, int randomSeed, int restart)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_InitGame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_INITGAME))
 			{
 				continue;
 			}
@@ -3101,11 +3331,13 @@ void G_LuaHook_InitGame(int levelTime, int randomSeed, int restart)
 			lua_pushinteger(vm->L, randomSeed);
 			lua_pushinteger(vm->L, restart);
 			// Call
-			if (!G_LuaCall(vm, "et_InitGame", 3, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_INITGAME, 3, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
 			}
+			// scripts may define further callbacks on init
+			G_LuaResolveHooks(vm);
 		}
 	}
 }
@@ -3128,14 +3360,14 @@ void G_LuaHook_ShutdownGame(int restart)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ShutdownGame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SHUTDOWNGAME))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, restart);
 			// Call
-			if (!G_LuaCall(vm, "et_ShutdownGame", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SHUTDOWNGAME, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3162,14 +3394,14 @@ void G_LuaHook_RunFrame(int levelTime)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_RunFrame"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_RUNFRAME))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, levelTime);
 			// Call
-			if (!G_LuaCall(vm, "et_RunFrame", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_RUNFRAME, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3196,7 +3428,7 @@ qboolean G_LuaHook_ClientConnect(int clientNum, qboolean firstTime, qboolean isB
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientConnect"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTCONNECT))
 			{
 				continue;
 			}
@@ -3205,7 +3437,7 @@ qboolean G_LuaHook_ClientConnect(int clientNum, qboolean firstTime, qboolean isB
 			lua_pushinteger(vm->L, (int)firstTime);
 			lua_pushinteger(vm->L, (int)isBot);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientConnect", 3, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTCONNECT, 3, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3241,14 +3473,14 @@ void G_LuaHook_ClientDisconnect(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientDisconnect"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTDISCONNECT))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientDisconnect", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTDISCONNECT, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3275,14 +3507,14 @@ void G_LuaHook_ClientBegin(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientBegin"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTBEGIN))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientBegin", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTBEGIN, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3309,14 +3541,14 @@ void G_LuaHook_ClientUserinfoChanged(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientUserinfoChanged"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTUSERINFOCHANGED))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientUserinfoChanged", 1, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTUSERINFOCHANGED, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3343,7 +3575,7 @@ void G_LuaHook_ClientSpawn(int clientNum, qboolean revived, qboolean teamChange,
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientSpawn"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTSPAWN))
 			{
 				continue;
 			}
@@ -3353,7 +3585,7 @@ void G_LuaHook_ClientSpawn(int clientNum, qboolean revived, qboolean teamChange,
 			lua_pushinteger(vm->L, (int)teamChange);
 			lua_pushinteger(vm->L, (int)restoreHealth);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientSpawn", 4, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTSPAWN, 4, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3380,7 +3612,7 @@ qboolean G_LuaHook_ClientCommand(int clientNum, char *command)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ClientCommand"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CLIENTCOMMAND))
 			{
 				continue;
 			}
@@ -3388,7 +3620,7 @@ qboolean G_LuaHook_ClientCommand(int clientNum, char *command)
 			lua_pushinteger(vm->L, clientNum);
 			lua_pushstring(vm->L, command);
 			// Call
-			if (!G_LuaCall(vm, "et_ClientCommand", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CLIENTCOMMAND, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3426,14 +3658,14 @@ qboolean G_LuaHook_ConsoleCommand(char *command)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_ConsoleCommand"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CONSOLECOMMAND))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushstring(vm->L, command);
 			// Call
-			if (!G_LuaCall(vm, "et_ConsoleCommand", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CONSOLECOMMAND, 1, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3471,7 +3703,7 @@ qboolean G_LuaHook_UpgradeSkill(int cno, skillType_t skill)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_UpgradeSkill"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_UPGRADESKILL))
 			{
 				continue;
 			}
@@ -3479,7 +3711,7 @@ qboolean G_LuaHook_UpgradeSkill(int cno, skillType_t skill)
 			lua_pushinteger(vm->L, cno);
 			lua_pushinteger(vm->L, (int)skill);
 			// Call
-			if (!G_LuaCall(vm, "et_UpgradeSkill", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_UPGRADESKILL, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3517,7 +3749,7 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_SetPlayerSkill"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SETPLAYERSKILL))
 			{
 				continue;
 			}
@@ -3525,7 +3757,7 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 			lua_pushinteger(vm->L, cno);
 			lua_pushinteger(vm->L, (int)skill);
 			// Call
-			if (!G_LuaCall(vm, "et_SetPlayerSkill", 2, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SETPLAYERSKILL, 2, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3547,9 +3779,9 @@ qboolean G_LuaHook_SetPlayerSkill(int cno, skillType_t skill)
 
 static luaPrintFunctions_t g_luaPrintFunctions[] =
 {
-	{ GPRINT_TEXT,      "et_Print"  },
-	{ GPRINT_DEVELOPER, "et_DPrint" },
-	{ GPRINT_ERROR,     "et_Error"  }
+	{ GPRINT_TEXT,      LUA_HOOK_PRINT  },
+	{ GPRINT_DEVELOPER, LUA_HOOK_DPRINT },
+	{ GPRINT_ERROR,     LUA_HOOK_ERROR  }
 };
 
 /*
@@ -3570,14 +3802,14 @@ void G_LuaHook_Print(printMessageType_t category, char *text)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, g_luaPrintFunctions[category].function))
+			if (!G_LuaGetHookFunction(vm, g_luaPrintFunctions[category].hook))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushstring(vm->L, text);
 			// Call
-			if (!G_LuaCall(vm, g_luaPrintFunctions[category].function, 1, 0))
+			if (!G_LuaCallHook(vm, g_luaPrintFunctions[category].hook, 1, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3609,7 +3841,7 @@ qboolean G_LuaHook_Obituary(int victim, int killer, int meansOfDeath)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_Obituary"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_OBITUARY))
 			{
 				continue;
 			}
@@ -3619,7 +3851,7 @@ qboolean G_LuaHook_Obituary(int victim, int killer, int meansOfDeath)
 			lua_pushinteger(vm->L, meansOfDeath);
 
 			// Call
-			if (!G_LuaCall(vm, "et_Obituary", 3, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_OBITUARY, 3, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3652,7 +3884,7 @@ qboolean G_LuaHook_Damage(int target, int attacker, int damage, int dflags, mean
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_Damage"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_DAMAGE))
 			{
 				continue;
 			}
@@ -3663,7 +3895,7 @@ qboolean G_LuaHook_Damage(int target, int attacker, int damage, int dflags, mean
 			lua_pushinteger(vm->L, dflags);
 			lua_pushinteger(vm->L, mod);
 			// Call
-			if (!G_LuaCall(vm, "et_Damage", 5, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_DAMAGE, 5, 1))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3696,7 +3928,7 @@ qboolean G_LuaHook_WeaponFire(int clientNum, weapon_t weapon, gentity_t **pFired
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_WeaponFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_WEAPONFIRE))
 			{
 				continue;
 			}
@@ -3704,7 +3936,7 @@ qboolean G_LuaHook_WeaponFire(int clientNum, weapon_t weapon, gentity_t **pFired
 			lua_pushinteger(vm->L, clientNum);
 			lua_pushinteger(vm->L, weapon);
 			// Call
-			if (!G_LuaCall(vm, "et_WeaponFire", 2, 2))
+			if (!G_LuaCallHook(vm, LUA_HOOK_WEAPONFIRE, 2, 2))
 			{
 				continue;
 			}
@@ -3744,14 +3976,14 @@ qboolean G_LuaHook_FixedMGFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_FixedMGFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_FIXEDMGFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_FixedMGFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_FIXEDMGFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3783,14 +4015,14 @@ qboolean G_LuaHook_MountedMGFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_MountedMGFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_MOUNTEDMGFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_MountedMGFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_MOUNTEDMGFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3822,14 +4054,14 @@ qboolean G_LuaHook_AAGunFire(int clientNum)
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_AAGunFire"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_AAGUNFIRE))
 			{
 				continue;
 			}
 			// Arguments
 			lua_pushinteger(vm->L, clientNum);
 			// Call
-			if (!G_LuaCall(vm, "et_AAGunFire", 1, 1))
+			if (!G_LuaCallHook(vm, LUA_HOOK_AAGUNFIRE, 1, 1))
 			{
 				continue;
 			}
@@ -3863,13 +4095,13 @@ void G_LuaHook_SpawnEntitiesFromString()
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_SpawnEntitiesFromString"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_SPAWNENTITIESFROMSTRING))
 			{
 				continue;
 			}
 
 			// Call
-			if (!G_LuaCall(vm, "et_SpawnEntitiesFromString", 0, 0))
+			if (!G_LuaCallHook(vm, LUA_HOOK_SPAWNENTITIESFROMSTRING, 0, 0))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -3898,7 +4130,7 @@ const char *G_LuaHook_Chat(int sender, int receiver, const char *message, char *
 			{
 				continue;
 			}
-			if (!G_LuaGetNamedFunction(vm, "et_Chat"))
+			if (!G_LuaGetHookFunction(vm, LUA_HOOK_CHAT))
 			{
 				continue;
 			}
@@ -3907,7 +4139,7 @@ const char *G_LuaHook_Chat(int sender, int receiver, const char *message, char *
 			lua_pushinteger(vm->L, receiver);
 			lua_pushstring(vm->L, newMessage);
 			// Call
-			if (!G_LuaCall(vm, "et_Chat", 3, 2))
+			if (!G_LuaCallHook(vm, LUA_HOOK_CHAT, 3, 2))
 			{
 				//G_LuaStopVM(vm);
 				continue;
@@ -742,6 +742,12 @@ qboolean G_SnapshotCallback(int entityNum, int clientNum)
 
 int dll_com_trapGetValue;
 int dll_trap_DemoSupport;
+int dll_trap_GetTrapTable;
+int dll_trap_CvarChanges;
+int dll_trap_GetUserinfoValue;
+
+static gameTrapTable_t trapTable;
+gameTrapTable_t        *dll_trapTable; ///< set when the hot traps bypass the syscall
 
 /**
  * @brief This is the only way control passes into the module.
@@ -1823,6 +1829,30 @@ void G_ServerCheck(void)
 	}
 }
 
+static int cvarSequence = -1;   ///< position in the engine's cvar modification sequence
+
+/**
+ * @brief G_CvarInList
+ * @param[in] handle
+ * @param[in] handles
+ * @param[in] numHandles
+ * @return
+ */
+static qboolean G_CvarInList(cvarHandle_t handle, const int *handles, int numHandles)
+{
+	int i;
+
+	for (i = 0; i < numHandles; i++)
+	{
+		if (handles[i] == handle)
+		{
+			return qtrue;
+		}
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief G_RegisterCvars
  */
@@ -1832,6 +1862,7 @@ void G_RegisterCvars(void)
 	cvarTable_t *cv;
 
 	level.server_settings = 0;
+	cvarSequence          = -1;
 
 	G_Printf("%d cvars in use\n", gameCvarTableSize);
 
@@ -1890,11 +1921,21 @@ void G_UpdateCvars(void)
 	qboolean    chargetimechanged  = qfalse;
 	qboolean    clsweaprestriction = qfalse;
 	qboolean    skillLevelPoints   = qfalse;
+	int         changed[MAX_CVAR_CHANGES];
+	int         numChanged;
+
+	// -1 when the engine can't tell, then all cvars are polled
+	numChanged = trap_CvarChanges(&cvarSequence, changed, MAX_CVAR_CHANGES);
 
-	for (i = 0, cv = gameCvarTable ; i < gameCvarTableSize ; i++, cv++)
+	for (i = 0, cv = gameCvarTable ; i < gameCvarTableSize && numChanged ; i++, cv++)
 	{
 		if (cv->vmCvar)
 		{
+			if (numChanged > 0 && !G_CvarInList(cv->vmCvar->handle, changed, numChanged))
+			{
+				continue;
+			}
+
 			trap_Cvar_Update(cv->vmCvar);
 
 			if (cv->modificationCount != cv->vmCvar->modificationCount)
@@ -2359,6 +2400,15 @@ static ID_INLINE void G_SetupExtensions(void)
 		dll_com_trapGetValue = Q_atoi(value);
 
 		G_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_DemoSupport, "trap_DemoSupport_Legacy");
+		G_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_GetTrapTable, "trap_GetTrapTable_Legacy");
+		G_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_CvarChanges, "trap_CvarChanges_Legacy");
+		G_SetupExtensionTrap(value, MAX_CVAR_VALUE_STRING, &dll_trap_GetUserinfoValue, "trap_GetUserinfoValue_Legacy");
+	}
+
+	dll_trapTable = NULL;
+	if (trap_GetTrapTable(&trapTable, GAME_TRAP_TABLE_VERSION, sizeof(trapTable)))
+	{
+		dll_trapTable = &trapTable;
 	}
 }
 
@@ -3102,6 +3152,9 @@ void CalculateRanks(void)
 	char      teaminfo[TEAM_NUM_TEAMS][256];
 	gclient_t *cl;
 
+	// the order of the scoreboard changes
+	level.scoreCommandsValid = qfalse;
+
 	level.numConnectedClients       = 0;
 	level.numHumanConnectedClients  = 0;
 	level.numNonSpectatorClients    = 0;
@@ -5495,6 +5548,10 @@ void G_RunFrame(int levelTime)
 		}
 	}
 
+	// everything from the previous frame is gone now
+	G_ResetFrameMemory();
+	level.scoreCommandsValid = qfalse;
+
 	level.framenum++;
 	level.previousTime = level.time;
 	level.time         = levelTime;
@@ -35,12 +35,19 @@
 #include "g_local.h"
 
 #define POOLSIZE    (16 * 1024 * 1024) // up to 32 if required
+#define FRAMEPOOLSIZE   (256 * 1024)
 
 static char memoryPool[POOLSIZE];
 static unsigned int  allocPoint;
+static unsigned int  allocHighWater;    ///< largest allocPoint of all maps
+
+/// transient allocations, reset at the start of each G_RunFrame
+static char framePool[FRAMEPOOLSIZE];
+static unsigned int framePoint;
+static unsigned int frameHighWater;
 
 /**
- * @brief G_Alloc
+ * @brief Allocates memory for the rest of the map, it's released on map change only
  * @param[in] size
  * @return
  */
@@ -63,15 +70,73 @@ void *G_Alloc(unsigned int size)
 
 	allocPoint += (size + 31) & ~31u;
 
+	if (allocPoint > allocHighWater)
+	{
+		allocHighWater = allocPoint;
+	}
+
+	return p;
+}
+
+/**
+ * @brief Allocates memory which is valid until the start of the next server frame
+ * @param[in] size
+ * @return
+ *
+ * @note Don't keep pointers to it in entities or clients
+ */
+void *G_FrameAlloc(unsigned int size)
+{
+	char *p;
+
+	if (framePoint + size > FRAMEPOOLSIZE)
+	{
+		G_Error("G_FrameAlloc: failed on allocation of %u bytes\n", size);
+		return NULL;
+	}
+
+	p = &framePool[framePoint];
+
+	framePoint += (size + 15) & ~15u;
+
+	if (framePoint > frameHighWater)
+	{
+		frameHighWater = framePoint;
+	}
+
 	return p;
 }
 
+/**
+ * @brief Copies a string into frame memory
+ * @param[in] string
+ * @return
+ */
+char *G_FrameString(const char *string)
+{
+	size_t len = strlen(string) + 1;
+	char   *p  = G_FrameAlloc(len);
+
+	Com_Memcpy(p, string, len);
+
+	return p;
+}
+
+/**
+ * @brief Releases all frame memory, called at the start of G_RunFrame
+ */
+void G_ResetFrameMemory(void)
+{
+	framePoint = 0;
+}
+
 /**
  * @brief G_InitMemory
  */
 void G_InitMemory(void)
 {
 	allocPoint = 0;
+	framePoint = 0;
 }
 
 /**
@@ -80,4 +145,6 @@ void G_InitMemory(void)
 void Svcmd_GameMem_f(void)
 {
 	G_Printf("Game memory status: %i out of %i bytes allocated - %i bytes free\n", allocPoint, POOLSIZE, POOLSIZE - allocPoint);
+	G_Printf("Map memory high-water mark: %i bytes\n", allocHighWater);
+	G_Printf("Frame memory: %i out of %i bytes allocated - high-water mark %i bytes\n", framePoint, FRAMEPOOLSIZE, frameHighWater);
 }
@@ -122,8 +122,7 @@ int G_PrestigeDBCheck(char *db_path, int db_mode)
  */
 void G_GetClientPrestige(gclient_t *cl)
 {
-	char      userinfo[MAX_INFO_STRING];
-	char      *guid;
+	char      guid[MAX_INFO_VALUE];
 	int       clientNum, i;
 	prData_t  pr_data;
 	gentity_t *ent;
@@ -156,8 +155,7 @@ void G_GetClientPrestige(gclient_t *cl)
 	}
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	// assign guid
 	pr_data.guid = (const unsigned char *)guid;
@@ -187,8 +185,7 @@ void G_GetClientPrestige(gclient_t *cl)
  */
 void G_SetClientPrestige(gclient_t *cl, qboolean streakUp)
 {
-	char      userinfo[MAX_INFO_STRING];
-	char      *guid;
+	char      guid[MAX_INFO_VALUE];
 	int       clientNum, i, j, skillMax, cnt = 0;
 	prData_t  pr_data;
 	gentity_t *ent;
@@ -228,8 +225,7 @@ void G_SetClientPrestige(gclient_t *cl, qboolean streakUp)
 	}
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	pr_data.guid = (const unsigned char *)guid;
 
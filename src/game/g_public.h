@@ -228,10 +228,41 @@ typedef enum
 	///< engine extensions padding
 	G_TRAP_GETVALUE = COM_TRAP_GETVALUE,
 
-	G_DEMOSUPPORT
+	G_DEMOSUPPORT,
+	G_GETTRAPTABLE,
+	G_CVAR_CHANGES,
+	G_GET_USERINFO_VALUE
 
 } gameImport_t;
 
+#define GAME_TRAP_TABLE_VERSION 1
+
+/**
+ * @struct gameTrapTable_t
+ * @brief Engine functions the game can call directly instead of going through the syscall
+ *
+ * The game asks for it with the trap_GetTrapTable_Legacy extension, servers
+ * without it keep using the syscall for every trap. Bump
+ * GAME_TRAP_TABLE_VERSION whenever the layout changes.
+ */
+typedef struct
+{
+	void (*Trace)(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
+	void (*TraceCapsule)(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask);
+	int (*PointContents)(const vec3_t point, int passEntityNum);
+	void (*LinkEntity)(sharedEntity_t *ent);
+	void (*UnlinkEntity)(sharedEntity_t *ent);
+	int (*EntitiesInBox)(const vec3_t mins, const vec3_t maxs, int *list, int maxcount);
+	qboolean (*EntityContact)(const vec3_t mins, const vec3_t maxs, const sharedEntity_t *ent);
+	qboolean (*EntityContactCapsule)(const vec3_t mins, const vec3_t maxs, const sharedEntity_t *ent);
+	qboolean (*InPVS)(const vec3_t p1, const vec3_t p2);
+	qboolean (*InPVSIgnorePortals)(const vec3_t p1, const vec3_t p2);
+	qboolean (*AreasConnected)(int area1, int area2);
+	void (*GetUsercmd)(int clientNum, usercmd_t *cmd);
+	void (*Cvar_Update)(vmCvar_t *vmCvar);
+	int (*Milliseconds)(void);
+} gameTrapTable_t;
+
 
 /**
   * @enum gameExport_t
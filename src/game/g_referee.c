@@ -670,11 +670,9 @@ void G_PlayerBan()
 
 		if (!(g_entities[bannum].r.svFlags & SVF_BOT))
 		{
-			const char *value;
-			char       userinfo[MAX_INFO_STRING];
+			char value[MAX_INFO_VALUE];
 
-			trap_GetUserinfo(bannum, userinfo, sizeof(userinfo));
-			value = Info_ValueForKey(userinfo, "ip");
+			trap_GetUserinfoValue(bannum, "ip", value, sizeof(value));
 
 			AddIPBan(value);
 		}
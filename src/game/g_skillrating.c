@@ -483,8 +483,7 @@ int G_SkillRatingSetUserRating(srData_t *sr_data)
  */
 void G_SkillRatingGetClientRating(gclient_t *cl)
 {
-	char         userinfo[MAX_INFO_STRING];
-	char         *guid;
+	char         guid[MAX_INFO_VALUE];
 	int          clientNum;
 	srData_t     sr_data;
 
@@ -508,8 +507,7 @@ void G_SkillRatingGetClientRating(gclient_t *cl)
 	clientNum = cl - level.clients;
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	// assign guid
 	sr_data.guid = (const unsigned char *)guid;
@@ -578,8 +576,7 @@ void G_SkillRatingGetClientRating(gclient_t *cl)
  */
 void G_SkillRatingSetClientRating(gclient_t *cl)
 {
-	char         userinfo[MAX_INFO_STRING];
-	char         *guid;
+	char         guid[MAX_INFO_VALUE];
 	int          clientNum;
 	srData_t     sr_data;
 
@@ -609,8 +606,7 @@ void G_SkillRatingSetClientRating(gclient_t *cl)
 	clientNum = cl - level.clients;
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	// assign match data
 	sr_data.guid        = (const unsigned char *)guid;
@@ -1292,11 +1288,9 @@ float G_CalculateWinProbability(int team)
 
 			for (i = 0, cl = level.clients; i < level.maxclients; i++, cl++)
 			{
-				char userinfo[MAX_INFO_STRING];
-				char *guid;
+				char guid[MAX_INFO_VALUE];
 
-				trap_GetUserinfo(cl - level.clients, userinfo, sizeof(userinfo));
-				guid = Info_ValueForKey(userinfo, "cl_guid");
+				trap_GetUserinfoValue(cl - level.clients, "cl_guid", guid, sizeof(guid));
 
 				if (!Q_strncmp((const char *)sr_data.guid, guid, MAX_GUID_LENGTH + 1))
 				{
@@ -1924,11 +1924,9 @@ static void Svcmd_Kick_f(void)
 						// kick but dont ban bots, they arent that lame
 						if (!(g_entities[cl - level.clients].r.svFlags & SVF_BOT))
 						{
-							char *ip;
-							char userinfo[MAX_INFO_STRING];
+							char ip[MAX_INFO_VALUE];
 
-							trap_GetUserinfo(cl - level.clients, userinfo, sizeof(userinfo));
-							ip = Info_ValueForKey(userinfo, "ip");
+							trap_GetUserinfoValue(cl - level.clients, "ip", ip, sizeof(ip));
 							AddIPBan(ip);
 						}
 					}
@@ -1970,11 +1968,9 @@ static void Svcmd_Kick_f(void)
 				// kick but dont ban bots, they arent that lame
 				if (!(g_entities[cl - level.clients].r.svFlags & SVF_BOT))
 				{
-					char *ip;
-					char userinfo[MAX_INFO_STRING];
+					char ip[MAX_INFO_VALUE];
 
-					trap_GetUserinfo(cl - level.clients, userinfo, sizeof(userinfo));
-					ip = Info_ValueForKey(userinfo, "ip");
+					trap_GetUserinfoValue(cl - level.clients, "ip", ip, sizeof(ip));
 					AddIPBan(ip);
 				}
 			}
@@ -2538,6 +2534,80 @@ static void Svcmd_CancelVote_f(void)
 	level.voteInfo.voteCanceled = 1;
 }
 
+/**
+ * @brief Times trap calls through the syscall and through the direct trap table
+ *
+ * Usage: trapbench [calls]
+ */
+static void Svcmd_TrapBench_f(void)
+{
+	gameTrapTable_t *direct = dll_trapTable;
+	char            arg[MAX_TOKEN_CHARS];
+	int             calls   = 100000;
+	int             pass, i, start, msec[2][4];
+	vec3_t          end     = { 0, 0, -64 };
+	trace_t         tr;
+
+	if (trap_Argc() > 1)
+	{
+		trap_Argv(1, arg, sizeof(arg));
+		calls = Q_atoi(arg);
+		if (calls < 1000)
+		{
+			calls = 1000;
+		}
+	}
+
+	if (!direct)
+	{
+		G_Printf("trapbench: the engine did not provide a trap table\n");
+		return;
+	}
+
+	// pass 0 goes through the syscall, pass 1 calls the table directly
+	for (pass = 0; pass < 2; pass++)
+	{
+		dll_trapTable = pass ? direct : NULL;
+
+		start = trap_Milliseconds();
+		for (i = 0; i < calls; i++)
+		{
+			trap_PointContents(vec3_origin, ENTITYNUM_NONE);
+		}
+		msec[pass][0] = trap_Milliseconds() - start;
+
+		start = trap_Milliseconds();
+		for (i = 0; i < calls; i++)
+		{
+			trap_Trace(&tr, vec3_origin, NULL, NULL, end, ENTITYNUM_NONE, MASK_SOLID);
+		}
+		msec[pass][1] = trap_Milliseconds() - start;
+
+		start = trap_Milliseconds();
+		for (i = 0; i < calls; i++)
+		{
+			trap_Cvar_Update(&g_gametype);
+		}
+		msec[pass][2] = trap_Milliseconds() - start;
+
+		start = trap_Milliseconds();
+		for (i = 0; i < calls; i++)
+		{
+			trap_InPVS(vec3_origin, end);
+		}
+		msec[pass][3] = trap_Milliseconds() - start;
+	}
+
+	dll_trapTable = direct;
+
+	G_Printf("%i calls per trap, nsec per call:\n", calls);
+	G_Printf("%-20s %10s %10s\n", "trap", "syscall", "direct");
+	G_Printf("%-20s %10.1f %10.1f\n", "trap_PointContents", msec[0][0] * 1000000.0 / calls, msec[1][0] * 1000000.0 / calls);
+	G_Printf("%-20s %10.1f %10.1f\n", "trap_Trace", msec[0][1] * 1000000.0 / calls, msec[1][1] * 1000000.0 / calls);
+	G_Printf("%-20s %10.1f %10.1f\n", "trap_Cvar_Update", msec[0][2] * 1000000.0 / calls, msec[1][2] * 1000000.0 / calls);
+	G_Printf("%-20s %10.1f %10.1f\n", "trap_InPVS", msec[0][3] * 1000000.0 / calls, msec[1][3] * 1000000.0 / calls);
+}
+
 /**
  * @var consoleCommandTable
  * @brief Store common console command
@@ -2548,6 +2618,7 @@ static consoleCommandTable_t consoleCommandTable[] =
 	{ "csinfo",                     Svcmd_CSInfo_f                },
 	{ "forceteam",                  Svcmd_ForceTeam_f             },
 	{ "game_memory",                Svcmd_GameMem_f               },
+	{ "trapbench",                  Svcmd_TrapBench_f             },
 	{ "addip",                      Svcmd_AddIP_f                 },
 	{ "removeip",                   Svcmd_RemoveIP_f              },
 	{ "listip",                     Svcmd_ListIp_f                },
@@ -70,6 +70,10 @@ void trap_Error(const char *fmt)
  */
 int trap_Milliseconds(void)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->Milliseconds();
+	}
 	return SystemCall(G_MILLISECONDS);
 }
 
@@ -189,6 +193,11 @@ void trap_Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defau
  */
 void trap_Cvar_Update(vmCvar_t *vmCvar)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->Cvar_Update(vmCvar);
+		return;
+	}
 	SystemCall(G_CVAR_UPDATE, vmCvar);
 }
 
@@ -351,6 +360,11 @@ void trap_SetBrushModel(gentity_t *ent, const char *name)
  */
 void trap_Trace(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->Trace(results, start, mins, maxs, end, passEntityNum, contentmask);
+		return;
+	}
 	SystemCall(G_TRACE, results, start, mins, maxs, end, passEntityNum, contentmask);
 }
 
@@ -366,6 +380,11 @@ void trap_Trace(trace_t *results, const vec3_t start, const vec3_t mins, const v
  */
 void trap_TraceNoEnts(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->Trace(results, start, mins, maxs, end, -2, contentmask);
+		return;
+	}
 	SystemCall(G_TRACE, results, start, mins, maxs, end, -2, contentmask);
 }
 
@@ -381,6 +400,11 @@ void trap_TraceNoEnts(trace_t *results, const vec3_t start, const vec3_t mins, c
  */
 void trap_TraceCapsule(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->TraceCapsule(results, start, mins, maxs, end, passEntityNum, contentmask);
+		return;
+	}
 	SystemCall(G_TRACECAPSULE, results, start, mins, maxs, end, passEntityNum, contentmask);
 }
 
@@ -396,6 +420,11 @@ void trap_TraceCapsule(trace_t *results, const vec3_t start, const vec3_t mins,
  */
 void trap_TraceCapsuleNoEnts(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->TraceCapsule(results, start, mins, maxs, end, -2, contentmask);
+		return;
+	}
 	SystemCall(G_TRACECAPSULE, results, start, mins, maxs, end, -2, contentmask);
 }
 
@@ -407,6 +436,10 @@ void trap_TraceCapsuleNoEnts(trace_t *results, const vec3_t start, const vec3_t
  */
 int trap_PointContents(const vec3_t point, int passEntityNum)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->PointContents(point, passEntityNum);
+	}
 	return SystemCall(G_POINT_CONTENTS, point, passEntityNum);
 }
 
@@ -418,6 +451,10 @@ int trap_PointContents(const vec3_t point, int passEntityNum)
  */
 qboolean trap_InPVS(const vec3_t p1, const vec3_t p2)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->InPVS(p1, p2);
+	}
 	return (qboolean)(SystemCall(G_IN_PVS, p1, p2));
 }
 
@@ -429,6 +466,10 @@ qboolean trap_InPVS(const vec3_t p1, const vec3_t p2)
  */
 qboolean trap_InPVSIgnorePortals(const vec3_t p1, const vec3_t p2)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->InPVSIgnorePortals(p1, p2);
+	}
 	return (qboolean)(SystemCall(G_IN_PVS_IGNORE_PORTALS, p1, p2));
 }
 
@@ -450,6 +491,10 @@ void trap_AdjustAreaPortalState(gentity_t *ent, qboolean open)
  */
 qboolean trap_AreasConnected(int area1, int area2)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->AreasConnected(area1, area2);
+	}
 	return (qboolean)(SystemCall(G_AREAS_CONNECTED, area1, area2));
 }
 
@@ -459,6 +504,11 @@ qboolean trap_AreasConnected(int area1, int area2)
  */
 void trap_LinkEntity(gentity_t *ent)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->LinkEntity((sharedEntity_t *)ent);
+		return;
+	}
 	SystemCall(G_LINKENTITY, ent);
 }
 
@@ -468,6 +518,11 @@ void trap_LinkEntity(gentity_t *ent)
  */
 void trap_UnlinkEntity(gentity_t *ent)
 {
+	if (dll_trapTable)
+	{
+		dll_trapTable->UnlinkEntity((sharedEntity_t *)ent);
+		return;
+	}
 	SystemCall(G_UNLINKENTITY, ent);
 }
 
@@ -481,6 +536,10 @@ void trap_UnlinkEntity(gentity_t *ent)
  */
 int trap_EntitiesInBox(const vec3_t mins, const vec3_t maxs, int *list, int maxCount)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->EntitiesInBox(mins, maxs, list, maxCount);
+	}
 	return SystemCall(G_ENTITIES_IN_BOX, mins, maxs, list, maxCount);
 }
 
@@ -493,11 +552,19 @@ int trap_EntitiesInBox(const vec3_t mins, const vec3_t maxs, int *list, int maxC
  */
 qboolean trap_EntityContact(const vec3_t mins, const vec3_t maxs, const gentity_t *ent)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->EntityContact(mins, maxs, (const sharedEntity_t *)ent);
+	}
 	return (qboolean)(SystemCall(G_ENTITY_CONTACT, mins, maxs, ent));
 }
 
 qboolean trap_EntityContactCapsule(const vec3_t mins, const vec3_t maxs, const gentity_t *ent)
 {
+	if (dll_trapTable)
+	{
+		return dll_trapTable->EntityContactCapsule(mins, maxs, (const sharedEntity_t *)ent);
+	}
 	return (qboolean)(SystemCall(G_ENTITY_CONTACTCAPSULE, mins, maxs, ent));
 }
 
@@ -585,7 +652,14 @@ static int       cmdNumber[MAX_CLIENTS];
  */
 void trap_GetUsercmd(int clientNum, usercmd_t *cmd)
 {
-	SystemCall(G_GET_USERCMD, clientNum, cmd);
+	if (dll_trapTable)
+	{
+		dll_trapTable->GetUsercmd(clientNum, cmd);
+	}
+	else
+	{
+		SystemCall(G_GET_USERCMD, clientNum, cmd);
+	}
 
 #ifdef FAKELAG
 	{
@@ -826,3 +900,56 @@ void trap_DemoSupport(const char *commands)
 		SystemCall(dll_trap_DemoSupport, commands);
 	}
 }
+
+/**
+ * @brief Extension for calling the hot traps directly, see gameTrapTable_t
+ * @param[out] table
+ * @param[in] version
+ * @param[in] size
+ * @return qtrue if the engine filled the table
+ */
+qboolean trap_GetTrapTable(gameTrapTable_t *table, int version, int size)
+{
+	if (dll_trap_GetTrapTable)
+	{
+		return (qboolean)(SystemCall(dll_trap_GetTrapTable, table, version, size));
+	}
+	return qfalse;
+}
+
+/**
+ * @brief Extension for asking the engine which cvars were modified since the last call
+ * @param[in,out] sequence - -1 initially
+ * @param[out] handles
+ * @param[in] maxHandles
+ * @return Number of changed handles, -1 if all cvars have to be updated
+ */
+int trap_CvarChanges(int *sequence, int *handles, int maxHandles)
+{
+	if (dll_trap_CvarChanges)
+	{
+		return SystemCall(dll_trap_CvarChanges, sequence, handles, maxHandles);
+	}
+	return -1;
+}
+
+/**
+ * @brief Copies a single userinfo value of a client, without copying and parsing the whole userinfo
+ * @param[in] num
+ * @param[in] key
+ * @param[out] buffer
+ * @param[in] bufferSize
+ */
+void trap_GetUserinfoValue(int num, const char *key, char *buffer, int bufferSize)
+{
+	char userinfo[MAX_INFO_STRING];
+
+	if (dll_trap_GetUserinfoValue)
+	{
+		SystemCall(dll_trap_GetUserinfoValue, num, key, buffer, bufferSize);
+		return;
+	}
+
+	trap_GetUserinfo(num, userinfo, sizeof(userinfo));
+	Q_strncpyz(buffer, Info_ValueForKey(userinfo, key), bufferSize);
+}
@@ -146,8 +146,7 @@ int G_XPSaver_CheckDB(char *db_path, int db_mode)
  */
 void G_XPSaver_Load(gclient_t *cl)
 {
-	char      userinfo[MAX_INFO_STRING];
-	char      *guid;
+	char      guid[MAX_INFO_VALUE];
 	int       clientNum, i;
 	xpData_t  xp_data;
 	gentity_t *ent;
@@ -174,8 +173,7 @@ void G_XPSaver_Load(gclient_t *cl)
 	}
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	// assign guid
 	xp_data.guid = (const unsigned char *)guid;
@@ -203,8 +201,7 @@ void G_XPSaver_Load(gclient_t *cl)
  */
 void G_XPSaver_Store(gclient_t *cl)
 {
-	char      userinfo[MAX_INFO_STRING];
-	char      *guid;
+	char      guid[MAX_INFO_VALUE];
 	int       clientNum, i;
 	xpData_t  xp_data;
 	gentity_t *ent;
@@ -237,8 +234,7 @@ void G_XPSaver_Store(gclient_t *cl)
 	}
 
 	// retrieve guid
-	trap_GetUserinfo(clientNum, userinfo, sizeof(userinfo));
-	guid = Info_ValueForKey(userinfo, "cl_guid");
+	trap_GetUserinfoValue(clientNum, "cl_guid", guid, sizeof(guid));
 
 	xp_data.guid = (const unsigned char *)guid;
 
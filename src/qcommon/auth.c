@@ -125,10 +125,14 @@ void Auth_SV_SetUserinfoAuth(void *gameClient)
 	{
 		Info_SetValueForKey(client->userinfo, "authId", va("%i", client->loginId));
 	}
+
+	SV_InvalidateUserinfo(client);
 }
 
 static void Auth_SV_UserInfoChanged(client_t *client)
 {
+	// the game reads the new auth keys through the userinfo cache
+	SV_InvalidateUserinfo(client);
 	VM_Call(gvm, GAME_CLIENT_USERINFO_CHANGED, client - svs.clients);
 }
 
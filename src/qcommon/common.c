@@ -118,6 +118,7 @@ cvar_t *com_journal;
 cvar_t *com_maxfps;
 cvar_t *com_maxfpsUnfocused;
 cvar_t *com_maxfpsMinimized;
+cvar_t *com_preciseFrames;
 cvar_t *com_timedemo;
 cvar_t *com_sv_running;
 cvar_t *com_cl_running;
@@ -171,6 +172,8 @@ int time_backend;           // renderer backend time
 
 int com_frameTime;
 int com_frameNumber;
+
+frameJitter_t com_frameJitter;
 int com_expectedhunkusage;
 int com_hunkusedvalue;
 
@@ -981,8 +984,15 @@ all big things are allocated on the hunk.
 */
 
 #define ZONEID  0x1d4a11
+#define SLABID  0x1d4a12    ///< id of blocks handed out by a slab
 #define MINFRAGMENT 64
 
+#define ZONE_SIZE_CLASSES   8
+#define ZONE_SLAB_SIZE      4096    ///< size of the zone block a slab is carved from
+
+/// payload sizes of the slab classes, larger allocations go to the zone itself
+static const int zoneSizeClasses[ZONE_SIZE_CLASSES] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
 /**
  * @struct zonedebug_s
  */
@@ -996,6 +1006,9 @@ typedef struct zonedebug_s
 
 /**
  * @struct memblock_s
+ *
+ * @note For blocks of a slab id is SLABID, prev is the zone block holding the
+ * slab and next links the free blocks of the slab.
  */
 typedef struct memblock_s
 {
@@ -1008,6 +1021,22 @@ typedef struct memblock_s
 #endif
 } memblock_t;
 
+/**
+ * @struct zoneSlab_s
+ * @brief Zone block split into equally sized blocks of one size class,
+ * the blocks follow this header
+ */
+typedef struct zoneSlab_s
+{
+	struct zoneSlab_s *next, *prev;         ///< all slabs of the class
+	struct zoneSlab_s *nextFree, *prevFree; ///< slabs of the class with free blocks
+	memblock_t *freeBlocks;
+	int sizeClass;
+	int blockSize;
+	int numBlocks;
+	int numUsed;
+} zoneSlab_t;
+
 /**
  * @struct memzone_s
  */
@@ -1017,6 +1046,9 @@ typedef struct
 	int used;               ///< total bytes used
 	memblock_t blocklist;   ///< start / end cap for linked list
 	memblock_t *rover;
+
+	zoneSlab_t *slabs[ZONE_SIZE_CLASSES];
+	zoneSlab_t *freeSlabs[ZONE_SIZE_CLASSES];
 } memzone_t;
 
 /// main zone for all "dynamic" memory allocation
@@ -1036,6 +1068,8 @@ static void Z_ClearZone(memzone_t *zone, int size)
 {
 	memblock_t *block;
 
+	Com_Memset(zone, 0, sizeof(*zone));
+
 	// set the entire zone to one free block
 
 	zone->blocklist.next = zone->blocklist.prev = block =
@@ -1054,53 +1088,92 @@ static void Z_ClearZone(memzone_t *zone, int size)
 }
 
 /**
- * @brief Z_Free
- * @param[out] ptr
+ * @brief Z_ZoneForTag
+ * @param[in] tag
+ * @return
  */
-void Z_Free(void *ptr)
+static ID_INLINE memzone_t *Z_ZoneForTag(int tag)
 {
-	memblock_t *block, *other;
-	memzone_t  *zone;
+	return tag == TAG_SMALL ? smallzone : mainzone;
+}
 
-	if (!ptr)
-	{
-		Com_Error(ERR_DROP, "Z_Free: NULL pointer");
-	}
+/**
+ * @brief First fit search for a free block of the zone
+ * @param[in,out] zone
+ * @param[in] size - including the header and the trash tester, padded
+ * @param[in] tag
+ * @return The block, NULL if there is no free block of sufficient size
+ */
+static memblock_t *Z_ZoneAlloc(memzone_t *zone, size_t size, int tag)
+{
+	size_t     extra;
+	memblock_t *start, *rover, *new, *base;
 
-	block = ( memblock_t * )((byte *)ptr - sizeof(memblock_t));
-	if (block->id != ZONEID)
-	{
-		Com_Error(ERR_FATAL, "Z_Free: freed a pointer without ZONEID");
-	}
-	if (block->tag == 0)
-	{
-		Com_Error(ERR_FATAL, "Z_Free: freed a freed pointer");
-	}
-	// if static memory
-	if (block->tag == TAG_STATIC)
-	{
-		return;
-	}
+	// scan through the block list looking for the first free block
+	// of sufficient size
 
-	// check the memory trash tester
-	if (*( int * )((byte *)block + block->size - 4) != ZONEID)
-	{
-		Com_Error(ERR_FATAL, "Z_Free: memory block wrote past end");
-	}
+	base  = rover = zone->rover;
+	start = base->prev;
 
-	if (block->tag == TAG_SMALL)
+	do
 	{
-		zone = smallzone;
+		if (rover == start)
+		{
+			return NULL;
+		}
+		if (rover->tag)
+		{
+			base = rover = rover->next;
+		}
+		else
+		{
+			rover = rover->next;
+		}
 	}
-	else
+	while (base->tag || base->size < size);
+
+	// found a block big enough
+	extra = base->size - size;
+	if (extra > MINFRAGMENT)
 	{
-		zone = mainzone;
+		// there will be a free fragment after the allocated block
+		new             = ( memblock_t * )((byte *)base + size);
+		new->size       = extra;
+		new->tag        = 0;    // free block
+		new->prev       = base;
+		new->id         = ZONEID;
+		new->next       = base->next;
+		new->next->prev = new;
+		base->next      = new;
+		base->size      = size;
 	}
 
+	base->tag = tag;            // no longer a free block
+
+	zone->rover = base->next;   // next allocation will start looking here
+	zone->used += base->size;   //
+
+	base->id = ZONEID;
+
+	// marker for memory trash testing
+	*( int * )((byte *)base + base->size - 4) = ZONEID;
+
+	return base;
+}
+
+/**
+ * @brief Returns a block to the zone and merges it with its free neighbours
+ * @param[in,out] zone
+ * @param[in,out] block
+ */
+static void Z_ZoneFree(memzone_t *zone, memblock_t *block)
+{
+	memblock_t *other;
+
 	zone->used -= block->size;
 	// set the block to something that should cause problems
 	// if it is referenced...
-	Com_Memset(ptr, 0xaa, block->size - sizeof(*block));
+	Com_Memset(block + 1, 0xaa, block->size - sizeof(*block));
 
 	block->tag = 0;     // mark as free
 
@@ -1135,20 +1208,313 @@ void Z_Free(void *ptr)
 }
 
 /**
- * @brief Z_FreeTags
+ * @brief Z_SizeClass
+ * @param[in] size - requested size
+ * @return Size class for size, -1 if it is too large for a slab
+ */
+static ID_INLINE int Z_SizeClass(size_t size)
+{
+	int i;
+
+	for (i = 0; i < ZONE_SIZE_CLASSES; i++)
+	{
+		if (size <= (size_t)zoneSizeClasses[i])
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Z_SlabHeader
+ * @param[in] block - block handed out by the slab
+ * @return
+ */
+static ID_INLINE zoneSlab_t *Z_SlabHeader(const memblock_t *block)
+{
+	return (zoneSlab_t *)(block->prev + 1);
+}
+
+/**
+ * @brief Z_SlabBlock
+ * @param[in] slab
+ * @param[in] index
+ * @return Block number index of the slab
+ */
+static ID_INLINE memblock_t *Z_SlabBlock(const zoneSlab_t *slab, int index)
+{
+	return (memblock_t *)((byte *)slab + PAD(sizeof(zoneSlab_t), sizeof(intptr_t)) + index * slab->blockSize);
+}
+
+/**
+ * @brief Z_LinkFreeSlab
+ * @param[in,out] zone
+ * @param[in,out] slab
+ */
+static void Z_LinkFreeSlab(memzone_t *zone, zoneSlab_t *slab)
+{
+	slab->prevFree = NULL;
+	slab->nextFree = zone->freeSlabs[slab->sizeClass];
+	if (slab->nextFree)
+	{
+		slab->nextFree->prevFree = slab;
+	}
+	zone->freeSlabs[slab->sizeClass] = slab;
+}
+
+/**
+ * @brief Z_UnlinkFreeSlab
+ * @param[in,out] zone
+ * @param[in,out] slab
+ */
+static void Z_UnlinkFreeSlab(memzone_t *zone, zoneSlab_t *slab)
+{
+	if (slab->prevFree)
+	{
+		slab->prevFree->nextFree = slab->nextFree;
+	}
+	else
+	{
+		zone->freeSlabs[slab->sizeClass] = slab->nextFree;
+	}
+	if (slab->nextFree)
+	{
+		slab->nextFree->prevFree = slab->prevFree;
+	}
+	slab->nextFree = slab->prevFree = NULL;
+}
+
+/**
+ * @brief Carves a new slab of a size class out of the zone
+ * @param[in,out] zone
+ * @param[in] sizeClass
+ * @return The slab, NULL if the zone is exhausted
+ */
+static zoneSlab_t *Z_NewSlab(memzone_t *zone, int sizeClass)
+{
+	memblock_t *zoneBlock, *block;
+	zoneSlab_t *slab;
+	byte       *data;
+	int        i;
+
+	zoneBlock = Z_ZoneAlloc(zone, ZONE_SLAB_SIZE, TAG_SLAB);
+	if (!zoneBlock)
+	{
+		return NULL;
+	}
+
+#ifdef ZONE_DEBUG
+	zoneBlock->d.label     = "slab";
+	zoneBlock->d.file      = ETL_FILENAME;
+	zoneBlock->d.line      = __LINE__;
+	zoneBlock->d.allocSize = ZONE_SLAB_SIZE;
+#endif
+
+	slab            = (zoneSlab_t *)(zoneBlock + 1);
+	slab->sizeClass = sizeClass;
+	slab->blockSize = PAD(sizeof(memblock_t) + zoneSizeClasses[sizeClass] + 4, sizeof(intptr_t));
+	slab->numUsed   = 0;
+
+	// the zone block keeps its own trash tester in the last 4 bytes
+	data            = (byte *)Z_SlabBlock(slab, 0);
+	slab->numBlocks = (int)(((byte *)zoneBlock + zoneBlock->size - 4 - data) / slab->blockSize);
+
+	slab->freeBlocks = NULL;
+	for (i = slab->numBlocks - 1; i >= 0; i--)
+	{
+		block            = Z_SlabBlock(slab, i);
+		block->size      = slab->blockSize;
+		block->tag       = 0;
+		block->id        = SLABID;
+		block->prev      = zoneBlock;
+		block->next      = slab->freeBlocks;
+		slab->freeBlocks = block;
+	}
+
+	slab->prev = NULL;
+	slab->next = zone->slabs[sizeClass];
+	if (slab->next)
+	{
+		slab->next->prev = slab;
+	}
+	zone->slabs[sizeClass] = slab;
+
+	Z_LinkFreeSlab(zone, slab);
+
+	return slab;
+}
+
+/**
+ * @brief Takes a block of a size class from the first slab with free blocks
+ * @param[in,out] zone
+ * @param[in] sizeClass
  * @param[in] tag
+ * @return The block, NULL if the zone is exhausted
  */
-void Z_FreeTags(int tag)
+static memblock_t *Z_SlabAlloc(memzone_t *zone, int sizeClass, int tag)
+{
+	zoneSlab_t *slab = zone->freeSlabs[sizeClass];
+	memblock_t *block;
+
+	if (!slab)
+	{
+		slab = Z_NewSlab(zone, sizeClass);
+		if (!slab)
+		{
+			return NULL;
+		}
+	}
+
+	block            = slab->freeBlocks;
+	slab->freeBlocks = block->next;
+	slab->numUsed++;
+
+	if (!slab->freeBlocks)
+	{
+		Z_UnlinkFreeSlab(zone, slab);
+	}
+
+	block->next = NULL;
+	block->tag  = tag;
+
+	// marker for memory trash testing
+	*( int * )((byte *)block + block->size - 4) = ZONEID;
+
+	return block;
+}
+
+/**
+ * @brief Returns a block to its slab, empty slabs go back to the zone
+ * unless they are the last ones with free blocks of their class
+ * @param[in,out] zone
+ * @param[in,out] block
+ */
+static void Z_SlabFree(memzone_t *zone, memblock_t *block)
 {
-	memzone_t *zone;
+	zoneSlab_t *slab = Z_SlabHeader(block);
+
+	// set the block to something that should cause problems
+	// if it is referenced...
+	Com_Memset(block + 1, 0xaa, block->size - sizeof(*block));
 
-	if (tag == TAG_SMALL)
+	block->tag       = 0;
+	block->next      = slab->freeBlocks;
+	slab->freeBlocks = block;
+	slab->numUsed--;
+
+	if (!block->next)
 	{
-		zone = smallzone;
+		// was full
+		Z_LinkFreeSlab(zone, slab);
+	}
+
+	if (slab->numUsed || (zone->freeSlabs[slab->sizeClass] == slab && !slab->nextFree))
+	{
+		return;
+	}
+
+	Z_UnlinkFreeSlab(zone, slab);
+
+	if (slab->prev)
+	{
+		slab->prev->next = slab->next;
 	}
 	else
 	{
-		zone = mainzone;
+		zone->slabs[slab->sizeClass] = slab->next;
+	}
+	if (slab->next)
+	{
+		slab->next->prev = slab->prev;
+	}
+
+	Z_ZoneFree(zone, block->prev);
+}
+
+/**
+ * @brief Z_Free
+ * @param[out] ptr
+ */
+void Z_Free(void *ptr)
+{
+	memblock_t *block;
+	memzone_t  *zone;
+
+	if (!ptr)
+	{
+		Com_Error(ERR_DROP, "Z_Free: NULL pointer");
+	}
+
+	block = ( memblock_t * )((byte *)ptr - sizeof(memblock_t));
+	if (block->id != ZONEID && block->id != SLABID)
+	{
+		Com_Error(ERR_FATAL, "Z_Free: freed a pointer without ZONEID");
+	}
+	if (block->tag == 0)
+	{
+		Com_Error(ERR_FATAL, "Z_Free: freed a freed pointer");
+	}
+	// if static memory
+	if (block->tag == TAG_STATIC)
+	{
+		return;
+	}
+
+	// check the memory trash tester
+	if (*( int * )((byte *)block + block->size - 4) != ZONEID)
+	{
+		Com_Error(ERR_FATAL, "Z_Free: memory block wrote past end");
+	}
+
+	zone = Z_ZoneForTag(block->tag);
+
+	if (block->id == SLABID)
+	{
+		Z_SlabFree(zone, block);
+	}
+	else
+	{
+		Z_ZoneFree(zone, block);
+	}
+}
+
+/**
+ * @brief Z_FreeTags
+ * @param[in] tag
+ */
+void Z_FreeTags(int tag)
+{
+	memzone_t  *zone = Z_ZoneForTag(tag);
+	zoneSlab_t *slab, *nextSlab;
+	memblock_t *block;
+	int        i, j;
+
+	// slabs first, the last Z_Free of a slab releases its zone block
+	for (i = 0; i < ZONE_SIZE_CLASSES; i++)
+	{
+		for (slab = zone->slabs[i]; slab; slab = nextSlab)
+		{
+			nextSlab = slab->next;
+
+			for (j = 0; j < slab->numBlocks; j++)
+			{
+				block = Z_SlabBlock(slab, j);
+				if (block->tag != tag)
+				{
+					continue;
+				}
+
+				// the slab may be gone after freeing its last block
+				if (slab->numUsed == 1)
+				{
+					Z_Free(block + 1);
+					break;
+				}
+				Z_Free(block + 1);
+			}
+		}
 	}
 
 	// use the rover as our pointer, because
@@ -1186,87 +1552,51 @@ void *Z_TagMallocDebug(size_t size, int tag, char *label, char *file, int line)
 void *Z_TagMalloc(size_t size, int tag)
 {
 #endif
-	size_t     extra;
-	memblock_t *start, *rover, *new, *base;
+	memblock_t *base;
 	memzone_t  *zone;
+	int        sizeClass;
 
 	if (!tag)
 	{
 		Com_Error(ERR_FATAL, "Z_TagMalloc: tried to use a 0 tag");
 	}
 
-	if (tag == TAG_SMALL)
-	{
-		zone = smallzone;
-	}
-	else
-	{
-		zone = mainzone;
-	}
+	zone = Z_ZoneForTag(tag);
 
 #ifdef ZONE_DEBUG
 	allocSize = size;
 #endif
 
-	// scan through the block list looking for the first free block
-	// of sufficient size
+	// small sizes come from the slabs, they don't fragment the zone
+	sizeClass = Z_SizeClass(size);
 
 	size += sizeof(memblock_t);         // account for size of block header
 	size += 4;                          // space for memory trash tester
 	size  = PAD(size, sizeof(intptr_t)); // align to 32/64 bit boundary
 
-	base  = rover = zone->rover;
-	start = base->prev;
+	if (sizeClass >= 0)
+	{
+		base = Z_SlabAlloc(zone, sizeClass, tag);
+	}
+	else
+	{
+		base = Z_ZoneAlloc(zone, size, tag);
+	}
 
-	do
+	if (!base)
 	{
-		if (rover == start)
-		{
 #ifdef ZONE_DEBUG
-			Z_LogHeap();
+		Z_LogHeap();
 
-			Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %zu bytes from the %s zone: %s, line: %d (%s)",
-			          size, zone == smallzone ? "small" : "main", file, line, label);
+		Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %zu bytes from the %s zone: %s, line: %d (%s)",
+		          size, zone == smallzone ? "small" : "main", file, line, label);
 #else
-			Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %zu bytes from the %s zone",
-			          size, zone == smallzone ? "small" : "main");
+		Com_Error(ERR_FATAL, "Z_Malloc: failed on allocation of %zu bytes from the %s zone",
+		          size, zone == smallzone ? "small" : "main");
 #endif
-			return NULL;
-		}
-		if (rover->tag)
-		{
-			base = rover = rover->next;
-		}
-		else
-		{
-			rover = rover->next;
-		}
-	}
-	while (base->tag || base->size < size);
-
-	// found a block big enough
-	extra = base->size - size;
-	if (extra > MINFRAGMENT)
-	{
-		// there will be a free fragment after the allocated block
-		new             = ( memblock_t * )((byte *)base + size);
-		new->size       = extra;
-		new->tag        = 0;    // free block
-		new->prev       = base;
-		new->id         = ZONEID;
-		new->next       = base->next;
-		new->next->prev = new;
-		base->next      = new;
-		base->size      = size;
+		return NULL;
 	}
 
-	base->tag = tag;            // no longer a free block
-
-	zone->rover = base->next;   // next allocation will start looking here
-	zone->used += base->size;   //
-
-	base->id = ZONEID;
-
 #ifdef ZONE_DEBUG
 	base->d.label     = label;
 	base->d.file      = file;
@@ -1274,9 +1604,6 @@ void *Z_TagMalloc(size_t size, int tag)
 	base->d.allocSize = allocSize;
 #endif
 
-	// marker for memory trash testing
-	*( int * )((byte *)base + base->size - 4) = ZONEID;
-
 	return ( void * )((byte *)base + sizeof(memblock_t));
 }
 
@@ -1338,19 +1665,50 @@ static void Z_CheckHeap(void)
 }
 
 /**
- * @brief Z_LogZoneHeap
- * @param zone
- * @param name
+ * @brief Z_LogBlock
+ * @param[in] block
+ * @param[in,out] size
+ * @param[in,out] allocSize
  */
-void Z_LogZoneHeap(memzone_t *zone, const char *name)
+static void Z_LogBlock(memblock_t *block, int *size, int *allocSize)
 {
 #ifdef ZONE_DEBUG
 	char dump[32], *ptr;
 	int  i, j;
+	char buf[4096];
+
+	ptr = ((char *) block) + sizeof(memblock_t);
+	j   = 0;
+	for (i = 0; i < 20 && i < block->d.allocSize; i++)
+	{
+		if (ptr[i] >= 32 && ptr[i] < 127)
+		{
+			dump[j++] = ptr[i];
+		}
+		else
+		{
+			dump[j++] = '_';
+		}
+	}
+	dump[j] = '\0';
+	Com_sprintf(buf, sizeof(buf), "size = %8d: %s, line: %d (%s) [%s]\r\n", block->d.allocSize, block->d.file, block->d.line, block->d.label, dump);
+	FS_Write(buf, strlen(buf), logfile);
+	*allocSize += block->d.allocSize;
 #endif
+	*size += block->size;
+}
+
+/**
+ * @brief Z_LogZoneHeap
+ * @param zone
+ * @param name
+ */
+void Z_LogZoneHeap(memzone_t *zone, const char *name)
+{
 	memblock_t *block;
+	zoneSlab_t *slab;
 	char       buf[4096];
-	int        size, allocSize, numBlocks;
+	int        size, allocSize, numBlocks, i;
 
 	if (!logfile || !FS_Initialized())
 	{
@@ -1361,28 +1719,22 @@ void Z_LogZoneHeap(memzone_t *zone, const char *name)
 	FS_Write(buf, strlen(buf), logfile);
 	for (block = zone->blocklist.next ; block->next != &zone->blocklist; block = block->next)
 	{
-		if (block->tag)
+		if (block->tag == TAG_SLAB)
 		{
-#ifdef ZONE_DEBUG
-			ptr = ((char *) block) + sizeof(memblock_t);
-			j   = 0;
-			for (i = 0; i < 20 && i < block->d.allocSize; i++)
+			// log the blocks of the slab instead
+			slab = (zoneSlab_t *)(block + 1);
+			for (i = 0; i < slab->numBlocks; i++)
 			{
-				if (ptr[i] >= 32 && ptr[i] < 127)
+				if (Z_SlabBlock(slab, i)->tag)
 				{
-					dump[j++] = ptr[i];
-				}
-				else
-				{
-					dump[j++] = '_';
+					Z_LogBlock(Z_SlabBlock(slab, i), &size, &allocSize);
+					numBlocks++;
 				}
 			}
-			dump[j] = '\0';
-			Com_sprintf(buf, sizeof(buf), "size = %8d: %s, line: %d (%s) [%s]\r\n", block->d.allocSize, block->d.file, block->d.line, block->d.label, dump);
-			FS_Write(buf, strlen(buf), logfile);
-			allocSize += block->d.allocSize;
-#endif
-			size += block->size;
+		}
+		else if (block->tag)
+		{
+			Z_LogBlock(block, &size, &allocSize);
 			numBlocks++;
 		}
 	}
@@ -1542,16 +1894,69 @@ static int  s_hunkTotal;
 static int s_zoneTotal;
 static int s_smallZoneTotal;
 
+/**
+ * @brief Prints use and fragmentation of the slabs and the free blocks of a zone
+ * @param[in] zone
+ * @param[in] name
+ */
+static void Z_ZoneStats(memzone_t *zone, const char *name)
+{
+	memblock_t *block;
+	zoneSlab_t *slab;
+	int        i, numSlabs, numBlocks, numUsed, usedBytes;
+	int        freeBytes = 0, freeBlocks = 0, largestFree = 0;
+
+	Com_Printf("%s zone slabs:\n", name);
+	for (i = 0; i < ZONE_SIZE_CLASSES; i++)
+	{
+		numSlabs = numBlocks = numUsed = 0;
+		for (slab = zone->slabs[i]; slab; slab = slab->next)
+		{
+			numSlabs++;
+			numBlocks += slab->numBlocks;
+			numUsed   += slab->numUsed;
+		}
+
+		if (!numSlabs)
+		{
+			continue;
+		}
+
+		usedBytes = numUsed * zoneSizeClasses[i];
+		Com_Printf("  %4i bytes: %9i bytes in %6i/%6i blocks, %4i slabs, %5.1f%% unused\n",
+		           zoneSizeClasses[i], usedBytes, numUsed, numBlocks, numSlabs,
+		           100.f * (numBlocks - numUsed) / numBlocks);
+	}
+
+	for (block = zone->blocklist.next ; block != &zone->blocklist; block = block->next)
+	{
+		if (!block->tag)
+		{
+			freeBytes += block->size;
+			freeBlocks++;
+			if ((int)block->size > largestFree)
+			{
+				largestFree = block->size;
+			}
+		}
+	}
+
+	// share of the free memory that isn't usable for the largest allocation
+	Com_Printf("%s zone free: %i bytes in %i blocks, largest %i bytes, %5.1f%% fragmented\n", name,
+	           freeBytes, freeBlocks, largestFree, freeBytes ? 100.f * (freeBytes - largestFree) / freeBytes : 0.f);
+}
+
 /**
  * @brief Com_Meminfo_f
  */
 void Com_Meminfo_f(void)
 {
-	memblock_t *block;
+	memblock_t *block, *slabBlock;
+	zoneSlab_t *slab;
 	int        zoneBytes = 0, zoneBlocks = 0;
 	int        smallZoneBytes, smallZoneBlocks;
 	int        botlibBytes = 0, rendererBytes = 0;
-	int        unused;
+	int        unused, i;
 
 	for (block = mainzone->blocklist.next ; ; block = block->next)
 	{
@@ -1560,7 +1965,31 @@ void Com_Meminfo_f(void)
 			Com_Printf("block:%p    size:%7zu    tag:%3i\n",
 			           block, block->size, block->tag);
 		}
-		if (block->tag)
+		if (block->tag == TAG_SLAB)
+		{
+			// count the blocks of the slab instead
+			slab = (zoneSlab_t *)(block + 1);
+			for (i = 0; i < slab->numBlocks; i++)
+			{
+				slabBlock = Z_SlabBlock(slab, i);
+				if (!slabBlock->tag)
+				{
+					continue;
+				}
+
+				zoneBytes += slabBlock->size;
+				zoneBlocks++;
+				if (slabBlock->tag == TAG_BOTLIB)
+				{
+					botlibBytes += slabBlock->size;
+				}
+				else if (slabBlock->tag == TAG_RENDERER)
+				{
+					rendererBytes += slabBlock->size;
+				}
+			}
+		}
+		else if (block->tag)
 		{
 			zoneBytes += block->size;
 			zoneBlocks++;
@@ -1596,7 +2025,19 @@ void Com_Meminfo_f(void)
 	smallZoneBlocks = 0;
 	for (block = smallzone->blocklist.next ; ; block = block->next)
 	{
-		if (block->tag)
+		if (block->tag == TAG_SLAB)
+		{
+			slab = (zoneSlab_t *)(block + 1);
+			for (i = 0; i < slab->numBlocks; i++)
+			{
+				if (Z_SlabBlock(slab, i)->tag)
+				{
+					smallZoneBytes += Z_SlabBlock(slab, i)->size;
+					smallZoneBlocks++;
+				}
+			}
+		}
+		else if (block->tag)
 		{
 			smallZoneBytes += block->size;
 			smallZoneBlocks++;
@@ -1644,6 +2085,9 @@ void Com_Meminfo_f(void)
 	Com_Printf("        %9i bytes (%6.2f MB) in dynamic renderer\n", rendererBytes, rendererBytes / Square(1024.f));
 	Com_Printf("        %9i bytes (%6.2f MB) in dynamic other\n", zoneBytes - (botlibBytes + rendererBytes), (zoneBytes - (botlibBytes + rendererBytes)) / Square(1024.f));
 	Com_Printf("        %9i bytes (%6.2f MB) in small Zone memory (%i) blocks\n", smallZoneBytes, smallZoneBytes / Square(1024.f), smallZoneBlocks);
+	Com_Printf("\n");
+	Z_ZoneStats(mainzone, "main");
+	Z_ZoneStats(smallzone, "small");
 }
 
 /**
@@ -2972,6 +3416,8 @@ void Com_Init(char *commandLine)
 	com_maxfpsMinimized = Cvar_Get("com_maxfpsMinimized", "-1", CVAR_ARCHIVE);
 	Cvar_CheckRange(com_maxfpsMinimized, -1, 500, qtrue);
 
+	com_preciseFrames = Cvar_Get("com_preciseFrames", "0", CVAR_ARCHIVE_ND);
+
 	com_developer = Cvar_Get("developer", "0", CVAR_TEMP);
 	com_logfile   = Cvar_Get("logfile", "0", CVAR_TEMP);
 
@@ -3362,6 +3808,102 @@ int Com_TimeVal(int minMsec)
 	return timeVal;
 }
 
+/**
+ * @brief Waits for the next dedicated server frame with usec precision
+ *
+ * Sleeps on the game sockets and a timerfd until Sys_Milliseconds() reaches
+ * com_frameTime + minMsec, waking up early only for packets and for the
+ * queued packets of SV_SendQueuedPackets.
+ *
+ * @param[in] minMsec
+ * @return qfalse if the select() based loop has to be used instead
+ */
+static qboolean Com_PreciseFrameWait(int minMsec)
+{
+#ifdef __linux__
+	long long deadline, wake, now;
+	int       timeValSV;
+
+	if (!com_dedicated->integer || !com_preciseFrames->integer)
+	{
+		return qfalse;
+	}
+
+	// Sys_Milliseconds ticks over to com_frameTime + minMsec right at this point
+	deadline = ((long long)com_frameTime + minMsec) * 1000;
+
+	do
+	{
+		now  = Sys_Microseconds();
+		wake = deadline;
+
+		if (com_sv_running->integer)
+		{
+			timeValSV = SV_SendQueuedPackets();
+
+			if (now + timeValSV * 1000LL < wake)
+			{
+				wake = now + timeValSV * 1000LL;
+			}
+		}
+
+		if (!NET_SleepPrecise(wake > now ? (int)(wake - now) : 0))
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: precise frame scheduling is not available, disabling com_preciseFrames\n");
+			Cvar_Set("com_preciseFrames", "0");
+			return qfalse;
+		}
+	}
+	while (Sys_Microseconds() < deadline);
+
+	return qtrue;
+#else
+	return qfalse;
+#endif
+}
+
+/**
+ * @brief Accumulates how late the dedicated server frame started
+ * @param[in] minMsec
+ */
+static void Com_UpdateFrameJitter(int minMsec)
+{
+#ifndef _WIN32
+	int late;
+
+	if (!com_dedicated->integer || !com_sv_running->integer)
+	{
+		return;
+	}
+
+	late = (int)(Sys_Microseconds() - ((long long)com_frameTime + minMsec) * 1000);
+
+	if (late < 0)
+	{
+		late = 0;
+	}
+
+	// map loads and other hitches aren't scheduling jitter
+	if (late > 100000)
+	{
+		com_frameJitter.stalls++;
+		return;
+	}
+
+	com_frameJitter.frames++;
+	com_frameJitter.total += late;
+
+	if (late > com_frameJitter.max)
+	{
+		com_frameJitter.max = late;
+	}
+	if (late >= 1000)
+	{
+		com_frameJitter.late++;
+	}
+#endif
+}
+
 /**
  * @brief Com_Frame
  */
@@ -3378,6 +3920,8 @@ void Com_Frame(void)
 
 	if (setjmp(abortframe))
 	{
+		// whatever was cut short has to be released here
+		SV_CL_AbortMessageQueue();
 		return;         // an ERR_DROP was thrown
 	}
 
@@ -3478,33 +4022,38 @@ void Com_Frame(void)
 		minMsec = 1;
 	}
 
-	do
+	if (!Com_PreciseFrameWait(minMsec))
 	{
-		if (com_sv_running->integer)
+		do
 		{
-			timeValSV = SV_SendQueuedPackets();
-			timeVal   = Com_TimeVal(minMsec);
+			if (com_sv_running->integer)
+			{
+				timeValSV = SV_SendQueuedPackets();
+				timeVal   = Com_TimeVal(minMsec);
 
-			if (timeValSV < timeVal)
+				if (timeValSV < timeVal)
+				{
+					timeVal = timeValSV;
+				}
+			}
+			else
 			{
-				timeVal = timeValSV;
+				timeVal = Com_TimeVal(minMsec);
 			}
-		}
-		else
-		{
-			timeVal = Com_TimeVal(minMsec);
-		}
 
-		if (timeVal < 1)
-		{
-			NET_Sleep(0);
-		}
-		else
-		{
-			NET_Sleep(timeVal - 1);
+			if (timeVal < 1)
+			{
+				NET_Sleep(0);
+			}
+			else
+			{
+				NET_Sleep(timeVal - 1);
+			}
 		}
+		while (Com_TimeVal(minMsec));
 	}
-	while (Com_TimeVal(minMsec));
+
+	Com_UpdateFrameJitter(minMsec);
 
 #ifndef DEDICATED
 	IN_Frame();
@@ -48,6 +48,20 @@ int    cvar_numIndexes;
 static cvar_t *hashTable[FILE_HASH_SIZE];
 #define generateHashValue(fname) Q_GenerateHashValue(fname, FILE_HASH_SIZE, qtrue, qtrue)
 
+#define CVAR_JOURNAL_SIZE   256                        ///< must be a power of two
+static int cvar_journal[CVAR_JOURNAL_SIZE];            ///< handles of the last modified cvars
+static int cvar_modificationSequence;                  ///< number of cvar modifications so far
+
+/**
+ * @brief Records a cvar modification in the change journal
+ * @param[in] var
+ */
+static void Cvar_Journal(const cvar_t *var)
+{
+	cvar_journal[cvar_modificationSequence & (CVAR_JOURNAL_SIZE - 1)] = var - cvar_indexes;
+	cvar_modificationSequence++;
+}
+
 /**
  * @brief Cvar_ValidateString
  * @param[in] s
@@ -574,6 +588,8 @@ cvar_t *Cvar_Get(const char *varName, const char *value, cvarFlags_t flags)
 	var->validate          = qfalse;
 	var->description       = NULL;
 
+	Cvar_Journal(var);
+
 	// link the variable in
 	var->next = cvar_vars;
 	if (cvar_vars)
@@ -759,6 +775,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 			var->latchedString = CopyString(value);
 			var->modified      = qtrue;
 			var->modificationCount++;
+			Cvar_Journal(var);
 			return var;
 		}
 	}
@@ -778,6 +795,7 @@ cvar_t *Cvar_Set2(const char *var_name, const char *value, qboolean force)
 	}
 	var->modified = qtrue;
 	var->modificationCount++;
+	Cvar_Journal(var);
 
 	Z_Free(var->string);     // free the old value string
 
@@ -1878,6 +1896,40 @@ void Cvar_Update(vmCvar_t *vmCvar)
 	vmCvar->integer = cv->integer;
 }
 
+/**
+ * @brief Lists the cvars modified since the caller last asked
+ *
+ * Modules keep their own position in the modification sequence and only
+ * have to Cvar_Update the returned handles. A handle may be listed twice.
+ *
+ * @param[in,out] sequence - modification sequence the caller has seen, -1 initially, set to the current one
+ * @param[out] handles
+ * @param[in] maxHandles
+ * @return Number of handles written, -1 if the caller has to update all of its cvars
+ */
+int Cvar_Changes(int *sequence, int *handles, int maxHandles)
+{
+	int count, i;
+
+	etl_assert(sequence);
+
+	count = cvar_modificationSequence - *sequence;
+
+	if (*sequence < 0 || count < 0 || count > CVAR_JOURNAL_SIZE || count > maxHandles || (count && !handles))
+	{
+		*sequence = cvar_modificationSequence;
+		return -1;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		handles[i] = cvar_journal[(*sequence + i) & (CVAR_JOURNAL_SIZE - 1)];
+	}
+
+	*sequence = cvar_modificationSequence;
+	return count;
+}
+
 /**
  * @brief Cvar_CompleteCvarName
  * @param[in] args
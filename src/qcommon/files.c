@@ -491,7 +491,7 @@ static fileHandle_t FS_HandleForFile(void)
  * @param[in] f
  * @return
  */
-static FILE *FS_FileForHandle(fileHandle_t f)
+FILE *FS_FileForHandle(fileHandle_t f)
 {
 	if (f < 1 || f >= MAX_FILE_HANDLES)
 	{
@@ -2016,10 +2016,11 @@ qboolean FS_CL_ExtractFromPakFile(const char *base, const char *gamedir, const c
  */
 qboolean FS_AllowDeletion(const char *fileName)
 {
-	// for safety, only allow deletion from the save, profiles, demo directory and pid file
+	// for safety, only allow deletion from the save, profiles, demo, image cache directory and pid file
 	if (Q_strncmp(fileName, "save/", 5) != 0 &&
 	    Q_strncmp(fileName, "profiles/", 9) != 0 &&
 	    Q_strncmp(fileName, "demos/", 6) != 0 &&
+	    Q_strncmp(fileName, "imagecache/", 11) != 0 &&
 	    !strstr(fileName, ".pid")) // PID file
 	{
 		return qfalse;
@@ -2543,6 +2544,44 @@ int FS_FileIsInPAK(const char *fileName, int *pChecksum)
 	return -1;
 }
 
+/**
+ * @brief Tells where FS_ReadFile would read a file from
+ * @param[in] fileName
+ * @param[out] pChecksum checksum of the pk3 file, unlike FS_FileIsInPAK not salted by the checksum feed
+ * @return 1 if the file is read from a pk3 file, 0 if it is a loose file, -1 if it is not found
+ */
+int FS_FileOrigin(const char *fileName, int *pChecksum)
+{
+	searchpath_t *search;
+	fileHandle_t h;
+	int          origin = 0;
+
+	if (FS_FOpenFileRead(fileName, &h, qfalse) < 0 || !h)
+	{
+		return -1;
+	}
+
+	if (fsh[h].zipFile)
+	{
+		for (search = fs_searchpaths; search; search = search->next)
+		{
+			if (search->pack && search->pack->handle == fsh[h].handleFiles.file.z)
+			{
+				if (pChecksum)
+				{
+					*pChecksum = search->pack->checksum;
+				}
+				origin = 1;
+				break;
+			}
+		}
+	}
+
+	FS_FCloseFile(h);
+
+	return origin;
+}
+
 /**
  * @brief Open a file relative to the ET:L search path.
  * A null buffer will just return the file length without loading.
@@ -177,6 +177,61 @@ void MSG_Copy(msg_t *buf, byte *data, int length, msg_t *src)
 	Com_Memcpy(buf->data, src->data, src->cursize);
 }
 
+/**
+ * @brief Append the bits written to a compressed message to another one
+ *
+ * @details The huffman table is static, so the bits of an encoded message are
+ * context free and can be appended at any bit offset without being encoded again.
+ *
+ * @param[in,out] msg
+ * @param[in] src
+ */
+void MSG_WriteBitstream(msg_t *msg, const msg_t *src)
+{
+	const byte *in = src->data;
+	byte       *out;
+	int        shift, bytes, i;
+
+	if (msg->oob || src->oob)
+	{
+		Com_Error(ERR_DROP, "MSG_WriteBitstream: can't append out of band messages");
+	}
+
+	if (msg->overflowed || !src->bit)
+	{
+		return;
+	}
+
+	if (msg->bit + src->bit + 8 > msg->maxsize << 3)
+	{
+		msg->overflowed = qtrue;
+		return;
+	}
+
+	out   = msg->data + (msg->bit >> 3);
+	shift = msg->bit & 7;
+	bytes = (src->bit + 7) >> 3;
+
+	if (!shift)
+	{
+		Com_Memcpy(out, in, bytes);
+	}
+	else
+	{
+		// keep the bits already written in the first byte, the unused bits of src are always 0
+		out[0] &= (1 << shift) - 1;
+		for (i = 0; i < bytes; i++)
+		{
+			out[i]    |= in[i] << shift;
+			out[i + 1] = in[i] >> (8 - shift);
+		}
+	}
+
+	msg->bit        += src->bit;
+	msg->cursize     = (msg->bit >> 3) + 1;
+	msg->uncompsize += src->uncompsize;
+}
+
 /*
 =============================================================================
 bit functions
@@ -102,6 +102,11 @@ static qboolean winsockInitialized = qfalse;
 #       include <sys/filio.h>
 #   endif
 
+#   ifdef __linux__
+#       include <sys/epoll.h>
+#       include <sys/timerfd.h>
+#   endif
+
 typedef int SOCKET;
 #   define INVALID_SOCKET       -1
 #   define SOCKET_ERROR         -1
@@ -152,6 +157,14 @@ static struct sockaddr_in6 boundto;
 #define NET_MULTICAST_IP6 "ff04::696f:7175:616b:6533"
 #endif
 
+#ifdef __linux__
+// epoll set over the game sockets and a timerfd used by NET_SleepPrecise,
+// rebuilt whenever NET_Config reopens the sockets
+static int      net_epollFd    = -1;
+static int      net_timerFd    = -1;
+static qboolean net_epollDirty = qtrue;
+#endif
+
 #ifndef IF_NAMESIZE
   #define IF_NAMESIZE 16
 #endif
@@ -960,6 +973,47 @@ void Sys_SendPacket(int length, const void *data, const netadr_t *to)
 	}
 }
 
+/**
+ * @brief Sends an IPv4 or IPv6 packet straight to the socket
+ *
+ * Can be used from other threads than the main one as it doesn't print
+ * anything and doesn't touch the socks relay buffer.
+ *
+ * @param[in] length
+ * @param[in] data
+ * @param[in] to
+ * @return qfalse if the packet couldn't be sent
+ */
+qboolean Sys_SendPacketQuiet(int length, const void *data, const netadr_t *to)
+{
+	struct sockaddr_storage addr;
+	SOCKET                  sock    = INVALID_SOCKET;
+	socklen_t               addrlen = 0;
+
+	if (to->type == NA_IP && !usingSocks)
+	{
+		sock    = ip_socket;
+		addrlen = sizeof(struct sockaddr_in);
+	}
+#ifdef FEATURE_IPV6
+	else if (to->type == NA_IP6)
+	{
+		sock    = ip6_socket;
+		addrlen = sizeof(struct sockaddr_in6);
+	}
+#endif
+
+	if (sock == INVALID_SOCKET)
+	{
+		return qfalse;
+	}
+
+	Com_Memset(&addr, 0, sizeof(addr));
+	NetadrToSockadr(to, (struct sockaddr *) &addr);
+
+	return sendto(sock, data, length, 0, (struct sockaddr *) &addr, addrlen) != SOCKET_ERROR;
+}
+
 //=============================================================================
 
 /**
@@ -1985,6 +2039,13 @@ static void NET_Config(qboolean enableNetworking)
 		networkingEnabled = enableNetworking;
 	}
 
+	// the query thread sends on the sockets and reads the local address
+	// table, it is restarted by the next SV_QueryFrame
+	if (stop || start)
+	{
+		SV_QueryShutdown();
+	}
+
 	if (stop)
 	{
 		if (ip_socket != INVALID_SOCKET)
@@ -2031,6 +2092,10 @@ static void NET_Config(qboolean enableNetworking)
 		}
 		Com_Printf("Network initialized\n");
 	}
+
+#ifdef __linux__
+	net_epollDirty = qtrue;
+#endif
 }
 
 /**
@@ -2082,6 +2147,19 @@ void NET_Shutdown(void)
 
 	NET_Config(qfalse);
 
+#ifdef __linux__
+	if (net_epollFd != -1)
+	{
+		close(net_epollFd);
+		net_epollFd = -1;
+	}
+	if (net_timerFd != -1)
+	{
+		close(net_timerFd);
+		net_timerFd = -1;
+	}
+#endif
+
 #ifdef _WIN32
 	WSACleanup();
 	winsockInitialized = qfalse;
@@ -2186,6 +2264,160 @@ void NET_Sleep(int msec)
 	}
 }
 
+#ifdef __linux__
+/**
+ * @brief Adds a socket to the epoll set of NET_SleepPrecise
+ * @param[in] sock
+ * @return qfalse on failure
+ */
+static qboolean NET_EpollAdd(int sock)
+{
+	struct epoll_event ev;
+
+	Com_Memset(&ev, 0, sizeof(ev));
+	ev.events  = EPOLLIN;
+	ev.data.fd = sock;
+
+	if (epoll_ctl(net_epollFd, EPOLL_CTL_ADD, sock, &ev) == -1)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: NET_EpollAdd: epoll_ctl failed: %s\n", strerror(errno));
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief (Re)creates the epoll set with the timer and the game sockets
+ * @return qfalse if precise sleeping is not available
+ */
+static qboolean NET_EpollSetup(void)
+{
+	if (net_timerFd == -1)
+	{
+		net_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+		if (net_timerFd == -1)
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: NET_EpollSetup: timerfd_create failed: %s\n", strerror(errno));
+			return qfalse;
+		}
+	}
+
+	// closed sockets drop out of the set on their own, reopened ones may reuse
+	// the same descriptor so simply start over with a fresh set
+	if (net_epollFd != -1)
+	{
+		close(net_epollFd);
+	}
+
+	net_epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+	if (net_epollFd == -1)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: NET_EpollSetup: epoll_create1 failed: %s\n", strerror(errno));
+		return qfalse;
+	}
+
+	if (!NET_EpollAdd(net_timerFd))
+	{
+		return qfalse;
+	}
+
+	if (ip_socket != INVALID_SOCKET && !NET_EpollAdd(ip_socket))
+	{
+		return qfalse;
+	}
+#ifdef FEATURE_IPV6
+	if (ip6_socket != INVALID_SOCKET && !NET_EpollAdd(ip6_socket))
+	{
+		return qfalse;
+	}
+#endif
+
+	net_epollDirty = qfalse;
+	return qtrue;
+}
+#endif
+
+/**
+ * @brief Sleeps usec microseconds or until something happens on the network
+ *
+ * Unlike NET_Sleep the timeout is not rounded to milliseconds, the deadline is
+ * armed on a timerfd and waited for with epoll together with the game sockets.
+ *
+ * @param[in] usec
+ * @return qfalse if precise sleeping is not available on this system,
+ * the caller has to fall back to NET_Sleep then
+ */
+qboolean NET_SleepPrecise(int usec)
+{
+#ifdef __linux__
+	struct epoll_event events[4];
+	struct itimerspec  timer;
+	fd_set             fdset;
+	uint64_t           expirations;
+	int                numEvents, i;
+	qboolean           havePackets = qfalse;
+
+	if (net_epollDirty && !NET_EpollSetup())
+	{
+		return qfalse;
+	}
+
+	if (usec > 0)
+	{
+		Com_Memset(&timer, 0, sizeof(timer));
+		timer.it_value.tv_sec  = usec / 1000000;
+		timer.it_value.tv_nsec = (usec % 1000000) * 1000;
+
+		if (timerfd_settime(net_timerFd, 0, &timer, NULL) == -1)
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: NET_SleepPrecise: timerfd_settime failed: %s\n", strerror(errno));
+			return qfalse;
+		}
+	}
+
+	numEvents = epoll_wait(net_epollFd, events, ARRAY_LEN(events), usec > 0 ? -1 : 0);
+
+	if (numEvents == -1)
+	{
+		if (errno != EINTR)
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: epoll_wait() syscall failed: %s\n", strerror(errno));
+		}
+		return qtrue;
+	}
+
+	FD_ZERO(&fdset);
+
+	for (i = 0; i < numEvents; i++)
+	{
+		if (events[i].data.fd == net_timerFd)
+		{
+			// drain it, a stale expiry would wake up the next wait right away
+			if (read(net_timerFd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
+			{
+				Com_Printf(S_COLOR_YELLOW "WARNING: NET_SleepPrecise: timerfd read failed: %s\n", strerror(errno));
+			}
+			continue;
+		}
+
+		FD_SET(events[i].data.fd, &fdset);
+		havePackets = qtrue;
+	}
+
+	if (havePackets)
+	{
+		NET_Event(&fdset);
+	}
+
+	return qtrue;
+#else
+	return qfalse;
+#endif
+}
+
 /**
  * @brief NET_Restart_f
  */
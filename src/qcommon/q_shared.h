@@ -1017,6 +1017,8 @@ typedef struct
 	char string[MAX_CVAR_VALUE_STRING];
 } vmCvar_t;
 
+#define MAX_CVAR_CHANGES    64  ///< cvar handles the modules ask for per trap_CvarChanges call
+
 /*
 ==============================================================
 COLLISION DETECTION
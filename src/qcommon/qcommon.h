@@ -74,6 +74,7 @@ void MSG_Uncompressed(msg_t *buf);
  * sets data buffer as MSG_Init does prior to do the copy
  */
 void MSG_Copy(msg_t *buf, byte *data, int length, msg_t *src);
+void MSG_WriteBitstream(msg_t *msg, const msg_t *src);
 
 struct usercmd_s;
 struct entityState_s;
@@ -234,6 +235,7 @@ const char *NET_AdrToStringNoPort(const netadr_t *a);
 int NET_StringToAdr(const char *s, netadr_t *a, netadrtype_t family);
 qboolean NET_GetLoopPacket(netsrc_t sock, netadr_t *net_from, msg_t *net_message);
 void NET_Sleep(int msec);
+qboolean NET_SleepPrecise(int usec);
 
 /**
  * @def MAX_MSGLEN
@@ -687,6 +689,9 @@ void Cvar_Register(vmCvar_t *vmCvar, const char *varName, const char *defaultVal
 void Cvar_Update(vmCvar_t *vmCvar);
 // updates an interpreted modules' version of a cvar
 
+int Cvar_Changes(int *sequence, int *handles, int maxHandles);
+// lists the cvars modified since the given point in the modification sequence
+
 void Cvar_Set(const char *varName, const char *value);
 // will create the variable with no flags if it doesn't exist
 
@@ -870,6 +875,9 @@ long FS_FOpenFileRead_Filtered(const char *qpath, fileHandle_t *file, qboolean u
 // returns 1 if a file is in the PAK file, otherwise -1
 int FS_FileIsInPAK(const char *fileName, int *pChecksum);
 
+// returns 1 if FS_ReadFile reads the file from a PAK file, 0 for a loose file, otherwise -1
+int FS_FileOrigin(const char *fileName, int *pChecksum);
+
 int FS_Delete(const char *fileName);
 
 int FS_Write(const void *buffer, int len, fileHandle_t h);
@@ -895,6 +903,9 @@ int FS_ReadFile(const char *qpath, void **buffer);
 void FS_ForceFlush(fileHandle_t f);
 // forces flush on files we're writing to.
 
+FILE *FS_FileForHandle(fileHandle_t f);
+// the stdio FILE of a file that isn't in a pk3, for writing from other threads
+
 void FS_FreeFile(void *buffer);
 // frees the memory returned by FS_ReadFile
 
@@ -1083,6 +1094,7 @@ extern cvar_t *com_journal;
 extern cvar_t *com_ansiColor;
 extern cvar_t *com_unfocused;
 extern cvar_t *com_minimized;
+extern cvar_t *com_preciseFrames;       // dedicated only, sleep on epoll + timerfd instead of select
 #if idppc
 extern cvar_t *com_altivec;
 #endif
@@ -1114,6 +1126,21 @@ extern int com_frameTime;
 extern int com_expectedhunkusage;
 extern int com_hunkusedvalue;
 
+/**
+ * @struct frameJitter_t
+ * @brief How late dedicated server frames started relative to their deadline
+ */
+typedef struct
+{
+	int frames;
+	int late;                           ///< frames started 1 msec or more too late
+	int stalls;                         ///< hitches such as map loads, not counted as jitter
+	int max;                            ///< usec
+	long long total;                    ///< usec
+} frameJitter_t;
+
+extern frameJitter_t com_frameJitter;
+
 extern qboolean com_errorEntered;
 
 extern cvar_t *com_masterServer;
@@ -1135,7 +1162,8 @@ typedef enum
 	TAG_BOTLIB,
 	TAG_RENDERER,
 	TAG_SMALL,
-	TAG_STATIC
+	TAG_STATIC,
+	TAG_SLAB        ///< zone block split into small blocks, internal to the zone allocator
 } memtag_t;
 
 /*
@@ -1312,6 +1340,8 @@ void SV_Init(void);
 void SV_Shutdown(const char *finalmsg);
 void SV_Frame(int msec);
 void SV_PacketEvent(const netadr_t *from, msg_t *msg);
+void SV_QueryShutdown(void);
+void SV_CL_AbortMessageQueue(void);
 qboolean SV_GameCommand(void);
 int SV_FrameMsec();
 int SV_SendQueuedPackets();
@@ -1397,6 +1427,9 @@ void Sys_Print(const char *msg);
 // Sys_Milliseconds should only be used for profiling purposes,
 // any game related timing information should come from event timestamps
 int Sys_Milliseconds(void);
+#ifndef _WIN32
+long long Sys_Microseconds(void);
+#endif
 
 int Sys_PID(void);
 qboolean Sys_WritePIDFile(void);
@@ -1404,10 +1437,25 @@ qboolean Sys_PIDIsRunning(unsigned int pid);
 
 void Sys_SnapVector(float *v);
 
+// threads, mutexes and counting semaphores for optional worker code,
+// the handles are opaque and NULL is returned when creation fails
+void *Sys_CreateThread(void (*function)(void *arg), void *arg);
+void Sys_JoinThread(void *thread);
+void *Sys_CreateMutex(void);
+void Sys_DestroyMutex(void *mutex);
+void Sys_LockMutex(void *mutex);
+void Sys_UnlockMutex(void *mutex);
+void *Sys_CreateSemaphore(int value);
+void Sys_DestroySemaphore(void *semaphore);
+void Sys_SemaphorePost(void *semaphore);
+void Sys_SemaphoreWait(void *semaphore);
+int Sys_NumCPUs(void);
+
 // the system console is shown when a dedicated server is running
 void Sys_DisplaySystemConsole(qboolean show);
 
 void Sys_SendPacket(int length, const void *data, const netadr_t *to);
+qboolean Sys_SendPacketQuiet(int length, const void *data, const netadr_t *to);
 
 qboolean Sys_StringToAdr(const char *s, netadr_t *a, netadrtype_t family);
 //Does NOT parse port numbers, only base addresses.
@@ -41,6 +41,10 @@
 
 #include "tr_local.h"
 
+#ifdef ETL_SSE
+#include <xmmintrin.h>
+#endif
+
 // undef to use floating-point lerping with explicit trig funcs
 #define YD_INGLES
 
@@ -83,9 +87,40 @@ static qboolean                 isTorso, fullTorso;
 static vec4_t                   m1[4], m2[4];
 static vec3_t                   t;
 static refEntity_t              lastBoneEntity;
+static int                      lastBoneCount, lastBoneFrame;
 
 static int totalrv, totalrt, totalv, totalt;
 
+#define BONECACHE_SIZE  16
+
+/**
+ * @struct boneCacheEntry_s
+ * @brief Bones built for one animation state during the current frame,
+ *        shared by all entities rendered in that state
+ */
+typedef struct boneCacheEntry_s
+{
+	refEntity_t entity;                         ///< animation state, see R_BonesStillValid
+	int frameCount;
+	int numBones;
+	vec3_t torsoParentOffset;
+	char validBones[MDX_MAX_BONES];
+	mdxBoneFrame_t rawBones[MDX_MAX_BONES];     ///< before torso rotation
+	mdxBoneFrame_t finalBones[MDX_MAX_BONES];
+} boneCacheEntry_t;
+
+static boneCacheEntry_t boneCache[BONECACHE_SIZE];
+static int              boneCacheNext;
+
+/// bone counters of the caller, tags built by the front end are not counted in backEnd.pc
+static backEndCounters_t *bonePc;
+static backEndCounters_t boneTagPc;
+
+#ifdef ETL_SSE
+/// bone matrix columns and translation of the referenced bones, for RB_MDM_SkinVertexes
+static float boneColumns[MDX_MAX_BONES][4][4];
+#endif
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -998,6 +1033,8 @@ static ID_INLINE void Matrix3Transpose(const vec3_t matrix[3], vec3_t transpose[
  */
 static void R_CalcBone(const int torsoParent, const refEntity_t *refent, int boneNum)
 {
+	bonePc->c_boneCalcs++;
+
 	thisBoneInfo = &boneInfo[boneNum];
 	if (thisBoneInfo->torsoWeight != 0.f)
 	{
@@ -1159,6 +1196,8 @@ static void R_CalcBoneLerp(const int torsoParent, const refEntity_t *refent, int
 		return;
 	}
 
+	bonePc->c_boneCalcs++;
+
 	thisBoneInfo = &boneInfo[boneNum];
 
 	if (!thisBoneInfo)
@@ -1440,6 +1479,7 @@ static void R_CalcBoneLerp(const int torsoParent, const refEntity_t *refent, int
 
 /**
  * @brief R_BonesStillValid
+ * @param[in] boneEntity entity the bones were built for
  * @param[in] refent
  * @return
  *
@@ -1449,59 +1489,59 @@ static void R_CalcBoneLerp(const int torsoParent, const refEntity_t *refent, int
  *
  * Another solution: bones cache on an entity basis?
  */
-static qboolean R_BonesStillValid(const refEntity_t *refent)
+static qboolean R_BonesStillValid(const refEntity_t *boneEntity, const refEntity_t *refent)
 {
-	if (lastBoneEntity.hModel != refent->hModel)
+	if (boneEntity->hModel != refent->hModel)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.frame != refent->frame)
+	else if (boneEntity->frame != refent->frame)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.oldframe != refent->oldframe)
+	else if (boneEntity->oldframe != refent->oldframe)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.frameModel != refent->frameModel)
+	else if (boneEntity->frameModel != refent->frameModel)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.oldframeModel != refent->oldframeModel)
+	else if (boneEntity->oldframeModel != refent->oldframeModel)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.backlerp != refent->backlerp)
+	else if (boneEntity->backlerp != refent->backlerp)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.torsoFrame != refent->torsoFrame)
+	else if (boneEntity->torsoFrame != refent->torsoFrame)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.oldTorsoFrame != refent->oldTorsoFrame)
+	else if (boneEntity->oldTorsoFrame != refent->oldTorsoFrame)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.torsoFrameModel != refent->torsoFrameModel)
+	else if (boneEntity->torsoFrameModel != refent->torsoFrameModel)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.oldTorsoFrameModel != refent->oldTorsoFrameModel)
+	else if (boneEntity->oldTorsoFrameModel != refent->oldTorsoFrameModel)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.torsoBacklerp != refent->torsoBacklerp)
+	else if (boneEntity->torsoBacklerp != refent->torsoBacklerp)
 	{
 		return qfalse;
 	}
-	else if (lastBoneEntity.reFlags != refent->reFlags)
+	else if (boneEntity->reFlags != refent->reFlags)
 	{
 		return qfalse;
 	}
-	else if (!VectorCompare(lastBoneEntity.torsoAxis[0], refent->torsoAxis[0]) ||
-	         !VectorCompare(lastBoneEntity.torsoAxis[1], refent->torsoAxis[1]) ||
-	         !VectorCompare(lastBoneEntity.torsoAxis[2], refent->torsoAxis[2]))
+	else if (!VectorCompare(boneEntity->torsoAxis[0], refent->torsoAxis[0]) ||
+	         !VectorCompare(boneEntity->torsoAxis[1], refent->torsoAxis[1]) ||
+	         !VectorCompare(boneEntity->torsoAxis[2], refent->torsoAxis[2]))
 	{
 		return qfalse;
 	}
@@ -1509,6 +1549,76 @@ static qboolean R_BonesStillValid(const refEntity_t *refent)
 	return qtrue;
 }
 
+/**
+ * @brief Keep the bones of the last entity in the bone cache
+ */
+static void R_StoreBoneCache(void)
+{
+	boneCacheEntry_t *entry = NULL;
+	int              i;
+
+	if (!lastBoneCount || lastBoneFrame != tr.frameCount)
+	{
+		return;
+	}
+
+	// update the entry the bones came from, they may have been completed
+	for (i = 0; i < BONECACHE_SIZE; i++)
+	{
+		if (boneCache[i].frameCount == lastBoneFrame && boneCache[i].numBones == lastBoneCount &&
+		    R_BonesStillValid(&boneCache[i].entity, &lastBoneEntity))
+		{
+			entry = &boneCache[i];
+			break;
+		}
+	}
+
+	if (!entry)
+	{
+		entry         = &boneCache[boneCacheNext];
+		boneCacheNext = (boneCacheNext + 1) % BONECACHE_SIZE;
+	}
+
+	entry->entity     = lastBoneEntity;
+	entry->frameCount = lastBoneFrame;
+	entry->numBones   = lastBoneCount;
+	VectorCopy(torsoParentOffset, entry->torsoParentOffset);
+	Com_Memcpy(entry->validBones, validBones, lastBoneCount);
+	Com_Memcpy(entry->rawBones, rawBones, sizeof(rawBones[0]) * lastBoneCount);
+	Com_Memcpy(entry->finalBones, oldBones, sizeof(oldBones[0]) * lastBoneCount);
+}
+
+/**
+ * @brief Start from the bones of another entity in the same animation state this frame
+ * @param[in] refent
+ * @param[in] numBones
+ * @return qfalse if there are none
+ */
+static qboolean R_RestoreBoneCache(const refEntity_t *refent, int numBones)
+{
+	boneCacheEntry_t *entry;
+	int              i;
+
+	for (i = 0; i < BONECACHE_SIZE; i++)
+	{
+		entry = &boneCache[i];
+
+		if (entry->frameCount != tr.frameCount || entry->numBones != numBones ||
+		    !R_BonesStillValid(&entry->entity, refent))
+		{
+			continue;
+		}
+
+		VectorCopy(entry->torsoParentOffset, torsoParentOffset);
+		Com_Memcpy(validBones, entry->validBones, numBones);
+		Com_Memcpy(rawBones, entry->rawBones, sizeof(rawBones[0]) * numBones);
+		Com_Memcpy(oldBones, entry->finalBones, sizeof(oldBones[0]) * numBones);
+		return qtrue;
+	}
+
+	return qfalse;
+}
+
 /**
  * @brief The list of bones[] should only be built and modified from within here
  * @param[in] refent
@@ -1531,11 +1641,23 @@ static void R_CalcBones(const refEntity_t *refent, int *boneList, int numBones)
 	}
 
 	// if the entity has changed since the last time the bones were built, reset them
-	if (!R_BonesStillValid(refent))
+	if (!R_BonesStillValid(&lastBoneEntity, refent))
 	{
-		// different, cached bones are not valid
-		Com_Memset(validBones, 0, mdxFrameHeader->numBones);
+		R_StoreBoneCache();
+
+		// different, cached bones are not valid unless another entity shares the state
+		if (R_RestoreBoneCache(refent, mdxFrameHeader->numBones))
+		{
+			bonePc->c_boneCacheHits++;
+		}
+		else
+		{
+			Com_Memset(validBones, 0, mdxFrameHeader->numBones);
+			bonePc->c_boneCacheMisses++;
+		}
 		lastBoneEntity = *refent;
+		lastBoneCount  = mdxFrameHeader->numBones;
+		lastBoneFrame  = tr.frameCount;
 
 		// also reset these counter statics
 		// print stats for the complete model (not per-surface)
@@ -1706,6 +1828,231 @@ static void R_CalcBones(const refEntity_t *refent, int *boneList, int numBones)
 	Com_Memcpy(oldBones, bones, sizeof(bones[0]) * mdxFrameHeader->numBones);
 }
 
+/**
+ * @brief Transform the vertexes of a surface by the current bones
+ * @param[in] surface
+ * @param[in] count number of vertexes to deform
+ */
+static void RB_MDM_SkinVertexes(mdmSurface_t *surface, int count)
+{
+	int         j, k;
+	mdmWeight_t *w;
+
+	v          = ( mdmVertex_t * )((byte *)surface + surface->ofsVerts);
+	tempVert   = ( float * )(tess.xyz + baseVertex);
+	tempNormal = ( float * )(tess.normal + baseVertex);
+	for (j = 0; j < count; j++, tempVert += 4, tempNormal += 4)
+	{
+		VectorClear(tempVert);
+
+		w = v->weights;
+		for (k = 0 ; k < v->numWeights ; k++, w++)
+		{
+			bone = &bones[w->boneIndex];
+			LocalAddScaledMatrixTransformVectorTranslate(w->offset, w->boneWeight, bone->matrix, bone->translation, tempVert);
+		}
+
+		LocalMatrixTransformVector(v->normal, bones[v->weights[0].boneIndex].matrix, tempNormal);
+
+		tess.texCoords[baseVertex + j][0][0] = v->texCoords[0];
+		tess.texCoords[baseVertex + j][0][1] = v->texCoords[1];
+
+		v = (mdmVertex_t *)&v->weights[v->numWeights];
+	}
+}
+
+#ifdef ETL_SSE
+/**
+ * @brief SSE version of RB_MDM_SkinVertexes
+ *
+ * Works on whole xyz vectors using the transposed bone matrices, in the same
+ * order of operations as the scalar code so the results are identical.
+ *
+ * Vertexes are done one at a time: their weight count varies, and a SoA layout
+ * of four vertexes has to gather and transpose the columns of four bones per
+ * weight, which costs more than it saves (see mdmskinbench).
+ *
+ * @param[in] surface
+ * @param[in] count number of vertexes to deform
+ */
+static void RB_MDM_SkinVertexesSSE(mdmSurface_t *surface, int count)
+{
+	int         j, k;
+	mdmWeight_t *w;
+	int         *boneList = ( int * )((byte *)surface + surface->ofsBoneReferences);
+	mdmVertex_t *vert;
+	float       *xyz, *normal;
+	vec2_t      (*texCoords)[2];
+	__m128      acc, r;
+	float       (*c)[4];
+
+	for (j = 0; j < surface->numBoneReferences; j++)
+	{
+		mdxBoneFrame_t *b = &bones[boneList[j]];
+
+		c = boneColumns[boneList[j]];
+		for (k = 0; k < 3; k++)
+		{
+			c[k][0] = b->matrix[0][k];
+			c[k][1] = b->matrix[1][k];
+			c[k][2] = b->matrix[2][k];
+			c[k][3] = 0.f;
+		}
+		c[3][0] = b->translation[0];
+		c[3][1] = b->translation[1];
+		c[3][2] = b->translation[2];
+		c[3][3] = 0.f;
+	}
+
+	// locals rather than the static pointers, the SSE stores may alias those
+	// and force a reload on every vertex
+	vert      = ( mdmVertex_t * )((byte *)surface + surface->ofsVerts);
+	xyz       = ( float * )(tess.xyz + baseVertex);
+	normal    = ( float * )(tess.normal + baseVertex);
+	texCoords = tess.texCoords + baseVertex;
+	for (j = 0; j < count; j++, xyz += 4, normal += 4)
+	{
+		acc = _mm_setzero_ps();
+		w   = vert->weights;
+		for (k = 0 ; k < vert->numWeights ; k++, w++)
+		{
+			c = boneColumns[w->boneIndex];
+
+			r   = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(w->offset[0]), _mm_loadu_ps(c[0])), _mm_mul_ps(_mm_set1_ps(w->offset[1]), _mm_loadu_ps(c[1])));
+			r   = _mm_add_ps(_mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(w->offset[2]), _mm_loadu_ps(c[2]))), _mm_loadu_ps(c[3]));
+			acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w->boneWeight), r));
+		}
+
+		// keep the 4th component of the tess arrays untouched
+		_mm_storel_pi((__m64 *)xyz, acc);
+		_mm_store_ss(xyz + 2, _mm_movehl_ps(acc, acc));
+
+		c = boneColumns[vert->weights[0].boneIndex];
+		r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(vert->normal[0]), _mm_loadu_ps(c[0])), _mm_mul_ps(_mm_set1_ps(vert->normal[1]), _mm_loadu_ps(c[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(vert->normal[2]), _mm_loadu_ps(c[2])));
+
+		_mm_storel_pi((__m64 *)normal, r);
+		_mm_store_ss(normal + 2, _mm_movehl_ps(r, r));
+
+		texCoords[j][0][0] = vert->texCoords[0];
+		texCoords[j][0][1] = vert->texCoords[1];
+
+		vert = (mdmVertex_t *)&vert->weights[vert->numWeights];
+	}
+}
+#endif
+
+/**
+ * @brief Skin the surfaces of all loaded MDM models with the scalar and the
+ *        SSE code and compare the results
+ *
+ * The bones get a fixed pose and are restored afterwards, the vertexes are
+ * written to the start of the tesselator arrays.
+ *
+ * Usage: mdmskinbench [passes]
+ */
+void R_MDM_SkinBench_f(void)
+{
+#ifdef ETL_SSE
+	static mdxBoneFrame_t savedBones[MDX_MAX_BONES];
+	static vec3_t         refXyz[SHADER_MAX_VERTEXES], refNormal[SHADER_MAX_VERTEXES];
+	int                   passes          = ri.Cmd_Argc() > 1 ? atoi(ri.Cmd_Argv(1)) : 1000;
+	int                   savedBaseVertex = baseVertex;
+	int                   i, j, n, pass, time, scalarTime = 0, sseTime = 0;
+	int                   numSurfaces = 0, numVertexes = 0, numWeights = 0, numMismatches = 0;
+	vec3_t                boneAngles;
+	model_t               *mod;
+	mdmHeader_t           *mdm;
+	mdmSurface_t          *surf;
+	mdmVertex_t           *vert;
+
+	if (passes < 1)
+	{
+		passes = 1;
+	}
+
+	// the back end owns the bones and the tesselator
+	R_SyncRenderThread();
+
+	Com_Memcpy(savedBones, bones, sizeof(bones));
+	for (i = 0; i < MDX_MAX_BONES; i++)
+	{
+		VectorSet(boneAngles, i * 7.f, i * 13.f, i * 3.f);
+		AnglesToAxis(boneAngles, bones[i].matrix);
+		VectorSet(bones[i].translation, i, -i, 2.f * i);
+	}
+	baseVertex = 0;
+
+	for (i = 1; i < tr.numModels; i++)
+	{
+		mod = tr.models[i];
+		if (mod->type != MOD_MDM)
+		{
+			continue;
+		}
+
+		mdm  = mod->model.mdm;
+		surf = ( mdmSurface_t * )((byte *)mdm + mdm->ofsSurfaces);
+		for (j = 0; j < mdm->numSurfaces; j++, surf = ( mdmSurface_t * )((byte *)surf + surf->ofsEnd))
+		{
+			numSurfaces++;
+			numVertexes += surf->numVerts;
+
+			vert = ( mdmVertex_t * )((byte *)surf + surf->ofsVerts);
+			for (n = 0; n < surf->numVerts; n++)
+			{
+				numWeights += vert->numWeights;
+				vert        = (mdmVertex_t *)&vert->weights[vert->numWeights];
+			}
+
+			time = ri.Milliseconds();
+			for (pass = 0; pass < passes; pass++)
+			{
+				RB_MDM_SkinVertexes(surf, surf->numVerts);
+			}
+			scalarTime += ri.Milliseconds() - time;
+
+			for (n = 0; n < surf->numVerts; n++)
+			{
+				VectorCopy(tess.xyz[n], refXyz[n]);
+				VectorCopy(tess.normal[n], refNormal[n]);
+			}
+
+			time = ri.Milliseconds();
+			for (pass = 0; pass < passes; pass++)
+			{
+				RB_MDM_SkinVertexesSSE(surf, surf->numVerts);
+			}
+			sseTime += ri.Milliseconds() - time;
+
+			for (n = 0; n < surf->numVerts; n++)
+			{
+				if (memcmp(tess.xyz[n], refXyz[n], sizeof(vec3_t)) || memcmp(tess.normal[n], refNormal[n], sizeof(vec3_t)))
+				{
+					numMismatches++;
+				}
+			}
+		}
+	}
+
+	baseVertex = savedBaseVertex;
+	Com_Memcpy(bones, savedBones, sizeof(bones));
+
+	if (!numVertexes)
+	{
+		Ren_Print("mdmskinbench: no MDM models loaded\n");
+		return;
+	}
+
+	Ren_Print("mdmskinbench: %i surfaces, %i vertexes, %.2f weights per vertex, %i passes\n", numSurfaces, numVertexes, (double)numWeights / numVertexes, passes);
+	Ren_Print("  scalar %i msec (%.2f ns/vertex)\n", scalarTime, scalarTime * 1000000.0 / passes / numVertexes);
+	Ren_Print("  SSE    %i msec (%.2f ns/vertex)\n", sseTime, sseTime * 1000000.0 / passes / numVertexes);
+	Ren_Print("  %i vertexes differ\n", numMismatches);
+#else
+	Ren_Print("mdmskinbench: built without SSE, there is only the scalar code\n");
+#endif
+}
+
 #ifdef DBG_PROFILE_BONES
 #define DBG_SHOWTIME    Ren_Print("%i: %i, ", di++, (dt = ri.Milliseconds()) - ldt); ldt = dt;
 #else
@@ -1713,12 +2060,12 @@ static void R_CalcBones(const refEntity_t *refent, int *boneList, int numBones)
 #endif
 
 /**
- * @brief RB_MDM_SurfaceAnim
+ * @brief RB_MDM_DoSurfaceAnim
  * @param[in] surface
  */
-void RB_MDM_SurfaceAnim(mdmSurface_t *surface)
+static void RB_MDM_DoSurfaceAnim(mdmSurface_t *surface)
 {
-	int         j, k;
+	int         j;
 	refEntity_t *refent   = &backEnd.currentEntity->e;
 	int         *boneList = ( int * )((byte *)surface + surface->ofsBoneReferences);
 	mdmHeader_t *header   = ( mdmHeader_t * )((byte *)surface + surface->ofsHeader);
@@ -1854,30 +2201,12 @@ void RB_MDM_SurfaceAnim(mdmSurface_t *surface)
 //DBG_SHOWTIME
 
 	// deform the vertexes by the lerped bones
-	numVerts   = surface->numVerts;
-	v          = ( mdmVertex_t * )((byte *)surface + surface->ofsVerts);
-	tempVert   = ( float * )(tess.xyz + baseVertex);
-	tempNormal = ( float * )(tess.normal + baseVertex);
-	for (j = 0; j < render_count; j++, tempVert += 4, tempNormal += 4)
-	{
-		mdmWeight_t *w;
-
-		VectorClear(tempVert);
-
-		w = v->weights;
-		for (k = 0 ; k < v->numWeights ; k++, w++)
-		{
-			bone = &bones[w->boneIndex];
-			LocalAddScaledMatrixTransformVectorTranslate(w->offset, w->boneWeight, bone->matrix, bone->translation, tempVert);
-		}
-
-		LocalMatrixTransformVector(v->normal, bones[v->weights[0].boneIndex].matrix, tempNormal);
-
-		tess.texCoords[baseVertex + j][0][0] = v->texCoords[0];
-		tess.texCoords[baseVertex + j][0][1] = v->texCoords[1];
-
-		v = (mdmVertex_t *)&v->weights[v->numWeights];
-	}
+	numVerts = surface->numVerts;
+#ifdef ETL_SSE
+	RB_MDM_SkinVertexesSSE(surface, render_count);
+#else
+	RB_MDM_SkinVertexes(surface, render_count);
+#endif
 
 	DBG_SHOWTIME
 
@@ -2171,6 +2500,18 @@ void RB_MDM_SurfaceAnim(mdmSurface_t *surface)
 #endif
 }
 
+/**
+ * @brief RB_MDM_SurfaceAnim
+ * @param[in] surface
+ */
+void RB_MDM_SurfaceAnim(mdmSurface_t *surface)
+{
+	R_LockBones();
+	bonePc = &backEnd.pc;
+	RB_MDM_DoSurfaceAnim(surface);
+	R_UnlockBones();
+}
+
 /**
  * @brief R_MDM_GetBoneTag
  * @param[out] outTag
@@ -2218,7 +2559,10 @@ int R_MDM_GetBoneTag(orientation_t *outTag, mdmHeader_t *mdm, int startTagIndex,
 		return -1;
 	}
 
-	// calc the bones
+	// calc the bones, the render thread may be using them
+	R_LockBones();
+	bonePc = &boneTagPc;
+
 	boneList = ( int * )((byte *)pTag + pTag->ofsBoneReferences);
 	R_CalcBones(refent, boneList, pTag->numBoneReferences);
 
@@ -2230,5 +2574,7 @@ int R_MDM_GetBoneTag(orientation_t *outTag, mdmHeader_t *mdm, int startTagIndex,
 	{
 		LocalMatrixTransformVector(pTag->axis[j], bone->matrix, outTag->axis[j]);
 	}
+
+	R_UnlockBones();
 	return i;
 }
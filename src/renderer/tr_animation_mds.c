@@ -1480,10 +1480,10 @@ void R_CalcBones(mdsHeader_t *header, const refEntity_t *refent, int *boneList,
 #endif
 
 /**
- * @brief RB_SurfaceAnim
+ * @brief RB_DoSurfaceAnim
  * @param[in] surface
  */
-void RB_SurfaceAnim(mdsSurface_t *surface)
+static void RB_DoSurfaceAnim(mdsSurface_t *surface)
 {
 	int         j, k;
 	refEntity_t *refent;
@@ -1740,6 +1740,17 @@ void RB_SurfaceAnim(mdsSurface_t *surface)
 #endif
 }
 
+/**
+ * @brief RB_SurfaceAnim
+ * @param[in] surface
+ */
+void RB_SurfaceAnim(mdsSurface_t *surface)
+{
+	R_LockBones();
+	RB_DoSurfaceAnim(surface);
+	R_UnlockBones();
+}
+
 /**
  * @brief R_RecursiveBoneListAdd
  * @param[in] bi
@@ -1809,7 +1820,8 @@ int R_GetBoneTag(orientation_t *outTag, mdsHeader_t *mds, int startTagIndex, con
 
 	R_RecursiveBoneListAdd(pTag->boneIndex, boneList, &numBones, boneInfoList);
 
-	// calc the bones
+	// calc the bones, the render thread may be using them
+	R_LockBones();
 
 	R_CalcBones((mdsHeader_t *)mds, refent, boneList, numBones);
 
@@ -1818,6 +1830,8 @@ int R_GetBoneTag(orientation_t *outTag, mdsHeader_t *mds, int startTagIndex, con
 	Com_Memcpy(outTag->axis, bones[pTag->boneIndex].matrix, sizeof(outTag->axis));
 	VectorCopy(bones[pTag->boneIndex].translation, outTag->origin);
 
+	R_UnlockBones();
+
 /* code not functional, not in backend
     if (r_bonesDebug->integer == 4) {
         int j;
@@ -34,7 +34,7 @@
 
 #include "tr_local.h"
 
-backEndData_t  *backEndData;
+backEndData_t  *backEndData[SMP_FRAMES];
 backEndState_t backEnd;
 
 /**
@@ -1298,6 +1298,10 @@ const void *RB_DrawBuffer(const void *data)
 {
 	const drawBufferCommand_t *cmd = ( const drawBufferCommand_t * ) data;
 
+	// done here rather than in RE_BeginFrame, the front end must not touch GL with r_smp
+	R_ClearHudFBO();
+	R_BindMainFBO();
+
 	if (tr.useFBO)
 	{
 		return ( const void * ) (cmd + 1);
@@ -1500,7 +1504,18 @@ const void *RB_SwapBuffers(const void *data)
 
 	Ren_LogComment("***************** RB_SwapBuffers *****************\n\n\n");
 
-	ri.GLimp_SwapFrame();
+	if (backEnd.smpActive)
+	{
+		// the window itself is looked after by the main thread in RE_EndFrame
+		if (Q_stricmp(r_drawBuffer->string, "GL_FRONT"))
+		{
+			ri.GLimp_SwapWindow();
+		}
+	}
+	else
+	{
+		ri.GLimp_SwapFrame();
+	}
 
 	backEnd.projection2D = qfalse;
 
@@ -1554,6 +1569,17 @@ void RB_ExecuteRenderCommands(const void *data)
 
 	t1 = ri.Milliseconds();
 
+	// per surface state written by the front end is indexed by this,
+	// the front end is filling the other backEndData meanwhile with r_smp
+	if (data == backEndData[0]->commands.cmds)
+	{
+		backEnd.smpFrame = 0;
+	}
+	else
+	{
+		backEnd.smpFrame = 1;
+	}
+
 	while (1)
 	{
 		data = PADP(data, sizeof(intptr_t));
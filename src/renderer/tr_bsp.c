@@ -1922,6 +1922,11 @@ static void R_LoadSurfaces(lump_t *surfs, lump_t *verts, lump_t *indexLump)
 	s_worldData.surfaces    = out;
 	s_worldData.numsurfaces = count;
 
+	if (R_NumJobThreads())
+	{
+		s_worldData.surfRefs = ri.Hunk_Alloc(count * sizeof(*s_worldData.surfRefs), h_low);
+	}
+
 	// init the surface memory. This is optimization, so we don't have to
 	// look for memory for each surface, we allocate a big block and just chew it up
 	// as we go
@@ -2686,7 +2691,10 @@ void RE_LoadWorldMap(const char *name)
 	Ren_UpdateScreen();
 	//% R_LoadFogs( &header->lumps[LUMP_FOGS], &header->lumps[LUMP_BRUSHES], &header->lumps[LUMP_BRUSHSIDES] );
 	//% Ren_UpdateScreen();
+	// the surface shaders find most of the map textures, decode them in parallel
+	R_BeginImageBatch();
 	R_LoadSurfaces(&header->lumps[LUMP_SURFACES], &header->lumps[LUMP_DRAWVERTS], &header->lumps[LUMP_DRAWINDEXES]);
+	R_EndImageBatch();
 	Ren_UpdateScreen();
 	R_LoadMarksurfaces(&header->lumps[LUMP_LEAFSURFACES]);
 	Ren_UpdateScreen();
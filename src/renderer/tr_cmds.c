@@ -34,6 +34,243 @@
 
 #include "tr_local.h"
 
+/**
+ * @struct renderThread_t
+ * @brief The r_smp render thread
+ *
+ * The back end of frame N runs on this thread while the front end builds
+ * frame N + 1 into the other backEndData. The GL context follows the work:
+ * it is moved back to the main thread by R_SyncRenderThread whenever the
+ * front end has to touch GL itself (image uploads, shader sorting, level shots)
+ * and taken again by the render thread with the next command list.
+ */
+typedef struct
+{
+	void *thread;
+	void *wake;                     ///< main -> render thread: new command list, context release or quit
+	void *idle;                     ///< render thread -> main: request done
+	void *boneMutex;                ///< MDS/MDM bone scratch and cache, see R_LockBones
+
+	const void *commands;           ///< command list to execute
+	qboolean releaseContext;        ///< give the GL context back instead of executing commands
+	qboolean quit;
+
+	// only touched by the main thread
+	qboolean busy;                  ///< a request is in flight
+	qboolean mainOwnsContext;
+	qboolean syncAfterIssue;        ///< wait for the next command list right away
+
+	int backEndMsec;                ///< back end time of the last frame, for RE_EndFrame
+	int frames;                     ///< r_speeds 1 report, since the last report
+	int totalBackEndMsec;
+	int totalWaitMsec;
+
+	// only touched by the render thread
+	qboolean threadOwnsContext;
+} renderThread_t;
+
+static renderThread_t renderThread;
+
+/**
+ * @brief R_RenderThread
+ * @param arg - unused
+ */
+static void R_RenderThread(void *arg)
+{
+	while (1)
+	{
+		ri.Sys_SemaphoreWait(renderThread.wake);
+
+		if (renderThread.quit || renderThread.releaseContext)
+		{
+			if (renderThread.threadOwnsContext)
+			{
+				ri.GLimp_MakeCurrent(qfalse);
+				renderThread.threadOwnsContext = qfalse;
+			}
+
+			ri.Sys_SemaphorePost(renderThread.idle);
+
+			if (renderThread.quit)
+			{
+				return;
+			}
+			continue;
+		}
+
+		if (!renderThread.threadOwnsContext)
+		{
+			ri.GLimp_MakeCurrent(qtrue);
+			renderThread.threadOwnsContext = qtrue;
+		}
+
+		backEnd.smpActive = qtrue;
+		RB_ExecuteRenderCommands(renderThread.commands);
+
+		ri.Sys_SemaphorePost(renderThread.idle);
+	}
+}
+
+/**
+ * @brief Waits for the request in flight, if any
+ */
+static void R_WaitRenderThread(void)
+{
+	int start;
+
+	if (!renderThread.busy)
+	{
+		return;
+	}
+
+	start = ri.Milliseconds();
+	ri.Sys_SemaphoreWait(renderThread.idle);
+	renderThread.totalWaitMsec += ri.Milliseconds() - start;
+
+	renderThread.busy = qfalse;
+}
+
+/**
+ * @brief Starts the render thread when r_smp is set, the calling thread
+ * must own the GL context
+ */
+void R_InitRenderThread(void)
+{
+	R_ShutdownRenderThread();
+
+	if (!r_smp->integer)
+	{
+		return;
+	}
+
+	if (ri.Sys_NumCPUs() < 2)
+	{
+		Ren_Print("R_InitRenderThread: single processor, r_smp disabled\n");
+		return;
+	}
+
+	renderThread.wake = ri.Sys_CreateSemaphore(0);
+	renderThread.idle = ri.Sys_CreateSemaphore(0);
+
+	renderThread.boneMutex = ri.Sys_CreateMutex();
+
+	if (!renderThread.wake || !renderThread.idle || !renderThread.boneMutex)
+	{
+		Ren_Warning("R_InitRenderThread: failed to create synchronization objects\n");
+		R_ShutdownRenderThread();
+		return;
+	}
+
+	renderThread.mainOwnsContext = qtrue;
+
+	// the context is taken by the render thread with the first command list
+	renderThread.thread = ri.Sys_CreateThread(R_RenderThread, NULL);
+	if (!renderThread.thread)
+	{
+		Ren_Warning("R_InitRenderThread: failed to create render thread\n");
+		R_ShutdownRenderThread();
+		return;
+	}
+
+	Ren_Print("Render thread started\n");
+}
+
+/**
+ * @brief Stops the render thread and leaves the GL context on the calling thread
+ */
+void R_ShutdownRenderThread(void)
+{
+	if (renderThread.thread)
+	{
+		R_SyncRenderThread();
+
+		renderThread.quit = qtrue;
+		ri.Sys_SemaphorePost(renderThread.wake);
+		ri.Sys_JoinThread(renderThread.thread);
+	}
+
+	if (renderThread.wake)
+	{
+		ri.Sys_DestroySemaphore(renderThread.wake);
+	}
+	if (renderThread.idle)
+	{
+		ri.Sys_DestroySemaphore(renderThread.idle);
+	}
+	if (renderThread.boneMutex)
+	{
+		ri.Sys_DestroyMutex(renderThread.boneMutex);
+	}
+
+	Com_Memset(&renderThread, 0, sizeof(renderThread));
+	backEnd.smpActive = qfalse;
+}
+
+/**
+ * @brief Takes the bone state of the animation code
+ *
+ * The MDS/MDM bones are built into file statics by the back end and by
+ * R_LerpTag on the front end, which run at the same time with r_smp.
+ */
+void R_LockBones(void)
+{
+	if (renderThread.thread)
+	{
+		ri.Sys_LockMutex(renderThread.boneMutex);
+	}
+}
+
+/**
+ * @brief Releases the bone state taken by R_LockBones
+ */
+void R_UnlockBones(void)
+{
+	if (renderThread.thread)
+	{
+		ri.Sys_UnlockMutex(renderThread.boneMutex);
+	}
+}
+
+/**
+ * @brief Waits for the render thread to go idle and moves the GL context
+ * to the calling (main) thread, so the front end may issue OpenGL calls
+ *
+ * @note Commands still queued in the current frame are not executed, see
+ * R_IssuePendingRenderCommands
+ */
+void R_SyncRenderThread(void)
+{
+	if (!renderThread.thread)
+	{
+		return;
+	}
+
+	R_WaitRenderThread();
+
+	if (renderThread.mainOwnsContext)
+	{
+		return;
+	}
+
+	renderThread.releaseContext = qtrue;
+	renderThread.busy           = qtrue;
+	ri.Sys_SemaphorePost(renderThread.wake);
+	R_WaitRenderThread();
+	renderThread.releaseContext = qfalse;
+
+	ri.GLimp_MakeCurrent(qtrue);
+	renderThread.mainOwnsContext = qtrue;
+}
+
+/**
+ * @brief Makes the next R_IssueRenderCommands wait for the render thread,
+ * for commands whose data the front end reuses or reads back right away
+ */
+void R_SyncRenderThreadAfterIssue(void)
+{
+	renderThread.syncAfterIssue = qtrue;
+}
+
 /**
  * @brief R_PerformanceCounters
  */
@@ -44,6 +281,9 @@ void R_PerformanceCounters(void)
 		// clear the counters even if we aren't printing
 		Com_Memset(&tr.pc, 0, sizeof(tr.pc));
 		Com_Memset(&backEnd.pc, 0, sizeof(backEnd.pc));
+		renderThread.frames           = 0;
+		renderThread.totalBackEndMsec = 0;
+		renderThread.totalWaitMsec    = 0;
 		return;
 	}
 
@@ -54,6 +294,18 @@ void R_PerformanceCounters(void)
 		          backEnd.pc.c_shaders, backEnd.pc.c_surfaces, tr.pc.c_leafs, backEnd.pc.c_vertexes,
 		          backEnd.pc.c_indexes / 3, backEnd.pc.c_totalIndexes / 3,
 		          R_SumOfUsedImages() / (1000000.0), (double)backEnd.pc.c_overDraw / (double)(glConfig.vidWidth * glConfig.vidHeight));
+		Ren_Print("%i bones built, bone cache %i hits %i misses\n",
+		          backEnd.pc.c_boneCalcs, backEnd.pc.c_boneCacheHits, backEnd.pc.c_boneCacheMisses);
+		if (renderThread.thread && renderThread.frames)
+		{
+			// whatever the front end did not spend waiting ran in parallel with the back end
+			int overlap = renderThread.totalBackEndMsec - renderThread.totalWaitMsec;
+
+			Ren_Print("smp: %.2f msec back end %.2f msec waited %i%% overlapped\n",
+			          renderThread.totalBackEndMsec / (double)renderThread.frames,
+			          renderThread.totalWaitMsec / (double)renderThread.frames,
+			          renderThread.totalBackEndMsec ? MAX(overlap, 0) * 100 / renderThread.totalBackEndMsec : 0);
+		}
 		break;
 	case RSPEEDS_CULLING:
 		Ren_Print("(patch) %i sin %i sclip  %i sout %i bin %i bclip %i bout\n",
@@ -89,6 +341,10 @@ void R_PerformanceCounters(void)
 
 	Com_Memset(&tr.pc, 0, sizeof(tr.pc));
 	Com_Memset(&backEnd.pc, 0, sizeof(backEnd.pc));
+
+	renderThread.frames           = 0;
+	renderThread.totalBackEndMsec = 0;
+	renderThread.totalWaitMsec    = 0;
 }
 
 /**
@@ -97,7 +353,7 @@ void R_PerformanceCounters(void)
  */
 void R_IssueRenderCommands(qboolean runPerformanceCounters)
 {
-	renderCommandList_t *cmdList = &backEndData->commands;
+	renderCommandList_t *cmdList = &backEndData[tr.smpFrame]->commands;
 
 	etl_assert(cmdList != NULL);
 	// add an end-of-list command
@@ -106,6 +362,19 @@ void R_IssueRenderCommands(qboolean runPerformanceCounters)
 	// clear it out, in case this is a sync and not a buffer flip
 	cmdList->used = 0;
 
+	if (renderThread.thread)
+	{
+		// wait for the previous list, the thread runs one at a time
+		R_WaitRenderThread();
+
+		if (runPerformanceCounters)
+		{
+			renderThread.backEndMsec       = backEnd.pc.msec;
+			renderThread.totalBackEndMsec += backEnd.pc.msec;
+			renderThread.frames++;
+		}
+	}
+
 	// at this point, the back end thread is idle, so it is ok
 	// to look at its performance counters
 	if (runPerformanceCounters)
@@ -116,9 +385,32 @@ void R_IssueRenderCommands(qboolean runPerformanceCounters)
 	// actually start the commands going
 	if (!r_skipBackEnd->integer)
 	{
-		// let it start on the new batch
-		RB_ExecuteRenderCommands(cmdList->cmds);
+		if (renderThread.thread)
+		{
+			if (renderThread.mainOwnsContext)
+			{
+				ri.GLimp_MakeCurrent(qfalse);
+				renderThread.mainOwnsContext = qfalse;
+			}
+
+			// let it start on the new batch
+			renderThread.commands = cmdList->cmds;
+			renderThread.busy     = qtrue;
+			ri.Sys_SemaphorePost(renderThread.wake);
+
+			if (renderThread.syncAfterIssue)
+			{
+				R_WaitRenderThread();
+			}
+		}
+		else
+		{
+			// let it start on the new batch
+			RB_ExecuteRenderCommands(cmdList->cmds);
+		}
 	}
+
+	renderThread.syncAfterIssue = qfalse;
 }
 
 /**
@@ -134,6 +426,7 @@ void R_IssuePendingRenderCommands(void)
 		return;
 	}
 	R_IssueRenderCommands(qfalse);
+	R_SyncRenderThread();
 }
 
 /**
@@ -146,7 +439,7 @@ void R_IssuePendingRenderCommands(void)
 void *R_GetCommandBuffer(int bytes)
 {
 	static size_t       reserved_space = PAD(sizeof(swapBuffersCommand_t), sizeof(intptr_t)) + sizeof(int);
-	renderCommandList_t *cmdList       = &backEndData->commands;
+	renderCommandList_t *cmdList       = &backEndData[tr.smpFrame]->commands;
 	etl_assert(cmdList != NULL);
 	etl_assert(bytes > 0);
 	bytes = PAD(bytes, sizeof(intptr_t));
@@ -276,7 +569,7 @@ void RE_2DPolyies(polyVert_t *verts, int numverts, qhandle_t hShader)
 	}
 
 	cmd->commandId = RC_2DPOLYS;
-	cmd->verts     = &backEndData->polyVerts[r_numpolyverts];
+	cmd->verts     = &backEndData[tr.smpFrame]->polyVerts[r_numpolyverts];
 	cmd->numverts  = numverts;
 	Com_Memcpy(cmd->verts, verts, sizeof(polyVert_t) * numverts);
 	cmd->shader = R_GetShaderByHandle(hShader);
@@ -452,9 +745,6 @@ void RE_BeginFrame(void)
 	tr.frameCount++;
 	tr.frameSceneNum = 0;
 
-	R_ClearHudFBO();
-	R_BindMainFBO();
-
 	// do overdraw measurement
 	if (r_measureOverdraw->integer)
 	{
@@ -507,8 +797,11 @@ void RE_BeginFrame(void)
 		R_SetColorMappings();
 	}
 
-	// check for errors
-	GL_CheckErrors();
+	// check for errors, the render thread checks its own
+	if (!renderThread.thread)
+	{
+		GL_CheckErrors();
+	}
 
 	// draw buffer stuff
 	cmd = R_GetCommandBuffer(sizeof(*cmd));
@@ -542,8 +835,19 @@ void RE_EndFrame(int *frontEndMsec, int *backEndMsec)
 		return;
 	}
 
+	if (renderThread.thread)
+	{
+		// the render thread only swaps, the rest of the window upkeep is done
+		// here while it sits between two frames
+		R_WaitRenderThread();
+		ri.GLimp_UpdateWindow();
+	}
+
+	// the back end is idle and won't unmap the frame under the client
+	R_WriteVideoFrame();
+
 	// Needs to use reserved space, so no R_GetCommandBuffer.
-	cmdList = &backEndData->commands;
+	cmdList = &backEndData[tr.smpFrame]->commands;
 	etl_assert(cmdList != NULL);
 	// add swap-buffers command
 	*( int * )(cmdList->cmds + cmdList->used) = RC_SWAP_BUFFERS;
@@ -555,11 +859,28 @@ void RE_EndFrame(int *frontEndMsec, int *backEndMsec)
 	// may still be rendering into the current ones
 	R_InitNextFrame();
 
+	// without the render thread, or synced for a frame read into the capture buffer
+	if (!renderThread.busy)
+	{
+		R_WriteVideoFrame();
+	}
+
 	if (frontEndMsec)
 	{
 		*frontEndMsec = tr.frontEndMsec;
 	}
 	tr.frontEndMsec = 0;
+
+	if (renderThread.thread)
+	{
+		// the frame just issued is still running, report the previous one
+		if (backEndMsec)
+		{
+			*backEndMsec = renderThread.backEndMsec;
+		}
+		return;
+	}
+
 	if (backEndMsec)
 	{
 		*backEndMsec = backEnd.pc.msec;
@@ -648,4 +969,13 @@ void RE_TakeVideoFrame(int width, int height,
 	cmd->captureBuffer = captureBuffer;
 	cmd->encodeBuffer  = encodeBuffer;
 	cmd->motionJpeg    = motionJpeg;
+
+	R_RequestVideoFrame(width, height, captureBuffer);
+
+	// without pbos the back end reads into the capture buffer, which the client
+	// frees when the recording stops
+	if (!GLEW_ARB_pixel_buffer_object)
+	{
+		R_SyncRenderThreadAfterIssue();
+	}
 }
@@ -311,7 +311,7 @@ void RE_ProjectDecal(qhandle_t hShader, int numPoints, vec3_t *points, vec4_t pr
 	}
 
 	// create a new projector
-	dp = &backEndData->decalProjectors[r_numDecalProjectors];
+	dp = &backEndData[tr.smpFrame]->decalProjectors[r_numDecalProjectors];
 	Com_Memcpy(dp, &temp, sizeof(*dp));
 	dp->projectorNum = totalProjectors++;
 
@@ -964,7 +964,7 @@ void R_AddDecalSurface(decal_t *decal)
 	if (decal->parent != NULL)
 	{
 		gen       = (srfGeneric_t *) decal->parent->data;
-		dlightMap = (gen->dlightBits != 0);
+		dlightMap = (gen->dlightBits[tr.smpFrame] != 0);
 	}
 	else
 	{
@@ -34,8 +34,13 @@
 
 #include "tr_local.h"
 
+#ifdef ETL_SSE
+#include <emmintrin.h>
+#endif
+
 static byte          s_intensitytable[256];
 static unsigned char s_gammatable[256];
+static byte          s_gammaintensitytable[256];   ///< s_gammatable[s_intensitytable[i]]
 
 int gl_filter_min = GL_LINEAR_MIPMAP_NEAREST;
 int gl_filter_max = GL_LINEAR;
@@ -44,6 +49,96 @@ int gl_filter_max = GL_LINEAR;
 static image_t *hashTable[FILE_HASH_SIZE];
 #define generateHashValue(fname) Q_GenerateHashValue(fname, FILE_HASH_SIZE, qfalse, qtrue);
 
+// on-disk cache of the final mip chains of images loaded from pk3 files
+#define IMAGECACHE_IDENT    (('C' << 24) + ('I' << 16) + ('T' << 8) + 'E')
+#define IMAGECACHE_VERSION  1
+#define IMAGECACHE_KEY_SIZE 256
+
+/**
+ * @struct imageCacheHeader_s
+ * @brief Header of an image cache file, followed by numLevels times
+ *        width, height and width * height RGBA texels
+ */
+typedef struct imageCacheHeader_s
+{
+	int ident;
+	int version;
+	char key[IMAGECACHE_KEY_SIZE];      ///< source file, pk3 checksum and upload settings
+	int width, height;                  ///< size of the source image
+	int uploadWidth, uploadHeight;
+	int internalFormat;
+	int numLevels;
+	int buildMsec;                      ///< time it took to decode and mip the source
+} imageCacheHeader_t;
+
+/**
+ * @struct imageCacheRecord_s
+ * @brief A file in the image cache, r_imageCacheSize evicts the least recently used first
+ */
+typedef struct imageCacheRecord_s
+{
+	unsigned int hash;                  ///< file name, see R_ImageCacheKey
+	int size;
+	int lastUse;                        ///< 0 for records not used since R_IndexImageCache
+} imageCacheRecord_t;
+
+static struct
+{
+	qboolean recording;                 ///< Upload32 appends its mip levels to buffer
+	byte *buffer;
+	int size;
+	int capacity;
+	int numLevels;
+
+	const imageCacheHeader_t *read;     ///< R_CreateImage uploads from this record
+
+	imageCacheRecord_t *records;        ///< files in imagecache/, see R_IndexImageCache
+	int numRecords;
+	int maxRecords;
+	int totalSize;
+	int useCount;
+	qboolean indexed;
+
+	int hits;
+	int misses;
+	int msecSaved;
+} imageCache;
+
+// images requested while a batch is open are read from disk right away,
+// decoded on the job threads and uploaded in request order by R_FlushImageBatch
+#define MAX_PENDING_IMAGES  32
+
+/**
+ * @struct pendingImage_t
+ * @brief Image waiting in the batch to be decoded and uploaded
+ */
+typedef struct
+{
+	image_t *image;
+	char path[MAX_QPATH];               ///< file found for the image
+	imageData_t data;                   ///< file contents, a Com_Allocate copy
+	qboolean (*ImageLoader)(imageData_t *data, byte **pic, int *width, int *height, byte alphaByte);
+	int allowCompress;                  ///< tr.allowCompress when the image was requested
+
+	byte *pic;                          ///< decoded by a job, NULL if it is decoded on the main thread
+	int width, height;
+	int decodeMsec;
+
+	qboolean cacheImage;
+	char cacheKey[IMAGECACHE_KEY_SIZE];
+	char cachePath[MAX_QPATH];
+} pendingImage_t;
+
+static struct
+{
+	qboolean active;                    ///< R_FindImageFile queues images, see R_BeginImageBatch
+	int numPending;
+	pendingImage_t pending[MAX_PENDING_IMAGES];
+
+	int numImages;
+	int numJobDecoded;
+} imageBatch;
+
 // in order to prevent zone fragmentation, all images will
 // be read into this buffer. In order to keep things as fast as possible,
 // we'll give it a starting value, which will account for the majority of
@@ -105,6 +200,13 @@ void R_FreeImageBuffer(void)
 		imageBufferSize[bufferType] = 0;
 		imageBufferPtr[bufferType]  = NULL;
 	}
+
+	if (imageCache.buffer)
+	{
+		Com_Dealloc(imageCache.buffer);
+		imageCache.buffer   = NULL;
+		imageCache.capacity = 0;
+	}
 }
 
 /**
@@ -274,7 +376,15 @@ void R_ImageList_f(void)
 	}
 	Ren_Print(" ---------\n");
 	Ren_Print(" %i total texels (not including mipmaps)\n", texels);
-	Ren_Print(" %i total images\n\n", tr.numImages);
+	Ren_Print(" %i total images\n", tr.numImages);
+	if (r_imageCache->integer)
+	{
+		Ren_Print(" image cache: %i hits, %i misses (%.1f%% hit rate), %i msec saved\n",
+		          imageCache.hits, imageCache.misses,
+		          imageCache.hits + imageCache.misses ? 100.f * imageCache.hits / (imageCache.hits + imageCache.misses) : 0.f,
+		          imageCache.msecSaved);
+	}
+	Ren_Print("\n");
 }
 
 //=======================================================================
@@ -336,14 +446,29 @@ static void ResampleTexture(unsigned *in, int inwidth, int inheight, unsigned *o
 		//frac   = fracstep >> 1;   // FIXME: never read
 		for (j = 0 ; j < outwidth ; j++)
 		{
-			pix1                   = (byte *)inrow + p1[j];
-			pix2                   = (byte *)inrow + p2[j];
-			pix3                   = (byte *)inrow2 + p1[j];
-			pix4                   = (byte *)inrow2 + p2[j];
+			pix1 = (byte *)inrow + p1[j];
+			pix2 = (byte *)inrow + p2[j];
+			pix3 = (byte *)inrow2 + p1[j];
+			pix4 = (byte *)inrow2 + p2[j];
+#ifdef ETL_SSE
+			{
+				const __m128i zero = _mm_setzero_si128();
+				__m128i       a, b;
+
+				// widen [pix1 pix2] and [pix3 pix4] to 16 bit, sum all four and average
+				a = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int *)pix1), _mm_cvtsi32_si128(*(int *)pix2)), zero);
+				b = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(*(int *)pix3), _mm_cvtsi32_si128(*(int *)pix4)), zero);
+				a = _mm_add_epi16(a, b);
+				a = _mm_srli_epi16(_mm_add_epi16(a, _mm_srli_si128(a, 8)), 2);
+
+				out[j] = (unsigned)_mm_cvtsi128_si32(_mm_packus_epi16(a, a));
+			}
+#else
 			((byte *)(out + j))[0] = (pix1[0] + pix2[0] + pix3[0] + pix4[0]) >> 2;
 			((byte *)(out + j))[1] = (pix1[1] + pix2[1] + pix3[1] + pix4[1]) >> 2;
 			((byte *)(out + j))[2] = (pix1[2] + pix2[2] + pix3[2] + pix4[2]) >> 2;
 			((byte *)(out + j))[3] = (pix1[3] + pix2[3] + pix3[3] + pix4[3]) >> 2;
+#endif
 		}
 	}
 }
@@ -395,14 +520,88 @@ void R_LightScaleTexture(unsigned *in, int inwidth, int inheight, qboolean only_
 		{
 			for (i = 0 ; i < c ; i++, p += 4)
 			{
-				p[0] = s_gammatable[s_intensitytable[p[0]]];
-				p[1] = s_gammatable[s_intensitytable[p[1]]];
-				p[2] = s_gammatable[s_intensitytable[p[2]]];
+				p[0] = s_gammaintensitytable[p[0]];
+				p[1] = s_gammaintensitytable[p[1]];
+				p[2] = s_gammaintensitytable[p[2]];
 			}
 		}
 	}
 }
 
+#ifdef ETL_SSE
+/**
+ * @brief Operates in place, quartering the size of the texture
+ * Proper linear filter, SSE2 version
+ *
+ * The 4x4 kernel is the outer product of (1 2 2 1), so it is applied as a
+ * vertical pass into a 16 bit row followed by a horizontal pass. The final
+ * division by 36 is done as (x * 7282) >> 18 which is exact for x <= 36 * 255.
+ *
+ * @param in
+ * @param inWidth
+ * @param inHeight
+ */
+static void R_MipMap2(unsigned *in, int inWidth, int inHeight)
+{
+	const __m128i  zero         = _mm_setzero_si128();
+	const __m128i  div36        = _mm_set1_epi16(7282);
+	int            inWidthMask  = inWidth - 1;
+	int            inHeightMask = inHeight - 1;
+	int            outWidth     = inWidth >> 1;
+	int            outHeight    = inHeight >> 1;
+	int            i, j, k;
+	unsigned       *temp;
+	unsigned short *vrow;
+	const byte     *r0, *r1, *r2, *r3;
+	__m128i        v;
+
+	temp = ri.Hunk_AllocateTempMemory(outWidth * outHeight * 4);
+	vrow = ri.Hunk_AllocateTempMemory(inWidth * 4 * sizeof(unsigned short));
+
+	for (i = 0 ; i < outHeight ; i++)
+	{
+		r0 = (const byte *)(in + ((i * 2 - 1) & inHeightMask) * inWidth);
+		r1 = (const byte *)(in + ((i * 2) & inHeightMask) * inWidth);
+		r2 = (const byte *)(in + ((i * 2 + 1) & inHeightMask) * inWidth);
+		r3 = (const byte *)(in + ((i * 2 + 2) & inHeightMask) * inWidth);
+
+		// vertical pass: r0 + 2 * (r1 + r2) + r3
+		for (k = 0 ; k + 8 <= inWidth * 4 ; k += 8)
+		{
+			__m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r0 + k)), zero);
+			__m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r1 + k)), zero);
+			__m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r2 + k)), zero);
+			__m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r3 + k)), zero);
+
+			b = _mm_add_epi16(b, c);
+			_mm_storeu_si128((__m128i *)(vrow + k), _mm_add_epi16(_mm_add_epi16(a, d), _mm_add_epi16(b, b)));
+		}
+		for ( ; k < inWidth * 4 ; k++)
+		{
+			vrow[k] = r0[k] + 2 * (r1[k] + r2[k]) + r3[k];
+		}
+
+		// horizontal pass
+		for (j = 0 ; j < outWidth ; j++)
+		{
+			__m128i a = _mm_loadl_epi64((const __m128i *)(vrow + ((j * 2 - 1) & inWidthMask) * 4));
+			__m128i b = _mm_loadl_epi64((const __m128i *)(vrow + ((j * 2) & inWidthMask) * 4));
+			__m128i c = _mm_loadl_epi64((const __m128i *)(vrow + ((j * 2 + 1) & inWidthMask) * 4));
+			__m128i d = _mm_loadl_epi64((const __m128i *)(vrow + ((j * 2 + 2) & inWidthMask) * 4));
+
+			b = _mm_add_epi16(b, c);
+			v = _mm_add_epi16(_mm_add_epi16(a, d), _mm_add_epi16(b, b));
+			v = _mm_srli_epi16(_mm_mulhi_epu16(v, div36), 2);
+
+			temp[i * outWidth + j] = (unsigned)_mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+		}
+	}
+
+	ri.Hunk_FreeTempMemory(vrow);
+	Com_Memcpy(in, temp, outWidth * outHeight * 4);
+	ri.Hunk_FreeTempMemory(temp);
+}
+#else
 /**
  * @brief Operates in place, quartering the size of the texture
  * Proper linear filter
@@ -458,6 +657,7 @@ static void R_MipMap2(unsigned *in, int inWidth, int inHeight)
 	Com_Memcpy(in, temp, outWidth * outHeight * 4);
 	ri.Hunk_FreeTempMemory(temp);
 }
+#endif
 
 /**
  * @brief Operates in place, quartering the size of the texture
@@ -502,7 +702,33 @@ static void R_MipMap(byte *in, int width, int height)
 
 	for (i = 0 ; i < height ; i++, in += row)
 	{
-		for (j = 0 ; j < width ; j++, out += 4, in += 8)
+		j = 0;
+#ifdef ETL_SSE
+		// 8 input pixels of both rows into 4 output pixels, the stores never
+		// overtake the input still to be read so this is safe in place
+		for ( ; j + 4 <= width ; j += 4, out += 16, in += 32)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			__m128i       a0   = _mm_loadu_si128((const __m128i *)in);
+			__m128i       a1   = _mm_loadu_si128((const __m128i *)(in + 16));
+			__m128i       b0   = _mm_loadu_si128((const __m128i *)(in + row));
+			__m128i       b1   = _mm_loadu_si128((const __m128i *)(in + row + 16));
+			__m128i       v0, v1, v2, v3;
+
+			// vertical sums, two pixels per register
+			v0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+			v1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+			v2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+			v3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+			// horizontal sums of pixel pairs
+			v0 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(v0, v1), _mm_unpackhi_epi64(v0, v1)), 2);
+			v2 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(v2, v3), _mm_unpackhi_epi64(v2, v3)), 2);
+
+			_mm_storeu_si128((__m128i *)out, _mm_packus_epi16(v0, v2));
+		}
+#endif
+		for ( ; j < width ; j++, out += 4, in += 8)
 		{
 			out[0] = (in[0] + in[4] + in[row + 0] + in[row + 4]) >> 2;
 			out[1] = (in[1] + in[5] + in[row + 1] + in[row + 5]) >> 2;
@@ -552,6 +778,80 @@ byte mipBlendColors[16][4] =
 	{ 0,   0,   255, 128 },
 };
 
+/**
+ * @brief Upload one mip level of the bound texture, keeping a copy of it
+ *        when an image cache record is being built
+ * @param[in] level
+ * @param[in] internalFormat
+ * @param[in] width
+ * @param[in] height
+ * @param[in] data
+ */
+static void R_UploadMipLevel(int level, int internalFormat, int width, int height, const void *data)
+{
+	glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+	if (imageCache.recording)
+	{
+		int needed = imageCache.size + 2 * sizeof(int) + width * height * 4;
+
+		if (needed > imageCache.capacity)
+		{
+			int  capacity = MAX(needed, imageCache.capacity * 2);
+			byte *buffer  = Com_Allocate(capacity);
+
+			if (!buffer)
+			{
+				imageCache.recording = qfalse;
+				return;
+			}
+			if (imageCache.buffer)
+			{
+				Com_Memcpy(buffer, imageCache.buffer, imageCache.size);
+				Com_Dealloc(imageCache.buffer);
+			}
+			imageCache.buffer   = buffer;
+			imageCache.capacity = capacity;
+		}
+
+		Com_Memcpy(imageCache.buffer + imageCache.size, &width, sizeof(int));
+		Com_Memcpy(imageCache.buffer + imageCache.size + sizeof(int), &height, sizeof(int));
+		Com_Memcpy(imageCache.buffer + imageCache.size + 2 * sizeof(int), data, width * height * 4);
+		imageCache.size = needed;
+		imageCache.numLevels++;
+	}
+}
+
+/**
+ * @brief Set the filtering of the bound texture after its upload
+ * @param[in] mipmap
+ */
+static void R_SetUploadFilter(qboolean mipmap)
+{
+	if (mipmap)
+	{
+		if (textureFilterAnisotropic)
+		{
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, Com_Clamp(1.f, maxAnisotropy, r_extTextureFilterAnisotropic->value));
+		}
+
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
+	}
+	else
+	{
+		if (textureFilterAnisotropic)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 1);
+		}
+
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	}
+
+	GL_CheckErrors();
+}
+
 /**
  * @brief Upload32
  * @param[in,out] data
@@ -763,7 +1063,7 @@ static void Upload32(unsigned *data,
 	{
 		if (!mipmap)
 		{
-			glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			R_UploadMipLevel(0, internalFormat, scaled_width, scaled_height, data);
 			*pUploadWidth  = scaled_width;
 			*pUploadHeight = scaled_height;
 			*format        = internalFormat;
@@ -798,7 +1098,7 @@ static void Upload32(unsigned *data,
 	*pUploadHeight = scaled_height;
 	*format        = internalFormat;
 
-	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer);
+	R_UploadMipLevel(0, internalFormat, scaled_width, scaled_height, scaledBuffer);
 
 	if (mipmap)
 	{
@@ -824,249 +1124,938 @@ static void Upload32(unsigned *data,
 				R_BlendOverTexture((byte *)scaledBuffer, scaled_width * scaled_height, mipBlendColors[miplevel]);
 			}
 
-			glTexImage2D(GL_TEXTURE_2D, miplevel, internalFormat, scaled_width, scaled_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, scaledBuffer);
+			R_UploadMipLevel(miplevel, internalFormat, scaled_width, scaled_height, scaledBuffer);
 		}
 	}
 done:
 
-	if (mipmap)
+	R_SetUploadFilter(mipmap);
+
+	if (scaledBuffer != 0)
 	{
-		if (textureFilterAnisotropic)
-		{
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, Com_Clamp(1.f, maxAnisotropy, r_extTextureFilterAnisotropic->value));
-		}
+		ri.Hunk_FreeTempMemory(scaledBuffer);
+	}
+	if (resampledBuffer != 0)
+	{
+		ri.Hunk_FreeTempMemory(resampledBuffer);
+	}
+}
 
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
+/**
+ * @brief Upload the mip chain of an image cache record into the bound texture
+ * @param[in,out] image
+ * @param[in] header
+ */
+static void R_UploadImageCache(image_t *image, const imageCacheHeader_t *header)
+{
+	const byte *p = (const byte *)(header + 1);
+	int        level, width, height;
+
+	for (level = 0; level < header->numLevels; level++)
+	{
+		Com_Memcpy(&width, p, sizeof(int));
+		Com_Memcpy(&height, p + sizeof(int), sizeof(int));
+		p += 2 * sizeof(int);
+
+		glTexImage2D(GL_TEXTURE_2D, level, header->internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, p);
+		p += width * height * 4;
+	}
+
+	image->internalFormat = header->internalFormat;
+	image->uploadWidth    = header->uploadWidth;
+	image->uploadHeight   = header->uploadHeight;
+
+	R_SetUploadFilter(image->mipmap);
+}
+
+/**
+ * @brief Allocates an image_t and its texture object without uploading anything
+ * @param[in] name
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] wrapClampMode
+ * @return
+ */
+static image_t *R_AllocImage(const char *name, qboolean mipmap, qboolean allowPicmip, int wrapClampMode)
+{
+	image_t *image;
+	long    hash;
+
+	if (strlen(name) >= MAX_QPATH)
+	{
+		Ren_Drop("R_CreateImage: \"%s\" is too long\n", name);
+	}
+
+	if (tr.numImages == MAX_DRAWIMAGES)
+	{
+		Ren_Drop("R_CreateImage: MAX_DRAWIMAGES hit\n");
+	}
+
+	image = tr.images[tr.numImages] = R_CacheImageAlloc(sizeof(image_t));
+
+	// ok, let's try the recommended way
+	glGenTextures(1, &image->texnum);
+
+	tr.numImages++;
+
+	image->mipmap        = mipmap;
+	image->allowPicmip   = allowPicmip;
+	image->wrapClampMode = wrapClampMode;
+
+	Q_strncpyz(image->imgName, name, sizeof(image->imgName));
+
+	// lightmaps are always allocated on TMU 1
+	if (glActiveTextureARB && !strncmp(name, "*lightmap", 9))
+	{
+		image->TMU = 1;
 	}
 	else
 	{
-		if (textureFilterAnisotropic)
+		image->TMU = 0;
+	}
+
+	hash            = generateHashValue(name);
+	image->next     = hashTable[hash];
+	hashTable[hash] = image;
+
+	image->hash = hash;
+
+	return image;
+}
+
+/**
+ * @brief Uploads the texels of an image allocated by R_AllocImage
+ * @param[in,out] image
+ * @param[in] pic
+ * @param[in] width
+ * @param[in] height
+ */
+static void R_UploadImage(image_t *image, const byte *pic, int width, int height)
+{
+	qboolean isLightmap = qfalse;
+	qboolean noCompress = qfalse;
+
+	if (!strncmp(image->imgName, "*lightmap", 9))
+	{
+		isLightmap = qtrue;
+		noCompress = qtrue;
+	}
+	if (!noCompress && strstr(image->imgName, "skies"))
+	{
+		noCompress = qtrue;
+	}
+	if (!noCompress && strstr(image->imgName, "weapons"))          // don't compress view weapon skins
+	{
+		noCompress = qtrue;
+	}
+	// if the shader hasn't specifically asked for it, don't allow compression
+	if (r_extCompressedTextures->integer == 2 && (tr.allowCompress != qtrue))
+	{
+		noCompress = qtrue;
+	}
+	else if (r_extCompressedTextures->integer == 1 && (tr.allowCompress < 0))
+	{
+		noCompress = qtrue;
+	}
+	// don't compress textures smaller or equal to 128x128 pixels
+	else if ((width * height) <= (128 * 128))
+	{
+		noCompress = qtrue;
+	}
+
+	image->width  = width;
+	image->height = height;
+
+	if (glActiveTextureARB)
+	{
+		GL_SelectTexture(image->TMU);
+	}
+
+	GL_Bind(image);
+
+	if (imageCache.read)
+	{
+		R_UploadImageCache(image, imageCache.read);
+	}
+	else if (pic)
+	{
+		Upload32((unsigned *)pic, image->width, image->height,
+		         image->mipmap,
+		         image->allowPicmip,
+		         isLightmap,
+		         &image->internalFormat,
+		         &image->uploadWidth,
+		         &image->uploadHeight,
+		         noCompress);
+	}
+	else
+	{
+		image->internalFormat = GL_RGBA;
+		image->uploadWidth    = image->width;
+		image->uploadHeight   = image->height;
+
+		glTexImage2D(GL_TEXTURE_2D, 0, image->internalFormat, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+		if (image->mipmap)
 		{
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 1);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
+		}
+		else
+		{
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		}
+	}
+
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, image->wrapClampMode);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, image->wrapClampMode);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (image->TMU == 1)
+	{
+		GL_SelectTexture(0);
+	}
+}
+
+/**
+ * @brief This is the only way any image_t are created
+ * @param[in] name
+ * @param[in] pic
+ * @param[in] width
+ * @param[in] height
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] wrapClampMode
+ * @return
+ */
+image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
+                       qboolean mipmap, qboolean allowPicmip, int wrapClampMode)
+{
+	image_t *image = R_AllocImage(name, mipmap, allowPicmip, wrapClampMode);
+
+	R_UploadImage(image, pic, width, height);
+
+	return image;
+}
+
+//===================================================================
+
+/**
+ * @brief Loads any of the supported image types into a cannonical 32 bit format.
+ *
+ * @param[in] name
+ * @param[out] pic
+ * @param[out] width
+ * @param[out] height
+ */
+void R_LoadImage(const char *name, byte **pic, int *width, int *height)
+{
+	int      i;
+	char     localName[MAX_QPATH];
+	char     *altName;
+	qboolean loaderRet = qfalse;
+
+	*pic    = NULL;
+	*width  = 0;
+	*height = 0;
+
+	Q_strncpyz(localName, name, MAX_QPATH);
+
+	COM_StripExtension(name, localName, MAX_QPATH);
+
+	// Try and find a suitable match using all the image formats supported
+	// Searching is done in this order: tga, jp(e)g, png, pcx, bmp
+	for (i = 0; i < numImageLoaders; i++)
+	{
+		imageData_t data = { 0, NULL, { NULL } };
+
+		altName = va("%s.%s", localName, imageLoaders[i].ext);
+
+		// load the file, FS_ReadFile fails for missing files so there is no need to open it first
+		data.name = altName;
+		data.size = ri.FS_ReadFile(altName, &data.buffer.v);
+		if (data.size <= 0 || !data.buffer.b)
+		{
+			if (data.buffer.v)
+			{
+				ri.FS_FreeFile(data.buffer.v);
+			}
+			continue;
+		}
+
+		// Load
+		loaderRet = imageLoaders[i].ImageLoader(&data, pic, width, height, 0xFF);
+
+		// free the file data
+		ri.FS_FreeFile(data.buffer.v);
+
+		if (!loaderRet)
+		{
+			Ren_Drop("Image loader failed to parse an image %s\n", data.name);
+		}
+
+		if (*pic)
+		{
+			break;
+		}
+	}
+
+	if (*pic == NULL)
+	{
+		// Loader failed, most likely because the file isn't there
+		Ren_Developer("WARNING: %s not present in any supported image format\n", localName);
+	}
+}
+
+/**
+ * @brief Build the image cache key and file name of an image
+ *
+ * Only images read from pk3 files are cached, the pk3 checksum in the key
+ * invalidates records when the pk3 changes.
+ *
+ * @param[in] name
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[out] key
+ * @param[out] path
+ * @param[in] pathSize
+ * @return qtrue if the image can be cached
+ */
+static qboolean R_ImageCacheKey(const char *name, qboolean mipmap, qboolean allowPicmip, char *key, char *path, int pathSize)
+{
+	char         localName[MAX_QPATH];
+	char         *altName = NULL;
+	int          i, checksum = 0, origin = -1;
+	unsigned int hash = 2166136261u;
+	const char   *c;
+
+	COM_StripExtension(name, localName, MAX_QPATH);
+
+	// same search order as R_LoadImage, the first file found is the one it reads
+	for (i = 0; i < numImageLoaders; i++)
+	{
+		altName = va("%s.%s", localName, imageLoaders[i].ext);
+		origin  = ri.FS_FileOrigin(altName, &checksum);
+		if (origin != -1)
+		{
+			break;
+		}
+	}
+
+	// loose files override pk3 content and are never cached
+	if (origin != 1)
+	{
+		return qfalse;
+	}
+
+	// everything that changes the uploaded texels or their format
+	Com_sprintf(key, IMAGECACHE_KEY_SIZE, "%s %08x %i %i %i %i %i %.3f %.3f %i %i %i %i %i %i %i %i",
+	            altName, checksum, mipmap, allowPicmip ? r_picMip->integer : -1,
+	            r_roundImagesDown->integer, r_simpleMipMaps->integer, r_colorMipLevels->integer,
+	            r_gamma->value, r_intensity->value, tr.overbrightBits, glConfig.deviceSupportsGamma,
+	            r_textureBits->integer, r_greyScale->integer, r_extCompressedTextures->integer,
+	            glConfig.textureCompression, tr.allowCompress, glConfig.maxTextureSize);
+
+	// FNV-1a
+	for (c = key; *c; c++)
+	{
+		hash = (hash ^ (byte)*c) * 16777619u;
+	}
+	Com_sprintf(path, pathSize, "imagecache/%08x.img", hash);
+
+	return qtrue;
+}
+
+/**
+ * @brief Add a file to the image cache index
+ * @param[in] hash
+ * @param[in] size
+ * @return NULL if the index can't grow
+ */
+static imageCacheRecord_t *R_AddImageCacheRecord(unsigned int hash, int size)
+{
+	imageCacheRecord_t *record;
+
+	if (imageCache.numRecords == imageCache.maxRecords)
+	{
+		int                maxRecords = MAX(256, imageCache.maxRecords * 2);
+		imageCacheRecord_t *records   = Com_Allocate(maxRecords * sizeof(*records));
+
+		if (!records)
+		{
+			return NULL;
+		}
+		if (imageCache.records)
+		{
+			Com_Memcpy(records, imageCache.records, imageCache.numRecords * sizeof(*records));
+			Com_Dealloc(imageCache.records);
+		}
+		imageCache.records    = records;
+		imageCache.maxRecords = maxRecords;
+	}
+
+	record          = &imageCache.records[imageCache.numRecords++];
+	record->hash    = hash;
+	record->size    = size;
+	record->lastUse = 0;
+
+	imageCache.totalSize += size;
+
+	return record;
+}
+
+/**
+ * @brief Build the index of the files already in the image cache
+ */
+static void R_IndexImageCache(void)
+{
+	char         **files;
+	int          i, numFiles, size;
+	unsigned int hash;
+
+	if (imageCache.indexed)
+	{
+		return;
+	}
+	imageCache.indexed = qtrue;
+
+	files = ri.FS_ListFiles("imagecache", ".img", &numFiles);
+	for (i = 0; i < numFiles; i++)
+	{
+		if (sscanf(files[i], "%08x.img", &hash) != 1)
+		{
+			continue;
+		}
+
+		size = ri.FS_FOpenFileRead(va("imagecache/%s", files[i]), NULL, qfalse);
+		if (size > 0 && !R_AddImageCacheRecord(hash, size))
+		{
+			break;
+		}
+	}
+	ri.FS_FreeFileList(files);
+}
+
+/**
+ * @brief Mark an image cache file as used, adding it to the index when it was just written
+ * @param[in] path
+ * @param[in] size
+ */
+static void R_TouchImageCacheRecord(const char *path, int size)
+{
+	imageCacheRecord_t *record = NULL;
+	unsigned int       hash;
+	int                i;
+
+	if (sscanf(path, "imagecache/%08x.img", &hash) != 1)
+	{
+		return;
+	}
+
+	R_IndexImageCache();
+
+	for (i = 0; i < imageCache.numRecords; i++)
+	{
+		if (imageCache.records[i].hash == hash)
+		{
+			record                = &imageCache.records[i];
+			imageCache.totalSize += size - record->size;
+			record->size          = size;
+			break;
+		}
+	}
+
+	if (!record)
+	{
+		record = R_AddImageCacheRecord(hash, size);
+		if (!record)
+		{
+			return;
+		}
+	}
+
+	record->lastUse = ++imageCache.useCount;
+}
+
+/**
+ * @brief Delete the least recently used image cache files until the cache fits into r_imageCacheSize
+ */
+static void R_TrimImageCache(void)
+{
+	imageCacheRecord_t *record;
+	int                i, limit;
+
+	// in MB, 0 is unlimited
+	if (r_imageCacheSize->integer <= 0)
+	{
+		return;
+	}
+	limit = r_imageCacheSize->integer * 1024 * 1024;
+
+	// the record written last is never deleted
+	while (imageCache.totalSize > limit && imageCache.numRecords > 1)
+	{
+		record = &imageCache.records[0];
+		for (i = 1; i < imageCache.numRecords; i++)
+		{
+			if (imageCache.records[i].lastUse < record->lastUse)
+			{
+				record = &imageCache.records[i];
+			}
+		}
+
+		ri.FS_Delete(va("imagecache/%08x.img", record->hash));
+
+		imageCache.totalSize -= record->size;
+		*record               = imageCache.records[--imageCache.numRecords];
+	}
+}
+
+/**
+ * @brief Free the image cache index, the files may change before it is used again
+ */
+void R_ShutdownImageCache(void)
+{
+	if (imageCache.records)
+	{
+		Com_Dealloc(imageCache.records);
+	}
+	imageCache.records    = NULL;
+	imageCache.numRecords = 0;
+	imageCache.maxRecords = 0;
+	imageCache.totalSize  = 0;
+	imageCache.useCount   = 0;
+	imageCache.indexed    = qfalse;
+}
+
+/**
+ * @brief Create an image from its image cache record
+ * @param[in] name
+ * @param[in] key
+ * @param[in] path
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] glWrapClampMode
+ * @return NULL if there is no valid record
+ */
+static image_t *R_LoadImageCache(const char *name, const char *key, const char *path, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode)
+{
+	int                startTime = ri.Milliseconds();
+	imageCacheHeader_t *header;
+	image_t            *image;
+	const byte         *p;
+	int                fileSize, size, level, width, height;
+
+	size     = ri.FS_ReadFile(path, (void **)&header);
+	fileSize = size;
+	if (size < (int)sizeof(imageCacheHeader_t) || !header)
+	{
+		if (header)
+		{
+			ri.FS_FreeFile(header);
+		}
+		return NULL;
+	}
+
+	if (header->ident != IMAGECACHE_IDENT || header->version != IMAGECACHE_VERSION ||
+	    strncmp(header->key, key, IMAGECACHE_KEY_SIZE) || header->numLevels < 1)
+	{
+		ri.FS_FreeFile(header);
+		return NULL;
+	}
+
+	// validate the level sizes against the file size
+	p     = (const byte *)(header + 1);
+	size -= sizeof(imageCacheHeader_t);
+	for (level = 0; level < header->numLevels; level++)
+	{
+		if (size < (int)(2 * sizeof(int)))
+		{
+			break;
+		}
+		Com_Memcpy(&width, p, sizeof(int));
+		Com_Memcpy(&height, p + sizeof(int), sizeof(int));
+		if (width < 1 || height < 1 || width > glConfig.maxTextureSize || height > glConfig.maxTextureSize ||
+		    size - (int)(2 * sizeof(int)) < width * height * 4)
+		{
+			break;
+		}
+		p    += 2 * sizeof(int) + width * height * 4;
+		size -= 2 * sizeof(int) + width * height * 4;
+	}
+
+	if (level != header->numLevels)
+	{
+		Ren_Developer("WARNING: discarding broken image cache record %s for %s\n", path, name);
+		ri.FS_FreeFile(header);
+		return NULL;
+	}
+
+	imageCache.read = header;
+	image           = R_CreateImage(name, NULL, header->width, header->height, mipmap, allowPicmip, glWrapClampMode);
+	imageCache.read = NULL;
+
+	imageCache.hits++;
+	imageCache.msecSaved += header->buildMsec - (ri.Milliseconds() - startTime);
+
+	ri.FS_FreeFile(header);
+
+	R_TouchImageCacheRecord(path, fileSize);
+
+	return image;
+}
+
+/**
+ * @brief Write the mip chain recorded while creating an image to the image cache
+ * @param[in] image
+ * @param[in] key
+ * @param[in] path
+ * @param[in] buildMsec
+ */
+static void R_WriteImageCache(const image_t *image, const char *key, const char *path, int buildMsec)
+{
+	imageCacheHeader_t header;
+
+	if (imageCache.recording && imageCache.numLevels > 0)
+	{
+		Com_Memset(&header, 0, sizeof(header));
+		header.ident          = IMAGECACHE_IDENT;
+		header.version        = IMAGECACHE_VERSION;
+		Q_strncpyz(header.key, key, sizeof(header.key));
+		header.width          = image->width;
+		header.height         = image->height;
+		header.uploadWidth    = image->uploadWidth;
+		header.uploadHeight   = image->uploadHeight;
+		header.internalFormat = image->internalFormat;
+		header.numLevels      = imageCache.numLevels;
+		header.buildMsec      = buildMsec;
+
+		Com_Memcpy(imageCache.buffer, &header, sizeof(header));
+		ri.FS_WriteFile(path, imageCache.buffer, imageCache.size);
+
+		R_TouchImageCacheRecord(path, imageCache.size);
+		R_TrimImageCache();
+	}
+
+	imageCache.recording = qfalse;
+	imageCache.size      = 0;
+	imageCache.numLevels = 0;
+}
+
+/**
+ * @brief Start recording the mip chain uploaded for the next image
+ */
+static void R_RecordImageCache(void)
+{
+	// reserve room for the header
+	if (imageCache.capacity < (int)sizeof(imageCacheHeader_t))
+	{
+		if (imageCache.buffer)
+		{
+			Com_Dealloc(imageCache.buffer);
+		}
+		imageCache.buffer   = Com_Allocate(sizeof(imageCacheHeader_t));
+		imageCache.capacity = imageCache.buffer ? sizeof(imageCacheHeader_t) : 0;
+	}
+
+	imageCache.recording = imageCache.buffer != NULL;
+	imageCache.size      = sizeof(imageCacheHeader_t);
+	imageCache.numLevels = 0;
+}
+
+/**
+ * @brief Reads the file of an image, trying the image formats in the same
+ *        order as R_LoadImage
+ * @param[in] name
+ * @param[out] path
+ * @param[in] pathSize
+ * @param[out] data contents in a Com_Allocate block, data->name points at path
+ * @return Index of the image loader for the file, -1 if there is no file
+ */
+static int R_ReadImageFile(const char *name, char *path, int pathSize, imageData_t *data)
+{
+	char localName[MAX_QPATH];
+	void *buffer;
+	int  i, size;
+
+	Com_Memset(data, 0, sizeof(*data));
+
+	COM_StripExtension(name, localName, MAX_QPATH);
+
+	for (i = 0; i < numImageLoaders; i++)
+	{
+		Com_sprintf(path, pathSize, "%s.%s", localName, imageLoaders[i].ext);
+
+		size = ri.FS_ReadFile(path, &buffer);
+		if (size <= 0 || !buffer)
+		{
+			if (buffer)
+			{
+				ri.FS_FreeFile(buffer);
+			}
+			continue;
+		}
+
+		// copied out of the hunk, batched files are freed in request order
+		data->buffer.v = Com_Allocate(size);
+		if (!data->buffer.v)
+		{
+			ri.FS_FreeFile(buffer);
+			Ren_Drop("R_ReadImageFile: unable to allocate %i bytes for %s\n", size, path);
+		}
+		Com_Memcpy(data->buffer.v, buffer, size);
+		ri.FS_FreeFile(buffer);
+
+		data->size = size;
+		data->name = path;
 
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		return i;
 	}
 
-	GL_CheckErrors();
+	return -1;
+}
 
-	if (scaledBuffer != 0)
+/**
+ * @brief Decodes one pending image on a job thread
+ *
+ * Only the TGA and JPG loaders are safe to run here, the others allocate
+ * from the zone and are left to the main thread.
+ *
+ * @param[in] job
+ * @param[in,out] data pendingImage_t array
+ */
+static void R_DecodeImageJob(int job, void *data)
+{
+	pendingImage_t *pending   = (pendingImage_t *)data + job;
+	int            startTime;
+
+	pending->pic = NULL;
+
+	if (pending->ImageLoader != R_LoadTGA && pending->ImageLoader != R_LoadJPG)
 	{
-		ri.Hunk_FreeTempMemory(scaledBuffer);
+		return;
 	}
-	if (resampledBuffer != 0)
+
+	startTime = ri.Milliseconds();
+
+	pending->data.job    = qtrue;
+	pending->data.jobPic = NULL;
+
+	if (!pending->ImageLoader(&pending->data, &pending->pic, &pending->width, &pending->height, 0xFF) || !pending->pic)
 	{
-		ri.Hunk_FreeTempMemory(resampledBuffer);
+		Com_Dealloc(pending->data.jobPic);
+		pending->data.jobPic = NULL;
+		pending->pic         = NULL;
 	}
+
+	pending->data.job   = qfalse;
+	pending->decodeMsec = ri.Milliseconds() - startTime;
 }
 
 /**
- * @brief This is the only way any image_t are created
- * @param[in] name
- * @param[in] pic
- * @param[in] width
- * @param[in] height
- * @param[in] mipmap
- * @param[in] allowPicmip
- * @param[in] wrapClampMode
- * @return
+ * @brief Decodes the pending images on the job threads and uploads them in
+ *        the order they were requested
  */
-image_t *R_CreateImage(const char *name, const byte *pic, int width, int height,
-                       qboolean mipmap, qboolean allowPicmip, int wrapClampMode)
+static void R_FlushImageBatch(void)
 {
-	image_t  *image;
-	qboolean isLightmap = qfalse;
-	long     hash;
-	qboolean noCompress = qfalse;
+	pendingImage_t *pending;
+	byte           *pic;
+	int            i, width, height, startTime, allowCompress;
+	char           failed[MAX_QPATH];
 
-	if (strlen(name) >= MAX_QPATH)
-	{
-		Ren_Drop("R_CreateImage: \"%s\" is too long\n", name);
-	}
-	if (!strncmp(name, "*lightmap", 9))
-	{
-		isLightmap = qtrue;
-		noCompress = qtrue;
-	}
-	if (!noCompress && strstr(name, "skies"))
-	{
-		noCompress = qtrue;
-	}
-	if (!noCompress && strstr(name, "weapons"))          // don't compress view weapon skins
-	{
-		noCompress = qtrue;
-	}
-	// if the shader hasn't specifically asked for it, don't allow compression
-	if (r_extCompressedTextures->integer == 2 && (tr.allowCompress != qtrue))
-	{
-		noCompress = qtrue;
-	}
-	else if (r_extCompressedTextures->integer == 1 && (tr.allowCompress < 0))
+	if (!imageBatch.numPending)
 	{
-		noCompress = qtrue;
-	}
-	// don't compress textures smaller or equal to 128x128 pixels
-	else if ((width * height) <= (128 * 128))
-	{
-		noCompress = qtrue;
+		return;
 	}
 
-	if (tr.numImages == MAX_DRAWIMAGES)
-	{
-		Ren_Drop("R_CreateImage: MAX_DRAWIMAGES hit\n");
-	}
+	R_RunJobs(R_DecodeImageJob, imageBatch.numPending, imageBatch.pending);
 
-	image = tr.images[tr.numImages] = R_CacheImageAlloc(sizeof(image_t));
+	// the uploads need the GL context
+	R_SyncRenderThread();
 
-	// ok, let's try the recommended way
-	glGenTextures(1, &image->texnum);
+	failed[0]     = '\0';
+	allowCompress = tr.allowCompress;
 
-	tr.numImages++;
+	for (i = 0; i < imageBatch.numPending; i++)
+	{
+		pending = &imageBatch.pending[i];
+		pic     = pending->pic;
+		width   = pending->width;
+		height  = pending->height;
+
+		// the loader wasn't job safe or reported a problem, decode it here
+		// so messages and errors show up as they do without a batch
+		if (pic)
+		{
+			imageBatch.numJobDecoded++;
+		}
+		else
+		{
+			startTime = ri.Milliseconds();
+			if (!pending->ImageLoader(&pending->data, &pic, &width, &height, 0xFF) || !pic)
+			{
+				Q_strncpyz(failed, pending->path, sizeof(failed));
+				pic    = NULL;
+				width  = 1;
+				height = 1;
+			}
+			pending->decodeMsec = ri.Milliseconds() - startTime;
+		}
 
-	image->mipmap      = mipmap;
-	image->allowPicmip = allowPicmip;
+		if (pic && pending->cacheImage)
+		{
+			R_RecordImageCache();
+		}
 
-	Q_strncpyz(image->imgName, name, sizeof(image->imgName));
+		startTime        = ri.Milliseconds();
+		tr.allowCompress = pending->allowCompress;
 
-	image->width         = width;
-	image->height        = height;
-	image->wrapClampMode = wrapClampMode;
+		R_UploadImage(pending->image, pic, width, height);
 
-	// lightmaps are always allocated on TMU 1
-	if (glActiveTextureARB && isLightmap)
-	{
-		image->TMU = 1;
+		if (pic && pending->cacheImage)
+		{
+			R_WriteImageCache(pending->image, pending->cacheKey, pending->cachePath, pending->decodeMsec + ri.Milliseconds() - startTime);
+		}
+
+		Com_Dealloc(pending->data.jobPic);
+		Com_Dealloc(pending->data.buffer.v);
+		pending->data.jobPic   = NULL;
+		pending->data.buffer.v = NULL;
 	}
-	else
+
+	tr.allowCompress = allowCompress;
+
+	imageBatch.numImages += imageBatch.numPending;
+	imageBatch.numPending = 0;
+
+	// reported once the batch is consistent again
+	if (failed[0])
 	{
-		image->TMU = 0;
+		Ren_Drop("Image loader failed to parse an image %s\n", failed);
 	}
+}
 
-	if (glActiveTextureARB)
+/**
+ * @brief Reads an image and queues it for decoding, the returned image gets
+ *        its texels when the batch is flushed
+ * @param[in] name
+ * @param[in] mipmap
+ * @param[in] allowPicmip
+ * @param[in] glWrapClampMode
+ * @param[in] cacheKey image cache record to write, NULL for none
+ * @param[in] cachePath
+ * @return NULL if the image isn't found
+ */
+static image_t *R_QueueImage(const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode, const char *cacheKey, const char *cachePath)
+{
+	pendingImage_t *pending;
+	int            loader;
+
+	if (imageBatch.numPending == MAX_PENDING_IMAGES)
 	{
-		GL_SelectTexture(image->TMU);
+		R_FlushImageBatch();
 	}
 
-	GL_Bind(image);
+	pending = &imageBatch.pending[imageBatch.numPending];
 
-	if (pic)
+	loader = R_ReadImageFile(name, pending->path, sizeof(pending->path), &pending->data);
+	if (loader < 0)
 	{
-		Upload32((unsigned *)pic, image->width, image->height,
-		         image->mipmap,
-		         allowPicmip,
-		         isLightmap,
-		         &image->internalFormat,
-		         &image->uploadWidth,
-		         &image->uploadHeight,
-		         noCompress);
+		return NULL;
 	}
-	else
+
+	pending->ImageLoader   = imageLoaders[loader].ImageLoader;
+	pending->allowCompress = tr.allowCompress;
+	pending->pic           = NULL;
+	pending->cacheImage    = cacheKey != NULL;
+	if (cacheKey)
 	{
-		image->internalFormat = GL_RGBA;
-		image->uploadWidth    = image->width;
-		image->uploadHeight   = image->height;
+		Q_strncpyz(pending->cacheKey, cacheKey, sizeof(pending->cacheKey));
+		Q_strncpyz(pending->cachePath, cachePath, sizeof(pending->cachePath));
+	}
 
-		glTexImage2D(GL_TEXTURE_2D, 0, image->internalFormat, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	// R_AllocImage may drop, the file is released by R_DiscardImageBatch then
+	pending->image = R_AllocImage(name, mipmap, allowPicmip, glWrapClampMode);
 
-		if (mipmap)
-		{
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter_min);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter_max);
-		}
-		else
-		{
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		}
-	}
+	imageBatch.numPending++;
 
-	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapClampMode);
-	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapClampMode);
+	return pending->image;
+}
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+/**
+ * @brief Starts queueing the images of R_FindImageFile, so they are decoded
+ *        in parallel by the front end jobs
+ *
+ * Nothing may draw with the images found until R_EndImageBatch.
+ */
+void R_BeginImageBatch(void)
+{
+	// left over from a batch that was interrupted by an error
+	R_DiscardImageBatch();
 
-	if (image->TMU == 1)
+	imageBatch.active        = R_NumJobThreads() > 0 && GLEW_ARB_texture_non_power_of_two;
+	imageBatch.numImages     = 0;
+	imageBatch.numJobDecoded = 0;
+}
+
+/**
+ * @brief Decodes and uploads all images queued since R_BeginImageBatch
+ */
+void R_EndImageBatch(void)
+{
+	if (!imageBatch.active)
 	{
-		GL_SelectTexture(0);
+		return;
 	}
 
-	hash            = generateHashValue(name);
-	image->next     = hashTable[hash];
-	hashTable[hash] = image;
+	imageBatch.active = qfalse;
 
-	image->hash = hash;
+	R_FlushImageBatch();
 
-	return image;
+	Ren_Developer("R_EndImageBatch: %i images, %i decoded by jobs\n", imageBatch.numImages, imageBatch.numJobDecoded);
 }
 
-//===================================================================
-
 /**
- * @brief Loads any of the supported image types into a cannonical 32 bit format.
+ * @brief Drops the images queued by a map load that was interrupted by an error
  *
- * @param[in] name
- * @param[out] pic
- * @param[out] width
- * @param[out] height
+ * Nothing is decoded, a loader could drop again while the error is handled.
+ * The images get empty texels and a name neither R_FindImageFile nor the
+ * r_cache backup will match.
  */
-void R_LoadImage(const char *name, byte **pic, int *width, int *height)
+void R_DiscardImageBatch(void)
 {
-	int      i;
-	char     localName[MAX_QPATH];
-	char     *altName;
-	qboolean loaderRet = qfalse;
+	pendingImage_t *pending;
+	int            i;
 
-	*pic    = NULL;
-	*width  = 0;
-	*height = 0;
+	if (!imageBatch.active)
+	{
+		return;
+	}
 
-	Q_strncpyz(localName, name, MAX_QPATH);
+	imageBatch.active = qfalse;
 
-	COM_StripExtension(name, localName, MAX_QPATH);
+	R_SyncRenderThread();
 
-	// Try and find a suitable match using all the image formats supported
-	// Searching is done in this order: tga, jp(e)g, png, pcx, bmp
-	for (i = 0; i < numImageLoaders; i++)
+	for (i = 0; i < MAX_PENDING_IMAGES; i++)
 	{
-		altName = va("%s.%s", localName, imageLoaders[i].ext);
+		pending = &imageBatch.pending[i];
 
-		// Check if file exists
-		if (ri.FS_FOpenFileRead(altName, NULL, qfalse) > 0)
+		if (i < imageBatch.numPending)
 		{
-			imageData_t data = { 0, altName, { NULL } };
-			// load the file
-			data.size = ri.FS_ReadFile(altName, &data.buffer.v);
-			if (!data.buffer.b || data.size < 0)
-			{
-				Ren_Developer("Failed to load an image (%s)\n", data.name);
-				continue;
-			}
-
-			// Load
-			loaderRet = imageLoaders[i].ImageLoader(&data, pic, width, height, 0xFF);
-
-			// free the file data
-			ri.FS_FreeFile(data.buffer.v);
-
-			if (!loaderRet)
-			{
-				Ren_Drop("Image loader failed to parse an image %s\n", data.name);
-			}
+			R_UploadImage(pending->image, NULL, 1, 1);
+			Q_strncpyz(pending->image->imgName, "*discarded", sizeof(pending->image->imgName));
 		}
 
-		if (*pic)
-		{
-			break;
-		}
+		// including the file of an image R_AllocImage dropped on
+		Com_Dealloc(pending->data.jobPic);
+		Com_Dealloc(pending->data.buffer.v);
+		pending->data.jobPic   = NULL;
+		pending->data.buffer.v = NULL;
 	}
 
-	if (*pic == NULL)
-	{
-		// Loader failed, most likely because the file isn't there
-		Ren_Developer("WARNING: %s not present in any supported image format\n", localName);
-	}
+	imageBatch.numPending = 0;
 }
 
 /**
@@ -1087,6 +2076,10 @@ image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip
 	byte     *pic;
 	long     hash;
 	qboolean allowCompress = qfalse;
+	qboolean cacheImage    = qfalse;
+	int      startTime     = 0;
+	char     cacheKey[IMAGECACHE_KEY_SIZE];
+	char     cachePath[MAX_QPATH];
 
 	if (!name)
 	{
@@ -1138,6 +2131,31 @@ image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip
 		}
 	}
 
+	// upload the final mip chain from the image cache
+	if (!lightmap && r_imageCache->integer && R_ImageCacheKey(name, mipmap, allowPicmip, cacheKey, cachePath, sizeof(cachePath)))
+	{
+		image = R_LoadImageCache(name, cacheKey, cachePath, mipmap, allowPicmip, glWrapClampMode);
+		if (image)
+		{
+			return image;
+		}
+
+		imageCache.misses++;
+		cacheImage = qtrue;
+		startTime  = ri.Milliseconds();
+	}
+
+	// read it now, decode it on the job threads with the rest of the batch
+	if (imageBatch.active && !lightmap)
+	{
+		image = R_QueueImage(name, mipmap, allowPicmip, glWrapClampMode, cacheImage ? cacheKey : NULL, cachePath);
+		if (image == NULL)
+		{
+			Ren_Developer("WARNING: Image '%s' not found. Note: This might be false positive for shaders w/o image.\n", name);
+		}
+		return image;
+	}
+
 	// load the pic from disk
 	R_LoadImage(name, &pic, &width, &height);
 	if (pic == NULL)
@@ -1165,8 +2183,18 @@ image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip
 		return NULL;
 	}
 
+	if (cacheImage)
+	{
+		R_RecordImageCache();
+	}
+
 	image = R_CreateImage(name, pic, width, height, mipmap, allowPicmip, glWrapClampMode);
 
+	if (cacheImage)
+	{
+		R_WriteImageCache(image, cacheKey, cachePath, ri.Milliseconds() - startTime);
+	}
+
 	// no texture compression
 	if (lightmap)
 	{
@@ -1176,6 +2204,110 @@ image_t *R_FindImageFile(const char *name, qboolean mipmap, qboolean allowPicmip
 	return image;
 }
 
+/**
+ * @brief Decode and mip all images of a directory without uploading them,
+ *        to measure the CPU side of image loading
+ *
+ * The files are read first, decoding is timed on this thread and then on
+ * the front end jobs as R_FlushImageBatch does it.
+ *
+ * Usage: imagebench [directory] [extension]
+ */
+void R_ImageBench_f(void)
+{
+	char           **fileList;
+	char           path[MAX_QPATH];
+	const char     *dir = ri.Cmd_Argc() > 1 ? ri.Cmd_Argv(1) : "textures";
+	const char     *ext = ri.Cmd_Argc() > 2 ? ri.Cmd_Argv(2) : "";
+	int            numFiles, i, loader, numPending = 0, numImages = 0, numJobDecoded = 0;
+	int            startTime, decodeTime = 0, mipTime = 0, jobTime, time;
+	int            width, height, w, h;
+	byte           *pic;
+	double         texels = 0;
+	pendingImage_t *pending;
+
+	fileList = ri.FS_ListFiles(dir, ext, &numFiles);
+	if (!fileList)
+	{
+		Ren_Print("imagebench: no files found in '%s'\n", dir);
+		return;
+	}
+
+	pending = Com_Allocate(numFiles * sizeof(*pending));
+	if (!pending)
+	{
+		ri.FS_FreeFileList(fileList);
+		Ren_Print("imagebench: out of memory\n");
+		return;
+	}
+
+	for (i = 0; i < numFiles; i++)
+	{
+		Com_sprintf(path, sizeof(path), "%s/%s", dir, fileList[i]);
+
+		loader = R_ReadImageFile(path, pending[numPending].path, sizeof(pending[numPending].path), &pending[numPending].data);
+		if (loader >= 0)
+		{
+			pending[numPending].ImageLoader = imageLoaders[loader].ImageLoader;
+			numPending++;
+		}
+	}
+
+	ri.FS_FreeFileList(fileList);
+
+	for (i = 0; i < numPending; i++)
+	{
+		time = ri.Milliseconds();
+		if (!pending[i].ImageLoader(&pending[i].data, &pic, &width, &height, 0xFF))
+		{
+			pic = NULL;
+		}
+		startTime   = ri.Milliseconds();
+		decodeTime += startTime - time;
+
+		if (!pic)
+		{
+			continue;
+		}
+
+		numImages++;
+		texels += (double)width * height;
+
+		// the mip filters assume power of two dimensions, Upload32 resamples first
+		if (!Com_PowerOf2(width) || !Com_PowerOf2(height))
+		{
+			continue;
+		}
+
+		for (w = width, h = height; w > 1 || h > 1; )
+		{
+			R_MipMap(pic, w, h);
+			w = MAX(1, w >> 1);
+			h = MAX(1, h >> 1);
+		}
+		mipTime += ri.Milliseconds() - startTime;
+	}
+
+	time = ri.Milliseconds();
+	R_RunJobs(R_DecodeImageJob, numPending, pending);
+	jobTime = ri.Milliseconds() - time;
+
+	for (i = 0; i < numPending; i++)
+	{
+		if (pending[i].pic)
+		{
+			numJobDecoded++;
+		}
+		Com_Dealloc(pending[i].data.jobPic);
+		Com_Dealloc(pending[i].data.buffer.v);
+	}
+	Com_Dealloc(pending);
+
+	Ren_Print("imagebench: %i of %i files decoded, %.2f Mtexels\n", numImages, numFiles, texels / 1000000.0);
+	Ren_Print("  decode %i msec (%.2f Mtexels/s), mip %i msec\n", decodeTime, decodeTime ? texels / 1000.0 / decodeTime : 0.0, mipTime);
+	Ren_Print("  job decode %i msec with %i worker threads, %i images decoded by jobs\n", jobTime, R_NumJobThreads(), numJobDecoded);
+}
+
 #define DLIGHT_SIZE 16
 
 /**
@@ -1436,7 +2568,8 @@ void R_SetColorMappings(void)
 
 	for (i = 0 ; i < 256 ; i++)
 	{
-		s_intensitytable[i] = ClampByte((int)(i * r_intensity->value));
+		s_intensitytable[i]      = ClampByte((int)(i * r_intensity->value));
+		s_gammaintensitytable[i] = s_gammatable[s_intensitytable[i]];
 	}
 
 	if (glConfig.deviceSupportsGamma && !tr.gammaProgramUsed)
@@ -2273,6 +3406,8 @@ void R_LoadCacheImages(void)
 	ri.FS_ReadFile("image.cache", (void **)&buf);
 	pString = buf;
 
+	R_BeginImageBatch();
+
 	while ((token = COM_ParseExt(&pString, qtrue)) && token[0])
 	{
 		Q_strncpyz(name, token, sizeof(name));
@@ -2284,5 +3419,7 @@ void R_LoadCacheImages(void)
 		R_FindImageFile(name, parms[0], parms[1], parms[2], parms[3]);
 	}
 
+	R_EndImageBatch();
+
 	ri.Hunk_FreeTempMemory(buf);
 }
@@ -102,6 +102,10 @@ cvar_t *r_ignoreGLErrors;
 cvar_t *r_logFile;
 
 cvar_t *r_textureBits;
+cvar_t *r_imageCache;
+cvar_t *r_imageCacheSize;
+cvar_t *r_frontEndThreads;
+cvar_t *r_smp;
 
 cvar_t *r_drawBuffer;
 cvar_t *r_lightMap;
@@ -621,6 +625,9 @@ void R_TakeScreenshot(int x, int y, int width, int height, const char *name, ssF
 	Q_strncpyz(fileName, name, sizeof(fileName));
 	cmd->fileName = fileName;
 	cmd->format   = format;
+
+	// fileName is reused and the file is written by the back end
+	R_SyncRenderThreadAfterIssue();
 }
 
 /**
@@ -650,17 +657,200 @@ void R_ScreenshotFilename(int lastNumber, char *fileName, char *ext)
 	            , a, b, c, d, ext);
 }
 
+#define VIDEOFRAME_PBOS 3
+
+/**
+ * @struct videoFrameInfo_t
+ * @brief A frame read back by RB_TakeVideoFrameCmd
+ */
+typedef struct
+{
+	byte *captureBuffer;            ///< as passed to RE_TakeVideoFrame, identifies the recording
+	byte *pixels;                   ///< mapped pbo or aligned captureBuffer, NULL if none
+	int pbo;                        ///< index in videoFrame.pbo, -1 if read into captureBuffer
+	size_t memcount;
+	int padlen;
+	int width, height;
+} videoFrameInfo_t;
+
+/**
+ * @struct videoFrame_t
+ * @brief Ring of pixel buffer objects the video frames are read into
+ *
+ * The back end reads each frame into the next pbo and maps the one read with
+ * the previous frame, its transfer had a whole frame to finish. RE_EndFrame
+ * hands the mapped pixels to the client on the main thread while the back end
+ * is idle, and the back end unmaps them with the next video frame.
+ */
+typedef struct
+{
+	GLuint pbo[VIDEOFRAME_PBOS];
+	size_t pboSize[VIDEOFRAME_PBOS];
+	int nextPbo;
+
+	qboolean readPending;
+	videoFrameInfo_t read;          ///< being transferred into a pbo
+	videoFrameInfo_t ready;         ///< mapped, for R_WriteVideoFrame
+	qboolean written;               ///< ready was handed to the client
+
+	// main thread only
+	byte *requestBuffer;            ///< last RE_TakeVideoFrame, see R_RequestVideoFrame
+	int requestWidth, requestHeight;
+	byte *gammaBuffer;              ///< gamma corrected copy of a mapped pbo
+	size_t gammaBufferSize;
+} videoFrame_t;
+
+static videoFrame_t videoFrame;
+
+/**
+ * @brief Unmaps the frame handed to the client, or drops it if it wasn't
+ */
+static void RB_ReleaseVideoFrame(void)
+{
+	if (videoFrame.ready.pixels && videoFrame.ready.pbo >= 0)
+	{
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, videoFrame.pbo[videoFrame.ready.pbo]);
+		glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB);
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+	}
+	videoFrame.ready.pixels = NULL;
+}
+
+/**
+ * @brief Maps the frame read into a pbo by the last video frame command
+ */
+static void RB_MapVideoFrame(void)
+{
+	glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, videoFrame.pbo[videoFrame.read.pbo]);
+	videoFrame.ready        = videoFrame.read;
+	videoFrame.ready.pixels = glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+	videoFrame.written      = qfalse;
+	videoFrame.readPending  = qfalse;
+	glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+}
+
+/**
+ * @brief Records the last video frame request, R_WriteVideoFrame drops the
+ *        frames of an earlier recording
+ * @param[in] width
+ * @param[in] height
+ * @param[in] captureBuffer
+ */
+void R_RequestVideoFrame(int width, int height, byte *captureBuffer)
+{
+	videoFrame.requestBuffer = captureBuffer;
+	videoFrame.requestWidth  = width;
+	videoFrame.requestHeight = height;
+}
+
+/**
+ * @brief Hands the frame read by the back end to the client
+ *
+ * Called by RE_EndFrame on the main thread while the back end is idle, the client
+ * allocates from the zone and may drop with Com_Error. A frame read into a pbo
+ * reaches the client with the next video frame or the one after with r_smp,
+ * the frames stay in order.
+ */
+void R_WriteVideoFrame(void)
+{
+	videoFrameInfo_t *frame = &videoFrame.ready;
+	byte             *pixels;
+
+	if (!frame->pixels || videoFrame.written)
+	{
+		return;
+	}
+	videoFrame.written = qtrue;
+
+	// read before the recording was stopped or restarted
+	if (frame->captureBuffer != videoFrame.requestBuffer
+	    || frame->width != videoFrame.requestWidth || frame->height != videoFrame.requestHeight)
+	{
+		return;
+	}
+
+	pixels = frame->pixels;
+
+	// gamma correct
+	if (glConfig.deviceSupportsGamma && !tr.gammaProgramUsed)
+	{
+		// the mapped pbo is read only
+		if (frame->pbo >= 0)
+		{
+			if (videoFrame.gammaBufferSize < frame->memcount)
+			{
+				Com_Dealloc(videoFrame.gammaBuffer);
+				videoFrame.gammaBuffer     = Com_Allocate(frame->memcount);
+				videoFrame.gammaBufferSize = videoFrame.gammaBuffer ? frame->memcount : 0;
+				if (!videoFrame.gammaBuffer)
+				{
+					return;
+				}
+			}
+			Com_Memcpy(videoFrame.gammaBuffer, pixels, frame->memcount);
+			pixels = videoFrame.gammaBuffer;
+		}
+		R_GammaCorrect(pixels, frame->memcount);
+	}
+
+	ri.CL_WriteAVIVideoPixels(pixels, frame->padlen);
+}
+
+/**
+ * @brief Hands the frames still in the pbo ring to the client, which calls
+ *        this before it closes the recording
+ */
+void RE_FinishVideoFrames(void)
+{
+	if (!tr.registered)
+	{
+		return;
+	}
+
+	// the back end may still be reading the last frame
+	R_SyncRenderThread();
+
+	R_WriteVideoFrame();
+
+	if (videoFrame.readPending)
+	{
+		RB_ReleaseVideoFrame();
+		RB_MapVideoFrame();
+		R_WriteVideoFrame();
+	}
+
+	RB_ReleaseVideoFrame();
+}
+
+/**
+ * @brief Deletes the video frame pbos, the GL context must be current
+ */
+void R_ShutdownVideoFrame(void)
+{
+	RB_ReleaseVideoFrame();
+
+	if (videoFrame.pbo[0])
+	{
+		glDeleteBuffersARB(VIDEOFRAME_PBOS, videoFrame.pbo);
+	}
+	Com_Dealloc(videoFrame.gammaBuffer);
+	Com_Memset(&videoFrame, 0, sizeof(videoFrame));
+}
+
 /**
  * @brief RB_TakeVideoFrameCmd
  * @param[in] data
  * @return
+ *
+ * @note The client encodes the frame on its writer thread, cmd->motionJpeg
+ * and cmd->encodeBuffer are left to it.
  */
 const void *RB_TakeVideoFrameCmd(const void *data)
 {
 	const videoFrameCommand_t *cmd;
-	byte                      *cBuf;
-	size_t                    memcount, linelen;
-	int                       padwidth, avipadwidth, padlen, avipadlen;
+	videoFrameInfo_t          frame;
+	size_t                    linelen;
+	int                       padwidth;
 	GLint                     packAlign;
 	frameBuffer_t             *tmpFbo;
 
@@ -677,63 +867,63 @@ const void *RB_TakeVideoFrameCmd(const void *data)
 	linelen = cmd->width * 3;
 
 	// Alignment stuff for glReadPixels
-	padwidth = PAD(linelen, packAlign);
-	padlen   = padwidth - linelen;
-	// AVI line padding
-	avipadwidth = PAD(linelen, AVI_LINE_PADDING);
-	avipadlen   = avipadwidth - linelen;
+	padwidth     = PAD(linelen, packAlign);
+	frame.padlen = padwidth - linelen;
 
-	cBuf = PADP(cmd->captureBuffer, packAlign);
+	frame.captureBuffer = cmd->captureBuffer;
+	frame.memcount      = padwidth * cmd->height;
+	frame.width         = cmd->width;
+	frame.height        = cmd->height;
 
 	tmpFbo = R_CurrentFBO();
 	R_BindFBO(NULL);
-	glReadPixels(0, 0, cmd->width, cmd->height, GL_RGB, GL_UNSIGNED_BYTE, cBuf);
-	R_BindFBO(tmpFbo);
 
-	memcount = padwidth * cmd->height;
+	// R_WriteVideoFrame is done with the last one
+	RB_ReleaseVideoFrame();
 
-	// gamma correct
-	if (glConfig.deviceSupportsGamma && !tr.gammaProgramUsed)
+	if (GLEW_ARB_pixel_buffer_object)
 	{
-		R_GammaCorrect(cBuf, memcount);
-	}
+		frame.pbo          = videoFrame.nextPbo;
+		frame.pixels       = NULL;
+		videoFrame.nextPbo = (videoFrame.nextPbo + 1) % VIDEOFRAME_PBOS;
 
-	if (cmd->motionJpeg)
-	{
-		memcount = RE_SaveJPGToBuffer(cmd->encodeBuffer, linelen * cmd->height,
-		                              r_screenshotJpegQuality->integer,
-		                              cmd->width, cmd->height, cBuf, padlen);
-		ri.CL_WriteAVIVideoFrame(cmd->encodeBuffer, memcount);
-	}
-	else
-	{
-		byte *lineend, *memend;
-		byte *srcptr, *destptr;
-
-		srcptr  = cBuf;
-		destptr = cmd->encodeBuffer;
-		memend  = srcptr + memcount;
+		if (!videoFrame.pbo[0])
+		{
+			glGenBuffersARB(VIDEOFRAME_PBOS, videoFrame.pbo);
+		}
 
-		// swap R and B and remove line paddings
-		while (srcptr < memend)
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, videoFrame.pbo[frame.pbo]);
+		if (videoFrame.pboSize[frame.pbo] != frame.memcount)
 		{
-			lineend = srcptr + linelen;
-			while (srcptr < lineend)
-			{
-				*destptr++ = srcptr[2];
-				*destptr++ = srcptr[1];
-				*destptr++ = srcptr[0];
-				srcptr    += 3;
-			}
+			glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, frame.memcount, NULL, GL_STREAM_READ_ARB);
+			videoFrame.pboSize[frame.pbo] = frame.memcount;
+		}
 
-			Com_Memset(destptr, '\0', avipadlen);
-			destptr += avipadlen;
+		// returns right away, the pixels are mapped with the next video frame
+		glReadPixels(0, 0, cmd->width, cmd->height, GL_RGB, GL_UNSIGNED_BYTE, 0);
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
 
-			srcptr += padlen;
+		// the frame before has been transferred while this one was drawn
+		if (videoFrame.readPending)
+		{
+			RB_MapVideoFrame();
 		}
 
-		ri.CL_WriteAVIVideoFrame(cmd->encodeBuffer, avipadwidth * cmd->height);
+		videoFrame.read        = frame;
+		videoFrame.readPending = qtrue;
 	}
+	else
+	{
+		frame.pbo    = -1;
+		frame.pixels = PADP(cmd->captureBuffer, packAlign);
+
+		glReadPixels(0, 0, cmd->width, cmd->height, GL_RGB, GL_UNSIGNED_BYTE, frame.pixels);
+
+		videoFrame.ready   = frame;
+		videoFrame.written = qfalse;
+	}
+
+	R_BindFBO(tmpFbo);
 
 	return (const void *)(cmd + 1);
 }
@@ -757,6 +947,8 @@ void R_LevelShot(void)
 
 	Com_sprintf(checkname, sizeof(checkname), "levelshots/%s.tga", tr.world->baseName);
 
+	R_SyncRenderThread();
+
 	allsource = R_FBOReadPixels(NULL, &offset, &padlen);
 	source    = allsource + offset;
 
@@ -1075,6 +1267,17 @@ void R_Register(void)
 	r_colorMipLevels = ri.Cvar_Get("r_colorMipLevels", "0", CVAR_LATCH);
 	r_detailTextures = ri.Cvar_Get("r_detailtextures", "1", CVAR_ARCHIVE_ND | CVAR_LATCH);
 	r_textureBits    = ri.Cvar_Get("r_texturebits", "0", CVAR_ARCHIVE_ND | CVAR_LATCH | CVAR_UNSAFE);
+	r_imageCache     = ri.Cvar_Get("r_imageCache", "0", CVAR_ARCHIVE_ND);
+	ri.Cvar_SetDescription(r_imageCache, "Keep the final mip chains of images loaded from pk3 files in imagecache/ to skip decoding them again");
+	r_imageCacheSize = ri.Cvar_Get("r_imageCacheSize", "512", CVAR_ARCHIVE_ND);
+	ri.Cvar_CheckRange(r_imageCacheSize, 0, 2047, qtrue);
+	ri.Cvar_SetDescription(r_imageCacheSize, "Size limit of imagecache/ in MB, the least recently used images are deleted first, 0 is unlimited");
+	r_frontEndThreads = ri.Cvar_Get("r_frontEndThreads", "0", CVAR_ARCHIVE_ND | CVAR_LATCH);
+	ri.Cvar_CheckRange(r_frontEndThreads, 0, MAX_JOB_THREADS, qtrue);
+	ri.Cvar_SetDescription(r_frontEndThreads, "Number of worker threads culling world surfaces, 0 culls them on the main thread");
+	r_smp = ri.Cvar_Get("r_smp", "0", CVAR_ARCHIVE_ND | CVAR_LATCH);
+	ri.Cvar_CheckRange(r_smp, 0, 1, qtrue);
+	ri.Cvar_SetDescription(r_smp, "Run the render back end on its own thread, overlapping it with the next frame's front end");
 
 	r_overBrightBits = ri.Cvar_Get("r_overBrightBits", "0", CVAR_ARCHIVE_ND | CVAR_LATCH);        // disable overbrightbits by default
 	ri.Cvar_CheckRange(r_overBrightBits, 0, 1, qtrue);                                    // limit to overbrightbits 1 (sorry 1337 players)
@@ -1241,6 +1444,8 @@ void R_Register(void)
 	// make sure all the commands added here are also
 	// removed in R_Shutdown
 	ri.Cmd_AddSystemCommand("imagelist", R_ImageList_f, "Print out the list of images loaded", NULL);
+	ri.Cmd_AddSystemCommand("imagebench", R_ImageBench_f, "Decode and mip the images of a directory without uploading them", NULL);
+	ri.Cmd_AddSystemCommand("mdmskinbench", R_MDM_SkinBench_f, "Compare the scalar and SSE skinning of the loaded MDM models", NULL);
 	ri.Cmd_AddSystemCommand("shaderlist", R_ShaderList_f, "Print out the list of shaders loaded", NULL);
 	ri.Cmd_AddSystemCommand("skinlist", R_SkinList_f, "Print out the list of skins", NULL);
 	ri.Cmd_AddSystemCommand("modellist", R_Modellist_f, "Print out the list of loaded models", NULL);
@@ -1306,11 +1511,21 @@ void R_Init(void)
 
 	R_Register();
 
-	ptr = ri.Hunk_Alloc(sizeof(*backEndData) + sizeof(srfPoly_t) * r_maxPolys->integer + sizeof(polyVert_t) * r_maxPolyVerts->integer, h_low);
+	// the render thread works on one frame while the front end fills the other
+	for (i = 0; i < SMP_FRAMES; i++)
+	{
+		if (i > 0 && !r_smp->integer)
+		{
+			backEndData[i] = NULL;
+			continue;
+		}
+
+		ptr = ri.Hunk_Alloc(sizeof(*backEndData[i]) + sizeof(srfPoly_t) * r_maxPolys->integer + sizeof(polyVert_t) * r_maxPolyVerts->integer, h_low);
 
-	backEndData            = (backEndData_t *) ptr;
-	backEndData->polys     = (srfPoly_t *) ((char *) ptr + sizeof(*backEndData));
-	backEndData->polyVerts = (polyVert_t *) ((char *) ptr + sizeof(*backEndData) + sizeof(srfPoly_t) * r_maxPolys->integer);
+		backEndData[i]            = (backEndData_t *) ptr;
+		backEndData[i]->polys     = (srfPoly_t *) ((char *) ptr + sizeof(*backEndData[i]));
+		backEndData[i]->polyVerts = (polyVert_t *) ((char *) ptr + sizeof(*backEndData[i]) + sizeof(srfPoly_t) * r_maxPolys->integer);
+	}
 
 	R_InitNextFrame();
 
@@ -1322,6 +1537,9 @@ void R_Init(void)
 
 	R_InitGamma();
 
+	// before the images, R_LoadCacheImages decodes on the job threads
+	R_InitJobs();
+
 	R_InitImages();
 
 	R_InitShaders();
@@ -1340,6 +1558,8 @@ void R_Init(void)
 		Ren_Print("R_Init: glGetError() = 0x%x\n", err);
 	}
 
+	R_InitRenderThread();
+
 	Ren_Print("--------------------------------\n");
 }
 
@@ -1360,6 +1580,8 @@ void RE_Shutdown(qboolean destroyWindow)
 	Ren_Print("RE_Shutdown( %i )\n", destroyWindow);
 
 	ri.Cmd_RemoveSystemCommand("imagelist");
+	ri.Cmd_RemoveSystemCommand("imagebench");
+	ri.Cmd_RemoveSystemCommand("mdmskinbench");
 	ri.Cmd_RemoveSystemCommand("shaderlist");
 	ri.Cmd_RemoveSystemCommand("skinlist");
 	ri.Cmd_RemoveSystemCommand("modellist");
@@ -1368,6 +1590,16 @@ void RE_Shutdown(qboolean destroyWindow)
 	ri.Cmd_RemoveSystemCommand("gfxinfo");
 	ri.Cmd_RemoveSystemCommand("taginfo");
 
+	// the back end has to be idle and the GL context back on this thread
+	R_ShutdownRenderThread();
+
+	R_ShutdownVideoFrame();
+
+	// images queued when an error interrupted a map load
+	R_DiscardImageBatch();
+
+	R_ShutdownImageCache();
+
 	// keep a backup of the current images if possible
 	// clean out any remaining unused media from the last backup
 	R_PurgeCache();
@@ -1398,6 +1630,8 @@ void RE_Shutdown(qboolean destroyWindow)
 
 	R_DoneFreeType();
 
+	R_ShutdownJobs();
+
 	R_ShutdownGamma();
 
 	R_ShutdownFBO();
@@ -1527,6 +1761,8 @@ refexport_t *GetRefAPI(int apiVersion, refimport_t *rimp)
 
 	re.Finish              = RE_Finish;
 	re.TakeVideoFrame      = RE_TakeVideoFrame;
+	re.FinishVideoFrames   = RE_FinishVideoFrames;
+	re.SaveJPGToBuffer     = RE_SaveJPGToBuffer;
 	re.InitOpenGL          = RE_InitOpenGl;
 	re.InitOpenGLSubSystem = RE_InitOpenGlSubsystems;
 
@@ -0,0 +1,248 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012-2024 ET:Legacy team <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file renderer/tr_job.c
+ * @brief Small worker pool for the front end
+ *
+ * R_RunJobs hands out job indexes to the worker threads and to the calling
+ * thread and returns once all of them are done. Jobs must only read shared
+ * renderer state and write to their own slot of the job data, anything else
+ * has to be merged by the caller afterwards.
+ */
+
+#include "tr_local.h"
+
+/**
+ * @struct jobPool_t
+ * @brief
+ */
+typedef struct
+{
+	void *threads[MAX_JOB_THREADS];
+	int numThreads;
+
+	void *mutex;                    ///< protects nextJob
+	void *wake;                     ///< posted once per worker for each batch
+	void *done;                     ///< posted by each worker when the batch is drained
+
+	void (*function)(int job, void *data);
+	void *data;
+	int numJobs;
+	int nextJob;
+
+	qboolean quit;
+} jobPool_t;
+
+static jobPool_t jobPool;
+
+/**
+ * @brief Runs jobs of the current batch until none are left
+ */
+static void R_WorkJobs(void)
+{
+	int job;
+
+	while (1)
+	{
+		ri.Sys_LockMutex(jobPool.mutex);
+		job = jobPool.nextJob;
+		if (job < jobPool.numJobs)
+		{
+			jobPool.nextJob++;
+		}
+		ri.Sys_UnlockMutex(jobPool.mutex);
+
+		if (job >= jobPool.numJobs)
+		{
+			return;
+		}
+
+		jobPool.function(job, jobPool.data);
+	}
+}
+
+/**
+ * @brief R_JobThread
+ * @param arg - unused
+ */
+static void R_JobThread(void *arg)
+{
+	while (1)
+	{
+		ri.Sys_SemaphoreWait(jobPool.wake);
+
+		if (jobPool.quit)
+		{
+			return;
+		}
+
+		R_WorkJobs();
+
+		ri.Sys_SemaphorePost(jobPool.done);
+	}
+}
+
+/**
+ * @brief Starts r_frontEndThreads worker threads
+ */
+void R_InitJobs(void)
+{
+	int numThreads = r_frontEndThreads->integer;
+
+	Com_Memset(&jobPool, 0, sizeof(jobPool));
+
+	if (numThreads <= 0)
+	{
+		return;
+	}
+
+	// the calling thread works on the jobs as well
+	if (numThreads > ri.Sys_NumCPUs() - 1)
+	{
+		numThreads = ri.Sys_NumCPUs() - 1;
+	}
+	if (numThreads > MAX_JOB_THREADS)
+	{
+		numThreads = MAX_JOB_THREADS;
+	}
+	if (numThreads <= 0)
+	{
+		Ren_Print("R_InitJobs: single processor, front end jobs disabled\n");
+		return;
+	}
+
+	jobPool.mutex = ri.Sys_CreateMutex();
+	jobPool.wake  = ri.Sys_CreateSemaphore(0);
+	jobPool.done  = ri.Sys_CreateSemaphore(0);
+
+	if (!jobPool.mutex || !jobPool.wake || !jobPool.done)
+	{
+		Ren_Warning("R_InitJobs: failed to create synchronization objects\n");
+		R_ShutdownJobs();
+		return;
+	}
+
+	for (jobPool.numThreads = 0; jobPool.numThreads < numThreads; jobPool.numThreads++)
+	{
+		jobPool.threads[jobPool.numThreads] = ri.Sys_CreateThread(R_JobThread, NULL);
+
+		if (!jobPool.threads[jobPool.numThreads])
+		{
+			Ren_Warning("R_InitJobs: failed to create worker thread %i\n", jobPool.numThreads);
+			break;
+		}
+	}
+
+	Ren_Print("Front end jobs: %i worker thread%s\n", jobPool.numThreads, jobPool.numThreads == 1 ? "" : "s");
+}
+
+/**
+ * @brief Stops the worker threads
+ */
+void R_ShutdownJobs(void)
+{
+	int i;
+
+	jobPool.quit = qtrue;
+
+	for (i = 0; i < jobPool.numThreads; i++)
+	{
+		ri.Sys_SemaphorePost(jobPool.wake);
+	}
+
+	for (i = 0; i < jobPool.numThreads; i++)
+	{
+		ri.Sys_JoinThread(jobPool.threads[i]);
+	}
+
+	if (jobPool.mutex)
+	{
+		ri.Sys_DestroyMutex(jobPool.mutex);
+	}
+	if (jobPool.wake)
+	{
+		ri.Sys_DestroySemaphore(jobPool.wake);
+	}
+	if (jobPool.done)
+	{
+		ri.Sys_DestroySemaphore(jobPool.done);
+	}
+
+	Com_Memset(&jobPool, 0, sizeof(jobPool));
+}
+
+/**
+ * @brief R_NumJobThreads
+ * @return Number of worker threads, 0 when jobs run on the calling thread only
+ */
+int R_NumJobThreads(void)
+{
+	return jobPool.numThreads;
+}
+
+/**
+ * @brief Calls function(job, data) for job = 0 .. numJobs - 1 and waits for all of them
+ * @param[in] function
+ * @param[in] numJobs
+ * @param[in,out] data
+ *
+ * @note Not reentrant, jobs must not call R_RunJobs themselves
+ */
+void R_RunJobs(void (*function)(int job, void *data), int numJobs, void *data)
+{
+	int i;
+
+	if (!jobPool.numThreads || numJobs < 2)
+	{
+		for (i = 0; i < numJobs; i++)
+		{
+			function(i, data);
+		}
+		return;
+	}
+
+	jobPool.function = function;
+	jobPool.data     = data;
+	jobPool.numJobs  = numJobs;
+	jobPool.nextJob  = 0;
+
+	for (i = 0; i < jobPool.numThreads; i++)
+	{
+		ri.Sys_SemaphorePost(jobPool.wake);
+	}
+
+	R_WorkJobs();
+
+	for (i = 0; i < jobPool.numThreads; i++)
+	{
+		ri.Sys_SemaphoreWait(jobPool.done);
+	}
+}
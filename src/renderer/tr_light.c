@@ -151,19 +151,19 @@ void R_DlightBmodel(bmodel_t *bmodel)
 
 		if (*surf->data == SF_FACE)
 		{
-			((srfSurfaceFace_t *)surf->data)->dlightBits = mask;
+			((srfSurfaceFace_t *)surf->data)->dlightBits[tr.smpFrame] = mask;
 		}
 		else if (*surf->data == SF_GRID)
 		{
-			((srfGridMesh_t *)surf->data)->dlightBits = mask;
+			((srfGridMesh_t *)surf->data)->dlightBits[tr.smpFrame] = mask;
 		}
 		else if (*surf->data == SF_TRIANGLES)
 		{
-			((srfTriangles2_t *)surf->data)->dlightBits = mask;
+			((srfTriangles2_t *)surf->data)->dlightBits[tr.smpFrame] = mask;
 		}
 		else if (*surf->data == SF_FOLIAGE)
 		{
-			((srfFoliage_t *)surf->data)->dlightBits = mask;
+			((srfFoliage_t *)surf->data)->dlightBits[tr.smpFrame] = mask;
 		}
 	}
 }
@@ -768,6 +768,8 @@ typedef struct drawSurf_s
 	surfaceType_t *surface;             ///< any of surface*_t
 } drawSurf_t;
 
+#define SMP_FRAMES          2           ///< frames in flight with r_smp, see backEndData
+
 #define MAX_FACE_POINTS     1024
 
 #define MAX_PATCH_SIZE      32          ///< max dimensions of a patch mesh in map file
@@ -860,8 +862,8 @@ typedef struct srfGeneric_s
 	float radius;
 	cplane_t plane;
 
-	/// dynamic lighting information
-	int dlightBits;
+	/// dynamic lighting information, indexed by tr.smpFrame / backEnd.smpFrame
+	int dlightBits[SMP_FRAMES];
 } srfGeneric_t;
 
 /**
@@ -880,7 +882,7 @@ typedef struct srfGridMesh_s
 	cplane_t plane;
 
 	/// dynamic lighting information
-	int dlightBits;
+	int dlightBits[SMP_FRAMES];
 
 	// lod information, which may be different
 	// than the culling information to allow for
@@ -915,7 +917,7 @@ typedef struct srfSurfaceFace_s
 	cplane_t plane;
 
 	/// dynamic lighting information
-	int dlightBits;
+	int dlightBits[SMP_FRAMES];
 
 	// triangle definitions (no normals at points)
 	int numPoints;
@@ -941,7 +943,7 @@ typedef struct srfTriangles_s
 	cplane_t plane;
 
 	/// dynamic lighting information
-	int dlightBits;
+	int dlightBits[SMP_FRAMES];
 
 	// triangle definitions
 	int numIndexes;
@@ -967,7 +969,7 @@ typedef struct srfTriangles2_s
 	cplane_t plane;
 
 	/// dynamic lighting information
-	int dlightBits;
+	int dlightBits[SMP_FRAMES];
 
 	// triangle definitions
 	int numIndexes;
@@ -1010,7 +1012,7 @@ typedef struct
 	cplane_t plane;
 
 	/// dynamic lighting information
-	int dlightBits;
+	int dlightBits[SMP_FRAMES];
 
 	// triangle definitions
 	int numIndexes;
@@ -1124,6 +1126,22 @@ typedef struct bmodel_s
 /// optimization
 #define WORLD_MAX_SKY_NODES 32
 
+/**
+ * @struct worldSurfRef_t
+ * @brief A world surface reached by the BSP walk, culled later by front end jobs
+ */
+typedef struct
+{
+	msurface_t *surf;
+	int dlightBits;
+	int decalBits;
+
+	// filled in by the job
+	qboolean culled;
+	int frontFace;
+	int dlightMap;
+} worldSurfRef_t;
+
 /**
  * @struct world_t
  * @brief
@@ -1157,6 +1175,8 @@ typedef struct
 	int nummarksurfaces;
 	msurface_t **marksurfaces;
 
+	worldSurfRef_t *surfRefs;       ///< numsurfaces entries, only allocated when front end jobs are enabled
+
 	int numfogs;
 	fog_t *fogs;
 	int globalFog;                  ///< index of global fog
@@ -1350,6 +1370,10 @@ typedef struct
 	int c_flareTests;
 	int c_flareRenders;
 
+	int c_boneCalcs;        ///< MDM bones built by R_CalcBone/R_CalcBoneLerp
+	int c_boneCacheHits;    ///< entities starting from bones of another entity in the same frame
+	int c_boneCacheMisses;
+
 	int msec;               ///< total msec for backend run
 } backEndCounters_t;
 
@@ -1372,6 +1396,9 @@ typedef struct
 	byte color2D[4];
 	qboolean vertexes2D;            ///< shader needs to be finished
 	trRefEntity_t entity2D;         ///< currentEntity will point at this when doing 2D rendering
+
+	qboolean smpActive;             ///< running on the r_smp render thread, see R_InitRenderThread
+	int smpFrame;                   ///< backEndData being executed, see RB_ExecuteRenderCommands
 } backEndState_t;
 
 /**
@@ -1393,6 +1420,8 @@ typedef struct
 
 	int frameSceneNum;                          ///< zeroed at RE_BeginFrame
 
+	int smpFrame;                               ///< backEndData the front end is filling, toggled every frame with r_smp
+
 	qboolean worldMapLoaded;
 	world_t *world;
 	char *worldDir;                             ///< for referencing external lightmaps
@@ -1593,6 +1622,10 @@ void R_SetColorMappings(void);
 void R_GammaCorrect(byte *buffer, int bufSize);
 
 void R_ImageList_f(void);
+void R_ImageBench_f(void);
+void R_BeginImageBatch(void);
+void R_EndImageBatch(void);
+void R_DiscardImageBatch(void);
 void R_SkinList_f(void);
 
 byte *RB_ReadPixels(int x, int y, int width, int height, size_t *offset, int *padlen);
@@ -1609,6 +1642,10 @@ skin_t *R_GetSkinByHandle(qhandle_t hSkin);
 void R_DebugText(const vec3_t org, float r, float g, float b, const char *text, qboolean neverOcclude);
 
 const void *RB_TakeVideoFrameCmd(const void *data);
+void R_RequestVideoFrame(int width, int height, byte *captureBuffer);
+void R_WriteVideoFrame(void);
+void R_ShutdownVideoFrame(void);
+void RE_FinishVideoFrames(void);
 
 // tr_shader.c
 
@@ -1656,9 +1693,9 @@ typedef struct
 typedef struct shaderCommands_s
 {
 	glIndex_t indexes[SHADER_MAX_INDEXES];
-	vec4_t normal[SHADER_MAX_INDEXES];
+	vec4_t normal[SHADER_MAX_INDEXES] QALIGN(16);
 	color4ub_t vertexColors[SHADER_MAX_INDEXES];
-	vec4_t xyz[SHADER_MAX_INDEXES];
+	vec4_t xyz[SHADER_MAX_INDEXES] QALIGN(16);
 	vec2_t texCoords[SHADER_MAX_INDEXES][2];
 
 	stageVars_t svars;
@@ -1709,6 +1746,19 @@ WORLD MAP
 void R_AddBrushModelSurfaces(trRefEntity_t *ent);
 void R_AddWorldSurfaces(void);
 
+/*
+============================================================
+FRONT END JOBS
+============================================================
+*/
+
+#define MAX_JOB_THREADS 8
+
+void R_InitJobs(void);
+void R_ShutdownJobs(void);
+int R_NumJobThreads(void);
+void R_RunJobs(void (*function)(int job, void *data), int numJobs, void *data);
+
 /*
 ============================================================
 FLARES
@@ -1834,6 +1884,7 @@ int R_GetBoneTag(orientation_t *outTag, mdsHeader_t *mds, int startTagIndex, con
 // MDM / MDX
 void R_MDM_AddAnimSurfaces(trRefEntity_t *ent);
 void RB_MDM_SurfaceAnim(mdmSurface_t *surface);
+void R_MDM_SkinBench_f(void);
 int R_MDM_GetBoneTag(orientation_t *outTag, mdmHeader_t *mdm, int startTagIndex, const refEntity_t *refent, const char *tagName);
 
 /*
@@ -2113,13 +2164,20 @@ typedef struct
 	renderCommandList_t commands;
 } backEndData_t;
 
-extern backEndData_t *backEndData;
+extern backEndData_t *backEndData[SMP_FRAMES];  ///< only [0] is allocated without r_smp
 
 void *R_GetCommandBuffer(int bytes);
 void RB_ExecuteRenderCommands(const void *data);
 
 void R_IssuePendingRenderCommands(void);
 
+void R_InitRenderThread(void);
+void R_ShutdownRenderThread(void);
+void R_SyncRenderThread(void);
+void R_SyncRenderThreadAfterIssue(void);
+void R_LockBones(void);
+void R_UnlockBones(void);
+
 void R_AddDrawSurfCmd(drawSurf_t *drawSurfs, int numDrawSurfs);
 
 void RE_SetColor(const float *rgba);
@@ -2328,6 +2386,7 @@ extern int skyboxportal;
 void *R_Hunk_Begin(void);
 void R_Hunk_End(void);
 void R_FreeImageBuffer(void);
+void R_ShutdownImageCache(void);
 
 qboolean R_inPVS(const vec3_t p1, const vec3_t p2);
 
@@ -2343,6 +2402,11 @@ extern cvar_t *r_textureBits;           ///< number of desired texture bits
                                         ///< 32 = use 32-bit textures
                                         ///< all else = error
 
+extern cvar_t *r_imageCache;            ///< store final mip chains of pk3 images on disk
+extern cvar_t *r_imageCacheSize;        ///< size limit of the image cache in MB
+extern cvar_t *r_frontEndThreads;       ///< worker threads for world surface culling, 0 = off
+extern cvar_t *r_smp;                   ///< run the back end on its own thread
+
 extern cvar_t *r_extMaxAnisotropy;      ///< FIXME: not used in GLES ! move it ?
                                         ///< FIXME: "extern int      maxAnisotropy" founded
 
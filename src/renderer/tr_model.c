@@ -1846,6 +1846,9 @@ static qboolean R_LoadMDX(model_t *mod, void *buffer, const char *name)
  */
 void RE_BeginRegistration(glconfig_t *glconfigOut)
 {
+	// backEndData is about to be freed
+	R_ShutdownRenderThread();
+
 	ri.Hunk_Clear();    // (SA) MEM NOTE: not in missionpack
 
 	R_Init();
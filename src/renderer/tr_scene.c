@@ -66,7 +66,18 @@ int skyboxportal;
  */
 void R_InitNextFrame(void)
 {
-	backEndData->commands.used = 0;
+	if (r_smp->integer)
+	{
+		// use the other buffers next frame, because the render thread
+		// may still be rendering into the current ones
+		tr.smpFrame ^= 1;
+	}
+	else
+	{
+		tr.smpFrame = 0;
+	}
+
+	backEndData[tr.smpFrame]->commands.used = 0;
 
 	r_firstSceneDrawSurf = 0;
 
@@ -162,11 +173,11 @@ void RE_AddPolyToScene(qhandle_t hShader, int numVerts, const polyVert_t *verts)
 		return;
 	}
 
-	poly              = &backEndData->polys[r_numpolys];
+	poly              = &backEndData[tr.smpFrame]->polys[r_numpolys];
 	poly->surfaceType = SF_POLY;
 	poly->hShader     = hShader;
 	poly->numVerts    = numVerts;
-	poly->verts       = &backEndData->polyVerts[r_numpolyverts];
+	poly->verts       = &backEndData[tr.smpFrame]->polyVerts[r_numpolyverts];
 
 	Com_Memcpy(poly->verts, verts, numVerts * sizeof(*verts));
 
@@ -250,11 +261,11 @@ void RE_AddPolysToScene(qhandle_t hShader, int numVerts, const polyVert_t *verts
 			return;
 		}
 
-		poly              = &backEndData->polys[r_numpolys];
+		poly              = &backEndData[tr.smpFrame]->polys[r_numpolys];
 		poly->surfaceType = SF_POLY;
 		poly->hShader     = hShader;
 		poly->numVerts    = numVerts;
-		poly->verts       = &backEndData->polyVerts[r_numpolyverts];
+		poly->verts       = &backEndData[tr.smpFrame]->polyVerts[r_numpolyverts];
 
 		Com_Memcpy(poly->verts, &verts[numVerts * j], numVerts * sizeof(*verts));
 
@@ -340,7 +351,7 @@ void RE_AddPolyBufferToScene(polyBuffer_t *pPolyBuffer)
 		return;
 	}
 
-	pPolySurf = &backEndData->polybuffers[r_numpolybuffers];
+	pPolySurf = &backEndData[tr.smpFrame]->polybuffers[r_numpolybuffers];
 	r_numpolybuffers++;
 
 	pPolySurf->surfaceType = SF_POLYBUFFER;
@@ -411,8 +422,8 @@ void RE_AddRefEntityToScene(const refEntity_t *ent)
 		Ren_Drop("RE_AddRefEntityToScene: bad reType %i", ent->reType);
 	}
 
-	backEndData->entities[r_numentities].e                  = *ent;
-	backEndData->entities[r_numentities].lightingCalculated = qfalse;
+	backEndData[tr.smpFrame]->entities[r_numentities].e                  = *ent;
+	backEndData[tr.smpFrame]->entities[r_numentities].lightingCalculated = qfalse;
 
 	r_numentities++;
 
@@ -457,7 +468,7 @@ void RE_AddLightToScene(const vec3_t org, float radius, float intensity, float r
 	}
 
 	// set up a new dlight
-	dl = &backEndData->dlights[r_numdlights++];
+	dl = &backEndData[tr.smpFrame]->dlights[r_numdlights++];
 	VectorCopy(org, dl->origin);
 	VectorCopy(org, dl->transformed);
 	dl->radius             = radius;
@@ -505,7 +516,7 @@ void RE_AddCoronaToScene(const vec3_t org, float r, float g, float b, float scal
 		return;
 	}
 
-	cor = &backEndData->coronas[r_numcoronas++];
+	cor = &backEndData[tr.smpFrame]->coronas[r_numcoronas++];
 	VectorCopy(org, cor->origin);
 	cor->color[0] = r;
 	cor->color[1] = g;
@@ -597,29 +608,29 @@ void RE_RenderScene(const refdef_t *fd)
 	tr.refdef.floatTime = tr.refdef.time * 0.001;
 
 	tr.refdef.numDrawSurfs = r_firstSceneDrawSurf;
-	tr.refdef.drawSurfs    = backEndData->drawSurfs;
+	tr.refdef.drawSurfs    = backEndData[tr.smpFrame]->drawSurfs;
 
 	tr.refdef.num_entities = r_numentities - r_firstSceneEntity;
-	tr.refdef.entities     = &backEndData->entities[r_firstSceneEntity];
+	tr.refdef.entities     = &backEndData[tr.smpFrame]->entities[r_firstSceneEntity];
 
 	tr.refdef.num_dlights = r_numdlights - r_firstSceneDlight;
-	tr.refdef.dlights     = &backEndData->dlights[r_firstSceneDlight];
+	tr.refdef.dlights     = &backEndData[tr.smpFrame]->dlights[r_firstSceneDlight];
 	tr.refdef.dlightBits  = 0;
 
 	tr.refdef.num_coronas = r_numcoronas - r_firstSceneCorona;
-	tr.refdef.coronas     = &backEndData->coronas[r_firstSceneCorona];
+	tr.refdef.coronas     = &backEndData[tr.smpFrame]->coronas[r_firstSceneCorona];
 
 	tr.refdef.numPolys = r_numpolys - r_firstScenePoly;
-	tr.refdef.polys    = &backEndData->polys[r_firstScenePoly];
+	tr.refdef.polys    = &backEndData[tr.smpFrame]->polys[r_firstScenePoly];
 
 	tr.refdef.numPolyBuffers = r_numpolybuffers - r_firstScenePolybuffer;
-	tr.refdef.polybuffers    = &backEndData->polybuffers[r_firstScenePolybuffer];
+	tr.refdef.polybuffers    = &backEndData[tr.smpFrame]->polybuffers[r_firstScenePolybuffer];
 
 	tr.refdef.numDecalProjectors = r_numDecalProjectors - r_firstSceneDecalProjector;
-	tr.refdef.decalProjectors    = &backEndData->decalProjectors[r_firstSceneDecalProjector];
+	tr.refdef.decalProjectors    = &backEndData[tr.smpFrame]->decalProjectors[r_firstSceneDecalProjector];
 
 	tr.refdef.numDecals = 0;
-	tr.refdef.decals    = &backEndData->decals[r_firstSceneDecal];
+	tr.refdef.decals    = &backEndData[tr.smpFrame]->decals[r_firstSceneDecal];
 
 	// a single frame may have multiple scenes draw inside it --
 	// a 3D game view, 3D status bar renderings, 3D menus, etc.
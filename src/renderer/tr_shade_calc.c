@@ -34,6 +34,10 @@
 
 #include "tr_local.h"
 
+#ifdef ETL_SSE
+#include <emmintrin.h>
+#endif
+
 #define WAVEVALUE(table, base, amplitude, phase, freq)  ((base) + table[(int64_t)((((phase) + tess.shaderTime * (freq)) *FUNCTABLE_SIZE)) & FUNCTABLE_MASK] * (amplitude))
 
 /**
@@ -129,6 +133,21 @@ DEFORMATIONS
 ====================================================================
 */
 
+#ifdef ETL_SSE
+/**
+ * @brief Adds normal * scale to a tess.xyz row, leaving its w component untouched
+ * @param[in,out] xyz
+ * @param[in] normal
+ * @param[in] scale
+ */
+static ID_INLINE void RB_SSE_VertexMA(float *xyz, const float *normal, float scale)
+{
+	__m128 s = _mm_set_ps(0.f, scale, scale, scale);
+
+	_mm_storeu_ps(xyz, _mm_add_ps(_mm_loadu_ps(xyz), _mm_mul_ps(_mm_loadu_ps(normal), s)));
+}
+#endif
+
 /**
  * @brief RB_CalcDeformVertexes
  * @param[in,out] ds
@@ -136,7 +155,9 @@ DEFORMATIONS
 void RB_CalcDeformVertexes(deformStage_t *ds)
 {
 	int    i;
+#ifndef ETL_SSE
 	vec3_t offset;
+#endif
 	float  scale;
 	float  *xyz    = ( float * ) tess.xyz;
 	float  *normal = ( float * ) tess.normal;
@@ -208,11 +229,15 @@ void RB_CalcDeformVertexes(deformStage_t *ds)
 
 		for (i = 0; i < tess.numVertexes; i++, xyz += 4, normal += 4)
 		{
+#ifdef ETL_SSE
+			RB_SSE_VertexMA(xyz, normal, scale);
+#else
 			VectorScale(normal, scale, offset);
 
 			xyz[0] += offset[0];
 			xyz[1] += offset[1];
 			xyz[2] += offset[2];
+#endif
 		}
 	}
 	else
@@ -230,11 +255,15 @@ void RB_CalcDeformVertexes(deformStage_t *ds)
 			                  ds->deformationWave.phase + off,
 			                  ds->deformationWave.frequency);
 
+#ifdef ETL_SSE
+			RB_SSE_VertexMA(xyz, normal, scale);
+#else
 			VectorScale(normal, scale, offset);
 
 			xyz[0] += offset[0];
 			xyz[1] += offset[1];
 			xyz[2] += offset[2];
+#endif
 		}
 	}
 }
@@ -290,9 +319,13 @@ void RB_CalcBulgeVertexes(deformStage_t *ds)
 		off   = (FUNCTABLE_SIZE / M_TAU_F) * (st[0] * ds->bulgeWidth + now);
 		scale = tr.sinTable[off & FUNCTABLE_MASK] * ds->bulgeHeight;
 
+#ifdef ETL_SSE
+		RB_SSE_VertexMA(xyz, normal, scale);
+#else
 		xyz[0] += normal[0] * scale;
 		xyz[1] += normal[1] * scale;
 		xyz[2] += normal[2] * scale;
+#endif
 	}
 }
 
@@ -318,10 +351,21 @@ void RB_CalcMoveVertexes(deformStage_t *ds)
 	VectorScale(ds->moveVector, scale, offset);
 
 	xyz = ( float * ) tess.xyz;
+#ifdef ETL_SSE
+	{
+		__m128 vOffset = _mm_set_ps(0.f, offset[2], offset[1], offset[0]);
+
+		for (i = 0; i < tess.numVertexes; i++, xyz += 4)
+		{
+			_mm_storeu_ps(xyz, _mm_add_ps(_mm_loadu_ps(xyz), vOffset));
+		}
+	}
+#else
 	for (i = 0; i < tess.numVertexes; i++, xyz += 4)
 	{
 		VectorAdd(xyz, offset, xyz);
 	}
+#endif
 }
 
 /**
@@ -677,38 +721,53 @@ COLORS
 */
 
 /**
- * @brief RB_CalcColorFromEntity
- * @param[in,out] colors
+ * @brief Writes the same packed RGBA value to every vertex color
+ * @param[out] colors
+ * @param[in] c
  */
-void RB_CalcColorFromEntity(unsigned char *colors)
+static void RB_FillColors(unsigned char *colors, int c)
 {
-	int i;
+	int i        = 0;
 	int *pColors = ( int * ) colors;
-	int c;
 
-	if (!backEnd.currentEntity)
+#ifdef ETL_SSE
 	{
-		return;
-	}
+		const __m128i vColor = _mm_set1_epi32(c);
 
-	c = *( int * ) backEnd.currentEntity->e.shaderRGBA;
+		for ( ; i + 4 <= tess.numVertexes; i += 4, pColors += 4)
+		{
+			_mm_storeu_si128(( __m128i * ) pColors, vColor);
+		}
+	}
+#endif
 
-	for (i = 0; i < tess.numVertexes; i++, pColors++)
+	for ( ; i < tess.numVertexes; i++, pColors++)
 	{
 		*pColors = c;
 	}
 }
 
+/**
+ * @brief RB_CalcColorFromEntity
+ * @param[in,out] colors
+ */
+void RB_CalcColorFromEntity(unsigned char *colors)
+{
+	if (!backEnd.currentEntity)
+	{
+		return;
+	}
+
+	RB_FillColors(colors, *( int * ) backEnd.currentEntity->e.shaderRGBA);
+}
+
 /**
  * @brief RB_CalcColorFromOneMinusEntity
  * @param[in,out] colors
  */
 void RB_CalcColorFromOneMinusEntity(unsigned char *colors)
 {
-	int           i;
-	int           *pColors = ( int * ) colors;
 	unsigned char invModulate[4];
-	int           c;
 
 	if (!backEnd.currentEntity)
 	{
@@ -720,12 +779,7 @@ void RB_CalcColorFromOneMinusEntity(unsigned char *colors)
 	invModulate[2] = 255 - backEnd.currentEntity->e.shaderRGBA[2];
 	invModulate[3] = 255 - backEnd.currentEntity->e.shaderRGBA[3];  // this trashes alpha, but the AGEN block fixes it
 
-	c = *( int * ) invModulate;
-
-	for (i = 0; i < tess.numVertexes; i++, pColors++)
-	{
-		*pColors = c;
-	}
+	RB_FillColors(colors, *( int * ) invModulate);
 }
 
 /**
@@ -777,10 +831,8 @@ void RB_CalcAlphaFromOneMinusEntity(unsigned char *colors)
  */
 void RB_CalcWaveColor(const waveForm_t *wf, unsigned char *colors)
 {
-	int   i;
 	int   v;
 	float glow;
-	int   *iColors = ( int * ) colors;
 	byte  color[4];
 
 	if (wf->func == GF_NOISE)
@@ -804,12 +856,8 @@ void RB_CalcWaveColor(const waveForm_t *wf, unsigned char *colors)
 	v        = (int)(255 * glow);
 	color[0] = color[1] = color[2] = v;
 	color[3] = 255;
-	v        = *(int *)color;
 
-	for (i = 0; i < tess.numVertexes; i++, iColors++)
-	{
-		*iColors = v;
-	}
+	RB_FillColors(colors, *(int *)color);
 }
 
 /**
@@ -1051,8 +1099,46 @@ void RB_CalcFogTexCoords(float *texCoords)
 		// see if the viewpoint is outside
 		eyeInside = eyeT < 0 ? qfalse : qtrue;
 
+		i = 0;
+		v = tess.xyz[0];
+#ifdef ETL_SSE
+		// four vertexes per iteration, same operation order as the loop below
+		{
+			const __m128 dist0  = _mm_set1_ps(fogDistanceVector[0]);
+			const __m128 dist1  = _mm_set1_ps(fogDistanceVector[1]);
+			const __m128 dist2  = _mm_set1_ps(fogDistanceVector[2]);
+			const __m128 dist3  = _mm_set1_ps(fogDistanceVector[3]);
+			const __m128 depth0 = _mm_set1_ps(fogDepthVector[0]);
+			const __m128 depth1 = _mm_set1_ps(fogDepthVector[1]);
+			const __m128 depth2 = _mm_set1_ps(fogDepthVector[2]);
+			const __m128 depth3 = _mm_set1_ps(fogDepthVector[3]);
+			const __m128 eye    = _mm_set1_ps(eyeT);
+			__m128       x, y, z, w, vs, vt;
+
+			for ( ; i + 4 <= tess.numVertexes; i += 4, v += 16, texCoords += 8)
+			{
+				x = _mm_loadu_ps(v);
+				y = _mm_loadu_ps(v + 4);
+				z = _mm_loadu_ps(v + 8);
+				w = _mm_loadu_ps(v + 12);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+
+				vs = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, dist0), _mm_mul_ps(y, dist1)), _mm_mul_ps(z, dist2)), dist3);
+				vt = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, depth0), _mm_mul_ps(y, depth1)), _mm_mul_ps(z, depth2)), depth3);
+
+				if (eyeInside)
+				{
+					vt = _mm_add_ps(vt, eye);
+				}
+
+				_mm_storeu_ps(texCoords, _mm_unpacklo_ps(vs, vt));
+				_mm_storeu_ps(texCoords + 4, _mm_unpackhi_ps(vs, vt));
+			}
+		}
+#endif
+
 		// calculate density for each point
-		for (i = 0, v = tess.xyz[0] ; i < tess.numVertexes; i++, v += 4)
+		for ( ; i < tess.numVertexes; i++, v += 4)
 		{
 			// calculate the length in fog
 			s = DotProduct(v, fogDistanceVector) + fogDistanceVector[3];
@@ -1073,8 +1159,35 @@ void RB_CalcFogTexCoords(float *texCoords)
 	// optimized for level-wide fogging
 	else
 	{
+		i = 0;
+		v = tess.xyz[0];
+#ifdef ETL_SSE
+		{
+			const __m128 dist0 = _mm_set1_ps(fogDistanceVector[0]);
+			const __m128 dist1 = _mm_set1_ps(fogDistanceVector[1]);
+			const __m128 dist2 = _mm_set1_ps(fogDistanceVector[2]);
+			const __m128 dist3 = _mm_set1_ps(fogDistanceVector[3]);
+			const __m128 one   = _mm_set1_ps(1.0f);
+			__m128       x, y, z, w, vs;
+
+			for ( ; i + 4 <= tess.numVertexes; i += 4, v += 16, texCoords += 8)
+			{
+				x = _mm_loadu_ps(v);
+				y = _mm_loadu_ps(v + 4);
+				z = _mm_loadu_ps(v + 8);
+				w = _mm_loadu_ps(v + 12);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+
+				vs = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, dist0), _mm_mul_ps(y, dist1)), _mm_mul_ps(z, dist2)), dist3);
+
+				_mm_storeu_ps(texCoords, _mm_unpacklo_ps(vs, one));
+				_mm_storeu_ps(texCoords + 4, _mm_unpackhi_ps(vs, one));
+			}
+		}
+#endif
+
 		// calculate density for each point
-		for (i = 0, v = tess.xyz[0]; i < tess.numVertexes; i++, v += 4)
+		for ( ; i < tess.numVertexes; i++, v += 4)
 		{
 			// calculate the length in fog (t is always 0 if eye is in fog)
 			texCoords[0] = DotProduct(v, fogDistanceVector) + fogDistanceVector[3];
@@ -1120,8 +1233,66 @@ void RB_CalcEnvironmentTexCoords(float *texCoords)
 	ia2[1] = backEnd.orientation.axis[1][2] * 0.5f;
 	ia2[2] = backEnd.orientation.axis[2][2] * 0.5f;
 
+	i = 0;
+#ifdef ETL_SSE
+	// four vertexes per iteration, same operation order as the loop below
+	// (Q_rsqrt is rsqrtss in SSE builds, so the results are identical)
+	{
+		const __m128 view0 = _mm_set1_ps(viewOrigin[0]);
+		const __m128 view1 = _mm_set1_ps(viewOrigin[1]);
+		const __m128 view2 = _mm_set1_ps(viewOrigin[2]);
+		const __m128 ia10  = _mm_set1_ps(ia1[0]);
+		const __m128 ia11  = _mm_set1_ps(ia1[1]);
+		const __m128 ia12  = _mm_set1_ps(ia1[2]);
+		const __m128 ia20  = _mm_set1_ps(ia2[0]);
+		const __m128 ia21  = _mm_set1_ps(ia2[1]);
+		const __m128 ia22  = _mm_set1_ps(ia2[2]);
+		const __m128 sAdj  = _mm_set1_ps(sAdjust);
+		const __m128 tAdj  = _mm_set1_ps(tAdjust);
+		const __m128 two   = _mm_set1_ps(2.0f);
+		__m128       x, y, z, w, nx, ny, nz, nw, il, d, rx, ry, rz, vs, vt;
+
+		for ( ; i + 4 <= tess.numVertexes; i += 4, v += 16, normal += 16, texCoords += 8)
+		{
+			x = _mm_loadu_ps(v);
+			y = _mm_loadu_ps(v + 4);
+			z = _mm_loadu_ps(v + 8);
+			w = _mm_loadu_ps(v + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+
+			nx = _mm_loadu_ps(normal);
+			ny = _mm_loadu_ps(normal + 4);
+			nz = _mm_loadu_ps(normal + 8);
+			nw = _mm_loadu_ps(normal + 12);
+			_MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+			// viewer
+			x = _mm_sub_ps(view0, x);
+			y = _mm_sub_ps(view1, y);
+			z = _mm_sub_ps(view2, z);
+
+			il = _mm_rsqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+			x  = _mm_mul_ps(x, il);
+			y  = _mm_mul_ps(y, il);
+			z  = _mm_mul_ps(z, il);
+
+			d = _mm_mul_ps(two, _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)));
+
+			rx = _mm_sub_ps(_mm_mul_ps(nx, d), x);
+			ry = _mm_sub_ps(_mm_mul_ps(ny, d), y);
+			rz = _mm_sub_ps(_mm_mul_ps(nz, d), z);
+
+			vs = _mm_add_ps(sAdj, _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, ia10), _mm_mul_ps(ry, ia11)), _mm_mul_ps(rz, ia12)));
+			vt = _mm_sub_ps(tAdj, _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, ia20), _mm_mul_ps(ry, ia21)), _mm_mul_ps(rz, ia22)));
+
+			_mm_storeu_ps(texCoords, _mm_unpacklo_ps(vs, vt));
+			_mm_storeu_ps(texCoords + 4, _mm_unpackhi_ps(vs, vt));
+		}
+	}
+#endif
+
 	// walk verts
-	for (i = 0; i < tess.numVertexes; i++, v += 4, normal += 4, texCoords += 2)
+	for ( ; i < tess.numVertexes; i++, v += 4, normal += 4, texCoords += 2)
 	{
 		VectorSubtract(viewOrigin, v, viewer);
 		VectorNormalizeFast(viewer);
@@ -1213,9 +1384,20 @@ void RB_CalcTurbulentTexCoords(const waveForm_t *wf, float *texCoords)
  */
 void RB_CalcScaleTexCoords(const float scale[2], float *texCoords)
 {
-	int i;
+	int i = 0;
 
-	for (i = 0; i < tess.numVertexes; i++, texCoords += 2)
+#ifdef ETL_SSE
+	{
+		const __m128 vScale = _mm_set_ps(scale[1], scale[0], scale[1], scale[0]);
+
+		for ( ; i + 2 <= tess.numVertexes; i += 2, texCoords += 4)
+		{
+			_mm_storeu_ps(texCoords, _mm_mul_ps(_mm_loadu_ps(texCoords), vScale));
+		}
+	}
+#endif
+
+	for ( ; i < tess.numVertexes; i++, texCoords += 2)
 	{
 		texCoords[0] *= scale[0];
 		texCoords[1] *= scale[1];
@@ -1253,10 +1435,29 @@ void RB_CalcScrollTexCoords(const float scrollSpeed[2], float *texCoords)
  */
 void RB_CalcTransformTexCoords(const texModInfo_t *tmi, float *texCoords)
 {
-	int   i;
+	int   i = 0;
 	float s, t;
 
-	for (i = 0; i < tess.numVertexes; i++, texCoords += 2)
+#ifdef ETL_SSE
+	// two vertexes per iteration
+	{
+		const __m128 m0    = _mm_set_ps(tmi->matrix[0][1], tmi->matrix[0][0], tmi->matrix[0][1], tmi->matrix[0][0]);
+		const __m128 m1    = _mm_set_ps(tmi->matrix[1][1], tmi->matrix[1][0], tmi->matrix[1][1], tmi->matrix[1][0]);
+		const __m128 trans = _mm_set_ps(tmi->translate[1], tmi->translate[0], tmi->translate[1], tmi->translate[0]);
+		__m128       st, vs, vt;
+
+		for ( ; i + 2 <= tess.numVertexes; i += 2, texCoords += 4)
+		{
+			st = _mm_loadu_ps(texCoords);
+			vs = _mm_shuffle_ps(st, st, _MM_SHUFFLE(2, 2, 0, 0));
+			vt = _mm_shuffle_ps(st, st, _MM_SHUFFLE(3, 3, 1, 1));
+
+			_mm_storeu_ps(texCoords, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vs, m0), _mm_mul_ps(vt, m1)), trans));
+		}
+	}
+#endif
+
+	for ( ; i < tess.numVertexes; i++, texCoords += 2)
 	{
 		s = texCoords[0];
 		t = texCoords[1];
@@ -2408,7 +2408,7 @@ static qboolean CollapseMultitexture(void)
  */
 static void FixRenderCommandList(int newShader)
 {
-	renderCommandList_t *cmdList = &backEndData->commands;
+	renderCommandList_t *cmdList = &backEndData[tr.smpFrame]->commands;
 
 	if (cmdList)
 	{
@@ -2499,6 +2499,9 @@ static void SortNewShader(void)
 	shader_t *newShader = tr.shaders[tr.numShaders - 1];
 	float    sort       = newShader->sort;
 
+	// the render thread reads sortedIndex through the queued draw surfaces
+	R_SyncRenderThread();
+
 	for (i = tr.numShaders - 2 ; i >= 0 ; i--)
 	{
 		if (tr.sortedShaders[i]->sort <= sort)
@@ -3405,6 +3408,9 @@ shader_t *R_FindShader(const char *name, int lightmapIndex, qboolean mipRawImage
 		}
 	}
 
+	// images get uploaded below and the sorted shader list changes
+	R_SyncRenderThread();
+
 	InitShader(strippedName, lightmapIndex);
 
 	// FIXME: set these "need" values apropriately
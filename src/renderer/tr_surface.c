@@ -370,7 +370,7 @@ void RB_SurfaceTriangles(srfTriangles_t *srf)
 	// moved before overflow so dlights work properly
 	RB_CHECKOVERFLOW(srf->numVerts, srf->numIndexes);
 
-	dlightBits       = srf->dlightBits;
+	dlightBits       = srf->dlightBits[backEnd.smpFrame];
 	tess.dlightBits |= dlightBits;
 
 	for (i = 0 ; i < srf->numIndexes ; i += 3)
@@ -467,7 +467,7 @@ void RB_SurfaceFoliage(srfFoliage_t *srf)
 	}
 
 	// set dlight bits
-	dlightBits       = srf->dlightBits;
+	dlightBits       = srf->dlightBits[backEnd.smpFrame];
 	tess.dlightBits |= dlightBits;
 
 	// iterate through origin list
@@ -1477,7 +1477,7 @@ void RB_SurfaceFace(srfSurfaceFace_t *surf)
 
 	RB_CHECKOVERFLOW(surf->numPoints, surf->numIndices);
 
-	dlightBits       = surf->dlightBits;
+	dlightBits       = surf->dlightBits[backEnd.smpFrame];
 	tess.dlightBits |= dlightBits;
 
 	indices = ( unsigned * )((( char * ) surf) + surf->ofsIndices);
@@ -1574,7 +1574,7 @@ void RB_SurfaceGrid(srfGridMesh_t *cv)
 	float         lodError;
 	int           lodWidth = 1, lodHeight;
 	int           numVertexes;
-	int           dlightBits = cv->dlightBits;
+	int           dlightBits = cv->dlightBits[backEnd.smpFrame];
 	qboolean      needsNormal;
 
 	tess.dlightBits |= dlightBits;
@@ -43,9 +43,10 @@
  * @param[in] surface
  * @param[in] shader
  * @param[out] frontFace
+ * @param[in,out] pc Counters to update, front end jobs pass their own
  * @return
  */
-static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *frontFace)
+static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *frontFace, frontEndCounters_t *pc)
 {
 	srfGeneric_t *gen;
 
@@ -101,7 +102,7 @@ static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *fro
 		{
 			if (d < -8.0f)
 			{
-				tr.pc.c_plane_cull_out++;
+				pc->c_plane_cull_out++;
 				return qtrue;
 			}
 		}
@@ -109,12 +110,12 @@ static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *fro
 		{
 			if (d > 8.0f)
 			{
-				tr.pc.c_plane_cull_out++;
+				pc->c_plane_cull_out++;
 				return qtrue;
 			}
 		}
 
-		tr.pc.c_plane_cull_in++;
+		pc->c_plane_cull_in++;
 	}
 
 	{
@@ -132,11 +133,11 @@ static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *fro
 
 		if (cull == CULL_OUT)
 		{
-			tr.pc.c_sphere_cull_out++;
+			pc->c_sphere_cull_out++;
 			return qtrue;
 		}
 
-		tr.pc.c_sphere_cull_in++;
+		pc->c_sphere_cull_in++;
 	}
 
 	// must be visible
@@ -150,11 +151,12 @@ static qboolean R_CullSurface(surfaceType_t *surface, shader_t *shader, int *fro
  *
  * @param[in] surface
  * @param[in] dlightBits
+ * @param[in,out] pc Counters to update, front end jobs pass their own
  * @return
  *
  * @todo Made this use generic surface
  */
-static int R_DlightSurface(msurface_t *surface, int dlightBits)
+static int R_DlightSurface(msurface_t *surface, int dlightBits, frontEndCounters_t *pc)
 {
 	int          i;
 	vec3_t       origin;
@@ -222,18 +224,36 @@ static int R_DlightSurface(msurface_t *surface, int dlightBits)
 	// set counters
 	if (dlightBits == 0)
 	{
-		tr.pc.c_dlightSurfacesCulled++;
+		pc->c_dlightSurfacesCulled++;
 	}
 	else
 	{
-		tr.pc.c_dlightSurfaces++;
+		pc->c_dlightSurfaces++;
 	}
 
 	// set surface dlight bits and return
-	gen->dlightBits = dlightBits;
+	gen->dlightBits[tr.smpFrame] = dlightBits;
 	return dlightBits;
 }
 
+/**
+ * @brief Projects the decals selected by decalBits onto a surface
+ * @param[in] surf
+ * @param[in] decalBits
+ */
+static void R_ProjectDecalsOntoSurface(msurface_t *surf, int decalBits)
+{
+	int i;
+
+	for (i = 0; i < tr.refdef.numDecalProjectors; i++)
+	{
+		if (decalBits & (1 << i))
+		{
+			R_ProjectDecalOntoSurface(&tr.refdef.decalProjectors[i], surf, tr.currentBModel);
+		}
+	}
+}
+
 /**
  * @brief R_AddWorldSurface
  * @param[in,out] surf
@@ -254,7 +274,7 @@ static void R_AddWorldSurface(msurface_t *surf, shader_t *shader, int dlightMap,
 	// FIXME: bmodel fog?
 
 	// try to cull before dlighting or adding
-	if (R_CullSurface(surf->data, shader, &frontFace))
+	if (R_CullSurface(surf->data, shader, &frontFace, &tr.pc))
 	{
 		return;
 	}
@@ -262,23 +282,14 @@ static void R_AddWorldSurface(msurface_t *surf, shader_t *shader, int dlightMap,
 	// check for dlighting
 	if (dlightMap)
 	{
-		dlightMap = R_DlightSurface(surf, dlightMap);
+		dlightMap = R_DlightSurface(surf, dlightMap, &tr.pc);
 		dlightMap = (dlightMap != 0);
 	}
 
 	// add decals
 	if (decalBits)
 	{
-		int i;
-
-		// project any decals
-		for (i = 0; i < tr.refdef.numDecalProjectors; i++)
-		{
-			if (decalBits & (1 << i))
-			{
-				R_ProjectDecalOntoSurface(&tr.refdef.decalProjectors[i], surf, tr.currentBModel);
-			}
-		}
+		R_ProjectDecalsOntoSurface(surf, decalBits);
 	}
 
 	R_AddDrawSurf(surf->data, shader, surf->fogIndex, frontFace, dlightMap);
@@ -429,6 +440,132 @@ void R_AddBrushModelSurfaces(trRefEntity_t *ent)
 =============================================================
 */
 
+#define WORLD_SURF_JOB_SIZE 128         ///< minimum number of surfaces per job
+#define MAX_WORLD_SURF_JOBS 64
+
+/**
+ * @struct worldSurfJobs_t
+ * @brief World surfaces queued by the BSP walk for front end jobs
+ *
+ * The walk stays on the main thread, it only records the first leaf that
+ * reaches each surface. The jobs cull and dlight the queued surfaces and the
+ * draw surfaces are added in queue order afterwards, so the draw surface list
+ * is the same as without jobs.
+ */
+typedef struct
+{
+	qboolean active;
+	int numRefs;
+	int jobSize;
+	frontEndCounters_t pc[MAX_WORLD_SURF_JOBS];
+} worldSurfJobs_t;
+
+static worldSurfJobs_t worldSurfJobs;
+
+/**
+ * @brief Queues a world surface for the culling jobs
+ * @param[in,out] surf
+ * @param[in] dlightBits
+ * @param[in] decalBits
+ */
+static void R_QueueWorldSurface(msurface_t *surf, int dlightBits, int decalBits)
+{
+	worldSurfRef_t *ref;
+
+	if (surf->viewCount == tr.viewCount)
+	{
+		return;     // already in this view
+	}
+	surf->viewCount = tr.viewCount;
+
+	ref             = &tr.world->surfRefs[worldSurfJobs.numRefs++];
+	ref->surf       = surf;
+	ref->dlightBits = dlightBits;
+	ref->decalBits  = decalBits;
+}
+
+/**
+ * @brief Culls and dlights one slice of the queued world surfaces
+ * @param[in] job
+ * @param[in,out] data
+ */
+static void R_CullWorldSurfacesJob(int job, void *data)
+{
+	worldSurfJobs_t    *jobs = (worldSurfJobs_t *)data;
+	frontEndCounters_t *pc   = &jobs->pc[job];
+	worldSurfRef_t     *ref  = tr.world->surfRefs + job * jobs->jobSize;
+	int                i, count;
+
+	count = jobs->numRefs - job * jobs->jobSize;
+	if (count > jobs->jobSize)
+	{
+		count = jobs->jobSize;
+	}
+
+	Com_Memset(pc, 0, sizeof(*pc));
+
+	for (i = 0; i < count; i++, ref++)
+	{
+		ref->culled = R_CullSurface(ref->surf->data, ref->surf->shader, &ref->frontFace, pc);
+
+		if (ref->culled)
+		{
+			continue;
+		}
+
+		ref->dlightMap = ref->dlightBits ? (R_DlightSurface(ref->surf, ref->dlightBits, pc) != 0) : 0;
+	}
+}
+
+/**
+ * @brief Runs the culling jobs over the queued world surfaces and adds the visible ones
+ */
+static void R_AddQueuedWorldSurfaces(void)
+{
+	worldSurfRef_t *ref;
+	int            i, numJobs;
+
+	if (!worldSurfJobs.numRefs)
+	{
+		return;
+	}
+
+	worldSurfJobs.jobSize = (worldSurfJobs.numRefs + MAX_WORLD_SURF_JOBS - 1) / MAX_WORLD_SURF_JOBS;
+	if (worldSurfJobs.jobSize < WORLD_SURF_JOB_SIZE)
+	{
+		worldSurfJobs.jobSize = WORLD_SURF_JOB_SIZE;
+	}
+	numJobs = (worldSurfJobs.numRefs + worldSurfJobs.jobSize - 1) / worldSurfJobs.jobSize;
+
+	R_RunJobs(R_CullWorldSurfacesJob, numJobs, &worldSurfJobs);
+
+	for (i = 0; i < numJobs; i++)
+	{
+		tr.pc.c_plane_cull_in        += worldSurfJobs.pc[i].c_plane_cull_in;
+		tr.pc.c_plane_cull_out       += worldSurfJobs.pc[i].c_plane_cull_out;
+		tr.pc.c_sphere_cull_in       += worldSurfJobs.pc[i].c_sphere_cull_in;
+		tr.pc.c_sphere_cull_out      += worldSurfJobs.pc[i].c_sphere_cull_out;
+		tr.pc.c_dlightSurfaces       += worldSurfJobs.pc[i].c_dlightSurfaces;
+		tr.pc.c_dlightSurfacesCulled += worldSurfJobs.pc[i].c_dlightSurfacesCulled;
+	}
+
+	// decals and draw surfaces in walk order
+	for (i = 0, ref = tr.world->surfRefs; i < worldSurfJobs.numRefs; i++, ref++)
+	{
+		if (ref->culled)
+		{
+			continue;
+		}
+
+		if (ref->decalBits)
+		{
+			R_ProjectDecalsOntoSurface(ref->surf, ref->decalBits);
+		}
+
+		R_AddDrawSurf(ref->surf->data, ref->surf->shader, ref->surf->fogIndex, ref->frontFace, ref->dlightMap);
+	}
+}
+
 /**
  * @brief Adds a leaf's drawsurfaces
  * @param[in] node
@@ -478,7 +615,14 @@ static void R_AddLeafSurfaces(mnode_t *node, int dlightBits, int decalBits)
 		// the surface may have already been added if it
 		// spans multiple leafs
 		surf = *mark;
-		R_AddWorldSurface(surf, surf->shader, dlightBits, decalBits);
+		if (worldSurfJobs.active)
+		{
+			R_QueueWorldSurface(surf, dlightBits, decalBits);
+		}
+		else
+		{
+			R_AddWorldSurface(surf, surf->shader, dlightBits, decalBits);
+		}
 		mark++;
 	}
 }
@@ -865,9 +1009,19 @@ void R_AddWorldSurfaces(void)
 		// determine which leaves are in the PVS / areamask
 		R_MarkLeaves();
 
+		// queue the surfaces for the front end jobs if they are enabled
+		worldSurfJobs.active  = (tr.world->surfRefs != NULL);
+		worldSurfJobs.numRefs = 0;
+
 		// perform frustum culling and add all the potentially visible surfaces
 		R_RecursiveWorldNode(tr.world->nodes, 255, tr.refdef.dlightBits, tr.refdef.decalBits);
 
+		if (worldSurfJobs.active)
+		{
+			R_AddQueuedWorldSurfaces();
+			worldSurfJobs.active = qfalse;
+		}
+
 		// add decal surfaces
 		R_AddDecalSurfaces(tr.world->bmodels);
 	}
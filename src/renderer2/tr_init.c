@@ -1960,6 +1960,7 @@ refexport_t * GetRefAPI(int apiVersion, refimport_t * rimp)
 	re.RenderToTexture        = RE_RenderToTexture;
 	re.Finish                 = RE_Finish;
 	re.TakeVideoFrame         = RE_TakeVideoFrame;
+	re.SaveJPGToBuffer        = RE_SaveJPGToBuffer;
 	re.InitOpenGL             = RE_InitOpenGl;
 	re.InitOpenGLSubSystem    = RE_InitOpenGlSubsystems;
 	//re.SetClipRegion = RE_SetClipRegion;
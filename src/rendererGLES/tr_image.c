@@ -1056,29 +1056,31 @@ void R_LoadImage(const char *name, byte **pic, int *width, int *height)
 	// Searching is done in this order: tga, jp(e)g, png, pcx, bmp
 	for (i = 0; i < numImageLoaders; i++)
 	{
+		imageData_t data = { 0, NULL, { NULL } };
+
 		altName = va("%s.%s", localName, imageLoaders[i].ext);
 
-		// Check if file exists
-		if (ri.FS_FOpenFileRead(altName, NULL, qfalse) > 0)
+		// load the file, FS_ReadFile fails for missing files so there is no need to open it first
+		data.name = altName;
+		data.size = ri.FS_ReadFile(altName, &data.buffer.v);
+		if (data.size <= 0 || !data.buffer.b)
 		{
-			imageData_t data = { 0, altName, { NULL } };
-			// load the file
-			data.size = ri.FS_ReadFile(altName, &data.buffer.v);
-			if (!data.buffer.b || data.size < 0)
+			if (data.buffer.v)
 			{
-				continue;
+				ri.FS_FreeFile(data.buffer.v);
 			}
+			continue;
+		}
 
-			// Load
-			loaderRet = imageLoaders[i].ImageLoader(&data, pic, width, height, 0xFF);
+		// Load
+		loaderRet = imageLoaders[i].ImageLoader(&data, pic, width, height, 0xFF);
 
-			// free the file data
-			ri.FS_FreeFile(data.buffer.v);
+		// free the file data
+		ri.FS_FreeFile(data.buffer.v);
 
-			if (!loaderRet)
-			{
-				Ren_Drop("Image loader failed\n");
-			}
+		if (!loaderRet)
+		{
+			Ren_Drop("Image loader failed\n");
 		}
 
 		if (*pic)
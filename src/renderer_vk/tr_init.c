@@ -1473,6 +1473,7 @@ refexport_t *GetRefAPI(int apiVersion, refimport_t *rimp)
 
 	re.Finish              = RE_Finish;
 	re.TakeVideoFrame      = RE_TakeVideoFrame;
+	re.SaveJPGToBuffer     = RE_SaveJPGToBuffer;
 	re.InitOpenGL          = RE_InitOpenGl;
 	re.InitOpenGLSubSystem = RE_InitOpenGlSubsystems;
 
@@ -55,6 +55,28 @@ imageExtToLoaderMap_t imageLoaders[] =
 
 int numImageLoaders = sizeof(imageLoaders) / sizeof(imageLoaders[0]);
 
+/**
+ * @brief Output buffer of an image loader
+ *
+ * Images decoded by a job get a block of their own, which is handed back in
+ * data->jobPic even when the loader fails. Everything else decodes into the
+ * shared image buffer of the renderer.
+ *
+ * @param[in,out] data
+ * @param[in] size
+ * @return NULL if a job buffer can't be allocated
+ */
+void *R_GetImageDataBuffer(imageData_t *data, int size)
+{
+	if (data->job)
+	{
+		data->jobPic = Com_Allocate(size);
+		return data->jobPic;
+	}
+
+	return R_GetImageBuffer(size, BUFFER_IMAGE, data->name);
+}
+
 /**
  * @brief Workaround for ri.Printf's 1024 characters buffer limit.
  * @param[in] string
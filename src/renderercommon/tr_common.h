@@ -251,8 +251,14 @@ typedef struct
 		byte *b;
 		void *v;
 	} buffer;
+
+	qboolean job;           ///< decoded on a job thread, see R_GetImageDataBuffer
+	byte *jobPic;           ///< pixels allocated for the job, owned by the caller
 } imageData_t;
 
+/// loaders are quiet on job threads, failed jobs are decoded again on the main thread
+#define Ren_ImageWarning(data, ...) do { if (!(data)->job) { Ren_Warning(__VA_ARGS__); } } while (0)
+
 /**
  * @struct imageExtToLoaderMap_s
  * @brief
@@ -277,6 +283,8 @@ typedef struct
 
 extern imageExtToLoaderMap_t imageLoaders[];
 extern int                   numImageLoaders;
+
+void *R_GetImageDataBuffer(imageData_t *data, int size);
 /*
 =============================================================
 IMAGE LOADERS
@@ -75,6 +75,19 @@ static void _attribute((noreturn)) R_JPGErrorExit(j_common_ptr cinfo)
 	longjmp(mgr->jmpbuf, 23);
 }
 
+/**
+ * @brief R_JPGErrorExit for job threads, which must not print
+ * @param[in] cinfo
+ */
+static void _attribute((noreturn)) R_JPGJobErrorExit(j_common_ptr cinfo)
+{
+	my_jpeg_error_mgr *mgr = (my_jpeg_error_mgr *)cinfo->err;
+
+	jpeg_destroy(cinfo);
+
+	longjmp(mgr->jmpbuf, 23);
+}
+
 /**
  * @brief R_JPGOutputMessage
  * @param[in] cinfo
@@ -90,6 +103,15 @@ static void R_JPGOutputMessage(j_common_ptr cinfo)
 	Ren_Print("%s\n", buffer);
 }
 
+/**
+ * @brief R_JPGOutputMessage for job threads, the image is decoded again on
+ * the main thread to show the message
+ * @param cinfo - unused
+ */
+static void R_JPGJobOutputMessage(j_common_ptr cinfo)
+{
+}
+
 /**
  * @brief R_LoadJPG
  * @param[in] filename
@@ -126,9 +148,17 @@ qboolean R_LoadJPG(imageData_t *data, unsigned char **pic, int *width, int *heig
 	 * This routine fills in the contents of struct jerr, and returns jerr's
 	 * address which we place into the link field in cinfo.
 	 */
-	cinfo.err                 = jpeg_std_error(&jerr.pub);
-	cinfo.err->error_exit     = R_JPGErrorExit;
-	cinfo.err->output_message = R_JPGOutputMessage;
+	cinfo.err = jpeg_std_error(&jerr.pub);
+	if (data->job)
+	{
+		cinfo.err->error_exit     = R_JPGJobErrorExit;
+		cinfo.err->output_message = R_JPGJobOutputMessage;
+	}
+	else
+	{
+		cinfo.err->error_exit     = R_JPGErrorExit;
+		cinfo.err->output_message = R_JPGOutputMessage;
+	}
 
 	/* deep error handling */
 	if (setjmp(jerr.jmpbuf))
@@ -189,6 +219,11 @@ qboolean R_LoadJPG(imageData_t *data, unsigned char **pic, int *width, int *heig
 		// Free the memory to make sure we don't leak memory
 		jpeg_destroy_decompress(&cinfo);
 
+		if (data->job)
+		{
+			return qfalse;
+		}
+
 		Ren_Drop("LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", data->name,
 		         cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
 	}
@@ -196,7 +231,12 @@ qboolean R_LoadJPG(imageData_t *data, unsigned char **pic, int *width, int *heig
 	memcount   = pixelcount * 4;
 	row_stride = cinfo.output_width * cinfo.output_components;
 
-	out = R_GetImageBuffer(memcount, BUFFER_IMAGE, data->name);
+	out = R_GetImageDataBuffer(data, memcount);
+	if (!out)
+	{
+		jpeg_destroy_decompress(&cinfo);
+		return qfalse;
+	}
 
 	*width  = cinfo.output_width;
 	*height = cinfo.output_height;
@@ -251,6 +291,12 @@ qboolean R_LoadJPG(imageData_t *data, unsigned char **pic, int *width, int *heig
 	/* At this point you may want to check to see whether any corrupt-data
 	 * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
 	 */
+	if (data->job && jerr.pub.num_warnings)
+	{
+		// let the main thread decode it again and print the warnings
+		*pic = NULL;
+		return qfalse;
+	}
 
 	/* And we're done! */
 	return qtrue;
@@ -75,7 +75,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 
 	if (data->size < 18)
 	{
-		Ren_Warning("LoadTGA: header too short (%s)\n", data->name);
+		Ren_ImageWarning(data, "LoadTGA: header too short (%s)\n", data->name);
 		return qfalse;
 	}
 
@@ -109,19 +109,19 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 	    && targa_header.image_type != 10
 	    && targa_header.image_type != 3)
 	{
-		Ren_Warning("LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported(%s)\n", data->name);
+		Ren_ImageWarning(data, "LoadTGA: Only type 2 (RGB), 3 (gray), and 10 (RGB) TGA images supported(%s)\n", data->name);
 		return qfalse;
 	}
 
 	if (targa_header.colormap_type != 0)
 	{
-		Ren_Warning("LoadTGA: colormaps not supported(%s)\n", data->name);
+		Ren_ImageWarning(data, "LoadTGA: colormaps not supported(%s)\n", data->name);
 		return qfalse;
 	}
 
 	if ((targa_header.pixel_size != 32 && targa_header.pixel_size != 24) && targa_header.image_type != 3)
 	{
-		Ren_Warning("LoadTGA: Only 32 or 24 bit images supported (no colormaps)(%s)\n", data->name);
+		Ren_ImageWarning(data, "LoadTGA: Only 32 or 24 bit images supported (no colormaps)(%s)\n", data->name);
 		return qfalse;
 	}
 
@@ -131,18 +131,21 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 
 	if (!columns || !rows || numPixels > 0x7FFFFFFF || numPixels / columns / 4 != rows)
 	{
-		Ren_Warning("LoadTGA: %s has an invalid image size\n", data->name);
+		Ren_ImageWarning(data, "LoadTGA: %s has an invalid image size\n", data->name);
 		return qfalse;
 	}
 
-	targa_rgba = R_GetImageBuffer(numPixels, BUFFER_IMAGE, data->name);
+	targa_rgba = R_GetImageDataBuffer(data, numPixels);
+	if (!targa_rgba)
+	{
+		return qfalse;
+	}
 
 	if (targa_header.id_length != 0)
 	{
 		if (buf_p + targa_header.id_length > end)
 		{
-			ri.Free(targa_rgba);
-			Ren_Warning("LoadTGA: header too short (%s)\n", data->name);
+			Ren_ImageWarning(data, "LoadTGA: header too short (%s)\n", data->name);
 			return qfalse;
 		}
 
@@ -153,8 +156,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 	{
 		if (buf_p + columns * rows * targa_header.pixel_size / 8 > end)
 		{
-			ri.Free(targa_rgba);
-			Ren_Warning("LoadTGA: file truncated (%s)\n", data->name);
+			Ren_ImageWarning(data, "LoadTGA: file truncated (%s)\n", data->name);
 			return qfalse;
 		}
 
@@ -196,8 +198,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 					*pixbuf++ = alpha;
 					break;
 				default:
-					ri.Free(targa_rgba);
-					Ren_Warning("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
+					Ren_ImageWarning(data, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
 					return qfalse;
 				}
 			}
@@ -214,7 +215,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 			{
 				if (buf_p + 1 > end)
 				{
-					Ren_Warning("LoadTGA: file truncated (%s)\n", data->name);
+					Ren_ImageWarning(data, "LoadTGA: file truncated (%s)\n", data->name);
 					return qfalse;
 				}
 				packetHeader = *buf_p++;
@@ -223,7 +224,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 				{
 					if (buf_p + targa_header.pixel_size / 8 > end)
 					{
-						Ren_Warning("LoadTGA: file truncated (%s)\n", data->name);
+						Ren_ImageWarning(data, "LoadTGA: file truncated (%s)\n", data->name);
 						return qfalse;
 					}
 					switch (targa_header.pixel_size)
@@ -241,8 +242,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 						alpha = *buf_p++;
 						break;
 					default:
-						ri.Free(targa_rgba);
-						Ren_Warning("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
+						Ren_ImageWarning(data, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
 						return qfalse;
 					}
 
@@ -272,8 +272,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 				{
 					if (buf_p + targa_header.pixel_size / 8 * packetSize > end)
 					{
-						ri.Free(targa_rgba);
-						Ren_Warning("LoadTGA: file truncated (%s)\n", data->name);
+						Ren_ImageWarning(data, "LoadTGA: file truncated (%s)\n", data->name);
 						return qfalse;
 					}
 					for (j = 0; j < packetSize; j++)
@@ -300,8 +299,7 @@ qboolean R_LoadTGA(imageData_t *data, byte **pic, int *width, int *height, byte
 							*pixbuf++ = alpha;
 							break;
 						default:
-							ri.Free(targa_rgba);
-							Ren_Warning("LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
+							Ren_ImageWarning(data, "LoadTGA: illegal pixel_size '%d' in file '%s'\n", targa_header.pixel_size, data->name);
 							return qfalse;
 						}
 						column++;
@@ -331,22 +329,26 @@ breakOut:   ;
 	// bit 5 set => top-down
 	if (targa_header.attributes & 0x20)
 	{
-		unsigned char *flip;
-		unsigned char *src, *dst;
+		unsigned int *src, *dst, flip;
 
-		Ren_Developer("LoadTGA: '%s' TGA file header declares top-down image, flipping\n", data->name);
+		if (!data->job)
+		{
+			Ren_Developer("LoadTGA: '%s' TGA file header declares top-down image, flipping\n", data->name);
+		}
 
-		flip = (unsigned char *)ri.Hunk_AllocateTempMemory(columns * 4);
+		// swapped in place, the hunk can't be used from a job thread
 		for (row = 0; row < rows / 2; row++)
 		{
-			src = targa_rgba + row * 4 * columns;
-			dst = targa_rgba + (rows - row - 1) * 4 * columns;
+			src = (unsigned int *)(targa_rgba + row * 4 * columns);
+			dst = (unsigned int *)(targa_rgba + (rows - row - 1) * 4 * columns);
 
-			Com_Memcpy(flip, src, columns * 4);
-			Com_Memcpy(src, dst, columns * 4);
-			Com_Memcpy(dst, flip, columns * 4);
+			for (column = 0; column < columns; column++)
+			{
+				flip        = src[column];
+				src[column] = dst[column];
+				dst[column] = flip;
+			}
 		}
-		ri.Hunk_FreeTempMemory(flip);
 	}
 #else
 	// instead we just print a warning
@@ -37,7 +37,7 @@
 
 #include "tr_types.h"
 
-#define REF_API_VERSION     10
+#define REF_API_VERSION     11
 
 #ifdef FEATURE_PNG
 #include "zlib.h"
@@ -145,6 +145,8 @@ typedef struct
 
 	/// avi output stuff
 	void (*TakeVideoFrame)(int h, int w, byte *captureBuffer, byte *encodeBuffer, qboolean motionJpeg);
+	void (*FinishVideoFrames)(void);    ///< hands frames still being read back to CL_WriteAVIVideoPixels, may be NULL
+	size_t (*SaveJPGToBuffer)(byte *buffer, size_t bufSize, int quality, int image_width, int image_height, byte *image_buffer, int padding);
 
 	void (*InitOpenGL)(void);
 	int (*InitOpenGLSubSystem)(void);
@@ -226,12 +228,14 @@ typedef struct
 	/// a -1 return means the file does not exist
 	/// NULL can be passed for buf to just determine existance
 	int (*FS_FileIsInPAK)(const char *name, int *pChecksum);
+	int (*FS_FileOrigin)(const char *name, int *pChecksum);
 	int (*FS_ReadFile)(const char *name, void **buf);
 	void (*FS_FreeFile)(void *buf);
 	char **(*FS_ListFiles)(const char *name, const char *extension, int *numfilesfound);
 	void (*FS_FreeFileList)(char **filelist);
 	void (*FS_WriteFile)(const char *qpath, const void *buffer, int size);
 	qboolean (*FS_FileExists)(const char *file);
+	int (*FS_Delete)(const char *file);
 
 	long (*FS_FOpenFileRead)(const char *filename, fileHandle_t *file, qboolean uniqueFILE);
 	int (*FS_Read)(void *buffer, int len, fileHandle_t f);
@@ -244,6 +248,7 @@ typedef struct
 	/// avi output stuff
 	qboolean (*CL_VideoRecording)(void);
 	void (*CL_WriteAVIVideoFrame)(const byte *buffer, int size);
+	void (*CL_WriteAVIVideoPixels)(const byte *pixels, int padding);    ///< unencoded frame, bottom-up RGB rows
 
 #ifdef FEATURE_PNG
 	int (*zlib_compress)(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen);
@@ -254,6 +259,19 @@ typedef struct
 	void (*Sys_GLimpInit)(void);
 	void (*Sys_SetEnv)(const char *name, const char *value);
 
+	/// threading
+	void *(*Sys_CreateThread)(void (*function)(void *arg), void *arg);
+	void (*Sys_JoinThread)(void *thread);
+	void *(*Sys_CreateMutex)(void);
+	void (*Sys_DestroyMutex)(void *mutex);
+	void (*Sys_LockMutex)(void *mutex);
+	void (*Sys_UnlockMutex)(void *mutex);
+	void *(*Sys_CreateSemaphore)(int value);
+	void (*Sys_DestroySemaphore)(void *semaphore);
+	void (*Sys_SemaphorePost)(void *semaphore);
+	void (*Sys_SemaphoreWait)(void *semaphore);
+	int (*Sys_NumCPUs)(void);
+
 	/// input event handling
 	void (*IN_Init)(void);
 	void (*IN_Shutdown)(void);
@@ -262,6 +280,9 @@ typedef struct
 	void (*GLimp_Init)(glconfig_t *glConfig, const char *glConfigString);
 	void (*GLimp_Shutdown)(void);
 	void (*GLimp_SwapFrame)(void);
+	void (*GLimp_MakeCurrent)(qboolean current);     ///< bind or release the GL context on the calling thread
+	void (*GLimp_SwapWindow)(void);                  ///< buffer swap only, for the render thread
+	void (*GLimp_UpdateWindow)(void);                ///< the window handling of GLimp_SwapFrame, main thread only
 	void (*GLimp_SetGamma)(unsigned char red[256], unsigned char green[256], unsigned char blue[256]);
 
 	qboolean (*GLimp_SplashImage)(qboolean (*LoadSplashImage)(const char *name, byte *data, unsigned int size, unsigned int width, unsigned int height, uint8_t bytes));
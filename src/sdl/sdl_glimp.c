@@ -1231,6 +1231,28 @@ success:
 extern int CL_ScaledMilliseconds(void);
 #endif
 
+/**
+ * @brief Makes the GL context current on the calling thread or releases it
+ * @param[in] current
+ *
+ * @note Used by the renderer to hand the context over to its render thread
+ */
+void GLimp_MakeCurrent(qboolean current)
+{
+	if (SDL_GL_MakeCurrent(main_window, current ? SDL_glContext : NULL) < 0)
+	{
+		Com_Printf("SDL_GL_MakeCurrent failed: %s\n", SDL_GetError());
+	}
+}
+
+/**
+ * @brief Swaps the window buffers, may be called from the thread owning the GL context
+ */
+void GLimp_SwapWindow(void)
+{
+	SDL_GL_SwapWindow(main_window);
+}
+
 /**
  * @brief Responsible for doing a swapbuffers
  */
@@ -1240,9 +1262,17 @@ void GLimp_EndFrame(void)
 	//FIXME: remove this nonesense
 	if (Q_stricmp(Cvar_VariableString("r_drawBuffer"), "GL_FRONT") != 0)
 	{
-		SDL_GL_SwapWindow(main_window);
+		GLimp_SwapWindow();
 	}
 
+	GLimp_UpdateWindow();
+}
+
+/**
+ * @brief Applies fullscreen changes, must be called from the main thread once per frame
+ */
+void GLimp_UpdateWindow(void)
+{
 	if (r_fullscreen->modified)
 	{
 		qboolean fullscreen;
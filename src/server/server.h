@@ -107,7 +107,10 @@ typedef struct
 	int timeResidual;                   ///< <= 1000 / sv_frame->value
 	int nextFrameTime;                  ///< when time > nextFrameTime, process world
 	char *configstrings[MAX_CONFIGSTRINGS];
-	qboolean configstringsmodified[MAX_CONFIGSTRINGS];
+	qboolean configstringsmodified[MAX_CONFIGSTRINGS];  ///< index is in modifiedConfigstrings
+	int modifiedConfigstrings[MAX_CONFIGSTRINGS];       ///< to be broadcasted by SV_UpdateConfigStrings
+	int numModifiedConfigstrings;
+	int configstringsTotal;                             ///< sum of all configstring lengths
 	svEntity_t svEntities[MAX_GENTITIES];
 
 	char *entityParsePoint;             ///< used during game VM init
@@ -172,6 +175,7 @@ typedef struct
 	int messageAcked;                   ///< time the message was acked
 	int messageSize;                    ///< used to rate drop packets
 	qboolean parseEntities;             ///< does the frame contains parse entities?
+	int serverTime;                     ///< server time the snapshot was built at
 } clientSnapshot_t;
 
 /**
@@ -200,6 +204,47 @@ typedef struct netchan_buffer_s
 	struct netchan_buffer_s *next;
 } netchan_buffer_t;
 
+/**
+ * @struct serverCommand_s
+ * @typedef serverCommand_t
+ * @brief Reliable command text, shared by the reliable windows of all clients it was sent to
+ */
+typedef struct serverCommand_s
+{
+	int refCount;
+	int length;
+	char string[1];                         ///< allocated to length + 1
+} serverCommand_t;
+
+#define MAX_USERINFO_KEYS   128
+#define USERINFO_HASH_SIZE  64          ///< must be a power of two
+
+/**
+ * @struct userinfoCache_t
+ * @brief Parsed view of client_t::userinfo, rebuilt on the first lookup after the userinfo changed
+ */
+typedef struct
+{
+	qboolean valid;
+	qboolean overflowed;                    ///< too many keys, the rest is searched linearly
+
+	char buffer[MAX_INFO_STRING];           ///< keys and values, zero terminated
+	int numKeys;
+	short keys[MAX_USERINFO_KEYS];          ///< offsets into buffer
+	short values[MAX_USERINFO_KEYS];
+	short next[MAX_USERINFO_KEYS];          ///< hash chain, -1 terminated
+	short hashTable[USERINFO_HASH_SIZE];
+	short unhashed;                         ///< offset of the first key past the table when overflowed
+	short end;
+
+	// hot keys
+	short name;                             ///< offset into buffer like keys[], -1 if not set
+	int rate;                               ///< 0 if not set
+	int snaps;
+	qboolean hasRate;
+	qboolean hasSnaps;
+} userinfoCache_t;
+
 /**
  * @struct client_s
  * @typedef client_t
@@ -210,8 +255,9 @@ typedef struct client_s
 	clientState_t state;
 	char userinfo[MAX_INFO_STRING];         ///< name, etc
 	char userinfobuffer[MAX_INFO_STRING];   ///< used for buffering of user info
+	userinfoCache_t userinfoCache;          ///< see SV_UserinfoValue, call SV_InvalidateUserinfo after changing userinfo
 
-	char reliableCommands[MAX_RELIABLE_COMMANDS][MAX_STRING_CHARS];
+	serverCommand_t *reliableCommands[MAX_RELIABLE_COMMANDS];   ///< use SV_ReliableCommand, slots are only released when overwritten
 	int reliableSequence;                   ///< last added reliable message, not necesarily sent or acknowledged yet
 	int reliableAcknowledge;                ///< last acknowledged reliable message
 	int reliableSent;                       ///< last sent reliable message, not necesarily acknowledged yet
@@ -484,6 +530,8 @@ extern cvar_t *sv_protect;
 extern cvar_t *sv_protectLog;
 extern cvar_t *sv_protectLogInterval;
 
+extern cvar_t *sv_queryThread;
+
 #ifdef FEATURE_ANTICHEAT
 extern cvar_t *sv_wh_active;
 extern cvar_t *sv_wh_bbox_horz;
@@ -497,6 +545,7 @@ extern cvar_t *sv_demoState;
 extern cvar_t *sv_autoDemo;
 extern cvar_t *sv_freezeDemo;
 extern cvar_t *sv_demoTolerant;
+extern cvar_t *sv_demoKeyframes;
 
 extern cvar_t *sv_ipMaxClients; ///< limit client connection
 
@@ -509,6 +558,7 @@ extern cvar_t *sv_etltv_autoplay;
 extern cvar_t *sv_etltv_clientname;
 extern cvar_t *sv_etltv_delay;
 extern cvar_t *sv_etltv_shownet;
+extern cvar_t *sv_etltv_sharedSnapshots;
 extern cvar_t *sv_etltv_queue_ms;
 
 //===========================================================
@@ -568,10 +618,62 @@ struct leakyBucket_s
 #define MAX_BUCKETS         16384
 #define MAX_HASHES          1024
 
+/**
+ * @struct leakyBucketTable_t
+ * @brief Per address buckets, the query thread keeps its own table
+ */
+typedef struct
+{
+	leakyBucket_t buckets[MAX_BUCKETS];
+	leakyBucket_t *hashes[MAX_HASHES];
+} leakyBucketTable_t;
+
 qboolean SVC_RateLimit(leakyBucket_t *bucket, int burst, int period);
+qboolean SVC_RateLimitQuiet(leakyBucket_t *bucket, int burst, int period);
 qboolean SVC_RateLimitAddress(const netadr_t *from, int burst, int period);
+qboolean SVC_RateLimitAddressQuiet(leakyBucketTable_t *table, const netadr_t *from, int burst, int period);
 extern leakyBucket_t outboundLeakyBucket;
 
+/**
+ * @enum receiptCheck_t
+ * @brief Result of SV_CheckInfoReceipts
+ */
+typedef enum
+{
+	RECEIPT_OK,
+	RECEIPT_FLOOD,                      ///< all receipts were used in the last two seconds
+	RECEIPT_ADDRESS_FLOOD               ///< already answered this subnet three times
+} receiptCheck_t;
+
+receiptCheck_t SV_CheckInfoReceipts(receipt_t *receipts, netadr_t from, int timeNow);
+
+int SV_FormatStatusResponse(char *packet, int size, const char *info, const char *players, const char *challenge);
+int SV_FormatInfoResponse(char *packet, int size, const char *info, const char *challenge);
+void SV_QueryInfoChanged(void);
+void SV_QueryPlayersChanged(void);
+unsigned int SV_QueryVersion(void);
+void SV_UpdateQueryPlayers(void);
+const char *SV_StatusInfo(void);
+const char *SV_StatusPlayers(void);
+const char *SV_Info(void);
+void SV_QueryBenchmark(int count);
+
+// sv_query.c
+
+/**
+ * @enum queryType_t
+ * @brief Connectionless queries answered by the query thread
+ */
+typedef enum
+{
+	QUERY_STATUS,
+	QUERY_INFO
+} queryType_t;
+
+void SV_QueryFrame(void);
+void SV_QueryShutdown(void);
+qboolean SV_QueueQuery(const netadr_t *from, queryType_t type, const char *challenge);
+
 // sv_init.c
 void SV_SetConfigstringNoUpdate(int index, const char *val);
 void SV_SetConfigstring(int index, const char *val);
@@ -579,6 +681,10 @@ void SV_UpdateConfigStrings(void);
 void SV_GetConfigstring(int index, char *buffer, unsigned int bufferSize);
 void SV_SetUserinfo(int index, const char *val);
 void SV_GetUserinfo(int index, char *buffer, unsigned int bufferSize);
+void SV_InvalidateUserinfo(client_t *cl);
+const userinfoCache_t *SV_ParsedUserinfo(client_t *cl);
+const char *SV_UserinfoValue(client_t *cl, const char *key);
+int SV_GetUserinfoValue(int index, const char *key, char *buffer, int bufferSize);
 void SV_ChangeMaxClients(void);
 void SV_SpawnServer(const char *server);
 void SV_WriteAttackLog(const char *log);
@@ -612,6 +718,11 @@ void SV_UptimeReset(void);
 
 // sv_snapshot.c
 void SV_AddServerCommand(client_t *client, const char *cmd);
+const char *SV_ReliableCommand(const client_t *client, int sequence);
+serverCommand_t *SV_AllocServerCommand(const char *cmd);
+void SV_ReleaseServerCommand(serverCommand_t *command);
+void SV_AddServerCommandShared(client_t *client, serverCommand_t *command);
+void SV_FreeReliableCommands(client_t *client);
 void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg);
 void SV_SendMessageToClient(msg_t *msg, client_t *client, qboolean parseEntities);
 void SV_SendClientMessages(void);
@@ -1015,6 +1126,8 @@ int SV_CL_GetQueueTime(void);
 void SV_CL_ParseMessageQueue(void);
 void SV_CL_ParseServerMessageIntoQueue(msg_t *msg, int headerBytes);
 void SV_CL_ParseGamestateQueue(msg_t *msg);
+void SV_CL_ClearMessageQueue(void);
+void SV_CL_MessageQueueInfo_f(void);
 
 // sv_cl_demo.c
 void SV_CL_DemoInit(void);
@@ -511,6 +511,12 @@ static void SV_Status_f(void)
 	Com_Printf("avg response time     : %i ms\n", ( int ) svs.stats.avg);
 	Com_Printf("server time           : %i\n", svs.time);
 	Com_Printf("internal time         : %i\n", Sys_Milliseconds());
+	if (com_frameJitter.frames)
+	{
+		Com_Printf("frame jitter          : avg %i us, max %i us, %i late, %i stalls (%s)\n",
+		           (int)(com_frameJitter.total / com_frameJitter.frames), com_frameJitter.max,
+		           com_frameJitter.late, com_frameJitter.stalls, com_preciseFrames->integer ? "epoll" : "select");
+	}
 	Com_Printf("map                   : %s\n\n", sv_mapname->string);
 	Com_Printf("num score ping name                                lastmsg address               qport rate  lastConnectTime\n");
 	Com_Printf("--- ----- ---- ----------------------------------- ------- --------------------- ----- ----- ---------------\n");
@@ -722,6 +728,41 @@ void SV_Uptime_f(void)
 	}
 }
 
+/**
+ * @brief Measures the getstatus/getinfo throughput against the loopback address
+ */
+static void SV_QueryBench_f(void)
+{
+	int count = 10000;
+
+	// make sure server is running
+	if (!com_sv_running->integer)
+	{
+		Com_Printf("Server is not running.\n");
+		return;
+	}
+
+	// a local client would read the responses from its loopback queue
+	if (!com_dedicated->integer)
+	{
+		Com_Printf("querybench is only available on dedicated servers.\n");
+		return;
+	}
+
+	if (Cmd_Argc() > 1)
+	{
+		count = Q_atoi(Cmd_Argv(1));
+	}
+
+	if (count <= 0)
+	{
+		Com_Printf("Usage: querybench [count]\n");
+		return;
+	}
+
+	SV_QueryBenchmark(count);
+}
+
 //===========================================================
 
 /**
@@ -759,6 +800,7 @@ void SV_AddOperatorCommands(void)
 	}
 
 	Cmd_AddCommand("uptime", SV_Uptime_f, "Prints uptime info.");
+	Cmd_AddCommand("querybench", SV_QueryBench_f, "Measures the getstatus/getinfo response throughput against loopback.");
 
 #if defined(FEATURE_IRC_SERVER) && defined(DEDICATED)
 	Cmd_AddCommand("irc_connect", IRC_Connect, "Connects to an IRC server.");
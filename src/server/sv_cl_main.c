@@ -139,7 +139,7 @@ void SV_CL_Commands_f(void)
 
 	if (argc < 2)
 	{
-		Com_Printf("usage: tv <connect|disconnect>\n");
+		Com_Printf("usage: tv <connect|disconnect|queue>\n");
 		return;
 	}
 
@@ -153,6 +153,10 @@ void SV_CL_Commands_f(void)
 	{
 		SV_Shutdown("Server disconnected");
 	}
+	else if (!Q_stricmp(cmd, "queue"))
+	{
+		SV_CL_MessageQueueInfo_f();
+	}
 }
 #else
 /**
@@ -165,7 +169,7 @@ void SV_CL_Commands_f(void)
 
 	if (argc < 2)
 	{
-		Com_Printf("usage: tv <demo|ff>\n");
+		Com_Printf("usage: tv <demo|ff|queue>\n");
 		return;
 	}
 
@@ -179,6 +183,10 @@ void SV_CL_Commands_f(void)
 	{
 		SV_CL_FastForward_f();
 	}
+	else if (!Q_stricmp(cmd, "queue"))
+	{
+		SV_CL_MessageQueueInfo_f();
+	}
 }
 
 #endif // DEDICATED
@@ -297,6 +305,7 @@ void SV_CL_Disconnect(void)
 	FS_ClearPureServerPacks();
 
 	SV_CL_ClearState();
+	SV_CL_ClearMessageQueue();
 
 	// wipe the client connection
 	Com_Memset(&svclc, 0, sizeof(svclc));
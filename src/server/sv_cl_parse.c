@@ -34,6 +34,60 @@
 
 #include "server.h"
 
+// the delay queue (see sv_etltv_delay) holds thousands of messages, they are carved out of slabs in arrival order
+// and released in the same order, so slabs are recycled instead of allocating every message and command
+#define SVCL_QUEUE_SLAB_SIZE    (256 * 1024)
+#define SVCL_QUEUE_ALIGN(x)     (((x) + 15) & ~15)
+#define SVCL_QUEUE_HEADER_SIZE  SVCL_QUEUE_ALIGN(sizeof(svclQueueBlock_t))
+
+/**
+ * @struct svclQueueSlab_s
+ * @brief A slab of the delay queue
+ */
+typedef struct svclQueueSlab_s
+{
+	struct svclQueueSlab_s *next;       ///< next free slab
+	int used;                           ///< bytes carved out of data
+	int live;                           ///< blocks not released yet
+	byte data[SVCL_QUEUE_SLAB_SIZE];
+} svclQueueSlab_t;
+
+/**
+ * @struct svclQueueBlock_s
+ * @brief Header of a block carved out of a slab
+ */
+typedef struct svclQueueBlock_s
+{
+	svclQueueSlab_t *slab;
+	int size;
+} svclQueueBlock_t;
+
+/**
+ * @struct svclQueue_s
+ * @brief Delay queue slabs and usage statistics
+ */
+static struct svclQueue_s
+{
+	svclQueueSlab_t *current;           ///< slab blocks are carved from
+	svclQueueSlab_t *free;              ///< released slabs, ready to be reused
+
+	int numSlabs;                       ///< slabs allocated
+	int numSlabsUsed;                   ///< slabs holding live blocks
+	int maxSlabsUsed;
+
+	int numMessages;
+	int maxMessages;
+
+	int numBytes;
+	int maxBytes;
+
+	qboolean parsing;                   ///< SV_CL_ParseMessageQueue is reading the queue head
+	qboolean clearPending;              ///< cleared while parsing, done once the head is released
+} svclQueue;
+
+static void SV_CL_Free(void *data);
+static void SV_CL_FreeMessage(void);
+
 const char *sv_cl_strings[32] =
 {
 	"svc_bad",
@@ -972,7 +1026,8 @@ void SV_CL_ParseMessageQueue(void)
 		{
 			index = (i + svMsgQueueHead->serverCommandSequence) & (MAX_RELIABLE_COMMANDS - 1);
 			Q_strncpyz(svclc.serverCommands[index], svMsgQueueHead->serverCommands[i], sizeof(svclc.serverCommands[index]));
-			free(svMsgQueueHead->serverCommands[i]);
+			SV_CL_Free(svMsgQueueHead->serverCommands[i]);
+			svMsgQueueHead->serverCommands[i] = NULL;
 		}
 
 		svclc.serverCommandSequence = svMsgQueueHead->numServerCommand + svMsgQueueHead->serverCommandSequence - 1;
@@ -985,20 +1040,19 @@ void SV_CL_ParseMessageQueue(void)
 			}
 		}
 
+		// parsing may disconnect (missing paks), which clears the queue,
+		// the message has to stay valid until we are done with it,
+		// nothing below runs if it drops with Com_Error, see SV_CL_AbortMessageQueue
+		svclQueue.parsing = qtrue;
 		SV_CL_ParseServerMessage(&svMsgQueueHead->msg, svMsgQueueHead->headerBytes);
+		svclQueue.parsing = qfalse;
 
-		if (svMsgQueueHead->next)
-		{
-			svMsgQueueHead = svMsgQueueHead->next;
-			free(svMsgQueueHead->prev->msg.data);
-			free(svMsgQueueHead->prev);
-			svMsgQueueHead->prev = NULL;
-		}
-		else
+		SV_CL_FreeMessage();
+
+		if (svclQueue.clearPending)
 		{
-			free(svMsgQueueHead->msg.data);
-			free(svMsgQueueHead);
-			svMsgQueueHead = NULL;
+			SV_CL_ClearMessageQueue();
+			return;
 		}
 	}
 }
@@ -1131,25 +1185,106 @@ void SV_CL_ParseServerMessage(msg_t *msg, int headerBytes)
 }
 
 /**
- * @brief SV_CL_Allocate
+ * @brief SV_CL_Allocate carves a block out of the delay queue slabs
+ * @param[in] size
+ * @return
  */
 static void *SV_CL_Allocate(int size)
 {
-	void *data;
+	svclQueueBlock_t *block;
+	int              total;
 
 	if (size > MAX_MSGLEN)
 	{
 		Com_Error(ERR_FATAL, "SV_CL_Allocate: Oversized allocation of [%d].", size);
 	}
 
-	data = Com_Allocate(size);
+	total = SVCL_QUEUE_HEADER_SIZE + SVCL_QUEUE_ALIGN(size);
+
+	if (!svclQueue.current || svclQueue.current->used + total > SVCL_QUEUE_SLAB_SIZE)
+	{
+		svclQueueSlab_t *slab = svclQueue.free;
+
+		if (slab)
+		{
+			svclQueue.free = slab->next;
+		}
+		else
+		{
+			slab = Com_Allocate(sizeof(svclQueueSlab_t));
+
+			if (!slab)
+			{
+				Com_Error(ERR_FATAL, "SV_CL_Allocate: Couldn't allocate size [%d].", size);
+			}
+
+			svclQueue.numSlabs++;
+		}
+
+		slab->next = NULL;
+		slab->used = 0;
+		slab->live = 0;
+
+		// the previous slab is recycled by SV_CL_Free once its last block is released
+		svclQueue.current = slab;
+		svclQueue.numSlabsUsed++;
+
+		if (svclQueue.numSlabsUsed > svclQueue.maxSlabsUsed)
+		{
+			svclQueue.maxSlabsUsed = svclQueue.numSlabsUsed;
+		}
+	}
+
+	block       = (svclQueueBlock_t *)(svclQueue.current->data + svclQueue.current->used);
+	block->slab = svclQueue.current;
+	block->size = total;
+
+	svclQueue.current->used += total;
+	svclQueue.current->live++;
+
+	svclQueue.numBytes += total;
+	if (svclQueue.numBytes > svclQueue.maxBytes)
+	{
+		svclQueue.maxBytes = svclQueue.numBytes;
+	}
+
+	return (byte *)block + SVCL_QUEUE_HEADER_SIZE;
+}
+
+/**
+ * @brief SV_CL_Free releases a block of the delay queue, the slab is recycled once all its blocks are released
+ * @param[in] data
+ */
+static void SV_CL_Free(void *data)
+{
+	svclQueueBlock_t *block;
+	svclQueueSlab_t  *slab;
 
 	if (!data)
 	{
-		Com_Error(ERR_FATAL, "SV_CL_Allocate: Couldn't allocate size [%d].", size);
+		return;
+	}
+
+	block = (svclQueueBlock_t *)((byte *)data - SVCL_QUEUE_HEADER_SIZE);
+	slab  = block->slab;
+
+	svclQueue.numBytes -= block->size;
+
+	if (--slab->live > 0)
+	{
+		return;
+	}
+
+	if (slab == svclQueue.current)
+	{
+		// nothing left in the current slab, start over
+		slab->used = 0;
+		return;
 	}
 
-	return data;
+	slab->next     = svclQueue.free;
+	svclQueue.free = slab;
+	svclQueue.numSlabsUsed--;
 }
 
 /**
@@ -1158,12 +1293,7 @@ static void *SV_CL_Allocate(int size)
  */
 static serverMessageQueue_t *SV_CL_NewMessage(void)
 {
-	serverMessageQueue_t *newMessage = Com_Allocate(sizeof(serverMessageQueue_t));
-
-	if (!newMessage)
-	{
-		Com_Error(ERR_FATAL, "SV_CL_NewMessage: Couldn't allocate new message.");
-	}
+	serverMessageQueue_t *newMessage = SV_CL_Allocate(sizeof(serverMessageQueue_t));
 
 	Com_Memset(newMessage, 0, sizeof(serverMessageQueue_t));
 
@@ -1178,9 +1308,111 @@ static serverMessageQueue_t *SV_CL_NewMessage(void)
 		svMsgQueueTail             = newMessage;
 	}
 
+	svclQueue.numMessages++;
+	if (svclQueue.numMessages > svclQueue.maxMessages)
+	{
+		svclQueue.maxMessages = svclQueue.numMessages;
+	}
+
 	return newMessage;
 }
 
+/**
+ * @brief SV_CL_FreeMessage releases the queue head
+ */
+static void SV_CL_FreeMessage(void)
+{
+	serverMessageQueue_t *message = svMsgQueueHead;
+
+	svMsgQueueHead = message->next;
+
+	if (svMsgQueueHead)
+	{
+		svMsgQueueHead->prev = NULL;
+	}
+	else
+	{
+		svMsgQueueTail = NULL;
+	}
+
+	SV_CL_Free(message->msg.data);
+	SV_CL_Free(message);
+
+	svclQueue.numMessages--;
+}
+
+/**
+ * @brief SV_CL_ClearMessageQueue drops all queued messages and releases the slabs
+ */
+void SV_CL_ClearMessageQueue(void)
+{
+	svclQueueSlab_t *slab, *next;
+	int             i;
+
+	if (svclQueue.parsing)
+	{
+		svclQueue.clearPending = qtrue;
+		return;
+	}
+
+	while (svMsgQueueHead)
+	{
+		for (i = 0; i < svMsgQueueHead->numServerCommand; i++)
+		{
+			SV_CL_Free(svMsgQueueHead->serverCommands[i]);
+		}
+
+		SV_CL_FreeMessage();
+	}
+
+	for (slab = svclQueue.free; slab; slab = next)
+	{
+		next = slab->next;
+		Com_Dealloc(slab);
+	}
+
+	Com_Dealloc(svclQueue.current);
+
+	Com_Memset(&svclQueue, 0, sizeof(svclQueue));
+}
+
+/**
+ * @brief Called by Com_Frame when Com_Error dropped out of the frame
+ *
+ * The parse of the queue head may never return, its commands were executed
+ * and freed already, so the message is dropped and a clear requested meanwhile
+ * is done now.
+ */
+void SV_CL_AbortMessageQueue(void)
+{
+	if (!svclQueue.parsing)
+	{
+		return;
+	}
+	svclQueue.parsing = qfalse;
+
+	if (svMsgQueueHead)
+	{
+		SV_CL_FreeMessage();
+	}
+
+	if (svclQueue.clearPending)
+	{
+		SV_CL_ClearMessageQueue();
+	}
+}
+
+/**
+ * @brief SV_CL_MessageQueueInfo_f prints the delay queue usage
+ */
+void SV_CL_MessageQueueInfo_f(void)
+{
+	Com_Printf("messages: %i (peak %i)\n", svclQueue.numMessages, svclQueue.maxMessages);
+	Com_Printf("memory  : %i KB (peak %i KB)\n", svclQueue.numBytes / 1024, svclQueue.maxBytes / 1024);
+	Com_Printf("slabs   : %i used (peak %i), %i allocated of %i KB\n", svclQueue.numSlabsUsed, svclQueue.maxSlabsUsed,
+	           svclQueue.numSlabs, SVCL_QUEUE_SLAB_SIZE / 1024);
+}
+
 /**
  * @brief SV_CL_CheckNewQueuedCommand for change in serverId
  * @param[in] cmd
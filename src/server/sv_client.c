@@ -602,6 +602,7 @@ gotnewcl:
 	// build a new connection
 	// accept the new client
 	// this is the only place a client_t is EVER initialized
+	SV_FreeReliableCommands(newcl);
 	*newcl    = temp;
 	clientNum = newcl - svs.clients;
 
@@ -622,6 +623,7 @@ gotnewcl:
 
 	// save the userinfo
 	Q_strncpyz(newcl->userinfo, userinfo, sizeof(newcl->userinfo));
+	SV_InvalidateUserinfo(newcl);
 
 	// save userinfo changes to demo
 	// note: client configstring is derived from userinfo so we need to save it before it gets generated and saved in GAME_CLIENT_CONNECT
@@ -663,6 +665,8 @@ gotnewcl:
 	// gamestate message was not just sent, forcing a retransmit
 	newcl->gamestateMessageNum = -1;
 
+	SV_QueryPlayersChanged();
+
 	// if this was the first client on the server, or the last client
 	// the server can hold, send a heartbeat to the master.
 	for (i = 0, cl = svs.clients ; i < sv_maxclients->integer ; i++, cl++)
@@ -1941,13 +1945,35 @@ static void SV_ResetPureClient_f(client_t *cl)
  */
 void SV_UserinfoChanged(client_t *cl)
 {
-	char *val;
-	int  i;
+	const userinfoCache_t *info;
+	const char            *val, *name;
+	int                   i;
+
+	// maintain the IP information
+	// this is set in SV_DirectConnect (directly on the server, not transmitted), may be lost when client updates it's userinfo
+	// the banning code relies on this being consistently present
+	// - modified to always keep this consistent, instead of only
+	// when "ip" is 0-length, so users can't supply their own IP
+	//Com_DPrintf("Maintain IP in userinfo for '%s'\n", cl->name);
+	if (!NET_IsLocalAddress(&cl->netchan.remoteAddress))
+	{
+		Info_SetValueForKey(cl->userinfo, "ip", NET_AdrToString(&cl->netchan.remoteAddress));
+	}
+	else
+	{
+		// force the "ip" info key to "localhost" for local clients
+		Info_SetValueForKey(cl->userinfo, "ip", "localhost");
+	}
+
+	// parse once, the hot keys below and the game's lookups share the result
+	SV_InvalidateUserinfo(cl);
+	info = SV_ParsedUserinfo(cl);
+	name = info->name >= 0 ? info->buffer + info->name : "";
 
 #ifdef FEATURE_TRACKER
 	if (sv_advert->integer & SVA_TRACKER)
 	{
-		if (strcmp(cl->name, Info_ValueForKey(cl->userinfo, "name")))
+		if (strcmp(cl->name, name))
 		{
 			Tracker_ClientName(cl);
 		}
@@ -1955,7 +1981,11 @@ void SV_UserinfoChanged(client_t *cl)
 #endif
 
 	// name for C code
-	Q_strncpyz(cl->name, Info_ValueForKey(cl->userinfo, "name"), sizeof(cl->name));
+	if (strncmp(cl->name, name, sizeof(cl->name) - 1))
+	{
+		Q_strncpyz(cl->name, name, sizeof(cl->name));
+		SV_QueryPlayersChanged();
+	}
 
 	// rate command
 
@@ -1967,11 +1997,9 @@ void SV_UserinfoChanged(client_t *cl)
 	}
 	else
 	{
-		val = Info_ValueForKey(cl->userinfo, "rate");
-		if (strlen(val))
+		if (info->hasRate)
 		{
-			i        = Q_atoi(val);
-			cl->rate = i;
+			cl->rate = info->rate;
 			if (cl->rate < 1000)
 			{
 				cl->rate = 1000;
@@ -2000,10 +2028,9 @@ void SV_UserinfoChanged(client_t *cl)
 	*/
 
 	// snaps command
-	val = Info_ValueForKey(cl->userinfo, "snaps");
-	if (strlen(val))
+	if (info->hasSnaps)
 	{
-		i = Q_atoi(val);
+		i = info->snaps;
 		if (i < 1)
 		{
 			i = 1;
@@ -2027,24 +2054,8 @@ void SV_UserinfoChanged(client_t *cl)
 		cl->snapshotMsec     = i;
 	}
 
-	// maintain the IP information
-	// this is set in SV_DirectConnect (directly on the server, not transmitted), may be lost when client updates it's userinfo
-	// the banning code relies on this being consistently present
-	// - modified to always keep this consistent, instead of only
-	// when "ip" is 0-length, so users can't supply their own IP
-	//Com_DPrintf("Maintain IP in userinfo for '%s'\n", cl->name);
-	if (!NET_IsLocalAddress(&cl->netchan.remoteAddress))
-	{
-		Info_SetValueForKey(cl->userinfo, "ip", NET_AdrToString(&cl->netchan.remoteAddress));
-	}
-	else
-	{
-		// force the "ip" info key to "localhost" for local clients
-		Info_SetValueForKey(cl->userinfo, "ip", "localhost");
-	}
-
 	// download prefs of the client
-	val       = Info_ValueForKey(cl->userinfo, "cl_wwwDownload");
+	val       = SV_UserinfoValue(cl, "cl_wwwDownload");
 	cl->bDlOK = qfalse;
 	if (strlen(val))
 	{
@@ -2056,7 +2067,7 @@ void SV_UserinfoChanged(client_t *cl)
 	}
 
 	// no version was set on connect, check cgame version as a fallback
-	if (cl->agent.string[0] == 0 && (val = Info_ValueForKey(cl->userinfo, "cg_etVersion"))[0])
+	if (cl->agent.string[0] == 0 && (val = SV_UserinfoValue(cl, "cg_etVersion"))[0])
 	{
 		Com_ParseUA(&cl->agent, val);
 	}
@@ -2095,6 +2106,7 @@ void SV_UpdateUserinfo_f(client_t *cl)
 	}
 
 	Q_strncpyz(cl->userinfo, arg, sizeof(cl->userinfo));
+	SV_InvalidateUserinfo(cl);
 
 	SV_UserinfoChanged(cl);
 	// call prog code to allow overrides
@@ -2343,7 +2355,7 @@ static void SV_UserMove(client_t *cl, msg_t *msg, qboolean delta)
 	// also use the message acknowledge
 	key ^= cl->messageAcknowledge;
 	// also use the last acknowledged server command in the key
-	key ^= MSG_HashKey(cl->reliableCommands[cl->reliableAcknowledge & (MAX_RELIABLE_COMMANDS - 1)], 32, !Com_IsCompatible(&cl->agent, 0x1));
+	key ^= MSG_HashKey(SV_ReliableCommand(cl, cl->reliableAcknowledge), 32, !Com_IsCompatible(&cl->agent, 0x1));
 
 	Com_Memset(&nullcmd, 0, sizeof(nullcmd));
 	oldcmd = &nullcmd;
@@ -81,6 +81,8 @@ typedef enum
 	demo_playerState,          ///< players game state event (playerState_t management)
 
 	//demo_clientUsercmd,    ///< players commands/movements packets (usercmd_t management)
+
+	demo_keyFrame,             ///< seekable keyframe marker (server time and gamestate), the frame that follows is delta'd against null states
 } demo_ops_e;
 
 /*** STATIC VARIABLES ***/
@@ -102,6 +104,28 @@ static char *savedPlaybackDemoname               = savedPlaybackDemonameVal;
 #define MAX_DEMO_AUTOPLAY 10
 char demoAutoPlay[MAX_DEMO_AUTOPLAY][MAX_OSPATH];
 
+/**
+ * @struct demoKeyframe_s
+ * @brief Position of a keyframe in the demo file, used to seek without replaying every frame
+ */
+typedef struct demoKeyframe_s
+{
+	int offset;                 ///< file offset of the demo_keyFrame message
+	int time;                   ///< server time of the keyframe
+	int gamestate;              ///< gamestate at the time of the keyframe
+} demoKeyframe_t;
+
+// arbitrary limit (~34 hours with sv_demoKeyframes 30)
+#define MAX_DEMO_KEYFRAMES 4096
+static demoKeyframe_t demoKeyframes[MAX_DEMO_KEYFRAMES];
+static int            demoKeyframesCount;
+static qboolean       demoKeyframesIndexed;
+static int            demoFramesOffset;     ///< file offset of the first frame (right after the demo header)
+static int            demoStartTime;        ///< server time at the start of the demo
+static int            demoNextKeyframeTime; ///< when recording, server time at which the next keyframe is written
+static qboolean       demoReadingKeyframe;  ///< when playing, qtrue while the events of a keyframe are being read
+static qboolean       demoKeyframeClients[MAX_CLIENTS]; ///< when playing, democlients whose userinfo the current keyframe holds
+
 /**
  * @brief Restores all CVARs
  */
@@ -824,6 +848,60 @@ static void SV_DemoWriteAllEntityShared(void)
 	SV_DemoWriteMessage(&msg);
 }
 
+/**
+ * @brief Write a keyframe: full clients userinfo and configstrings, followed by a frame delta'd against null states
+ *
+ * @details Since a keyframe doesn't depend on any previous frame, playback can seek straight to it
+ * (see SV_DemoSeek) instead of replaying every frame in between.
+ * The gamestate is stored in the marker so that demo_ff can stop at gamestate changes without reading the frames.
+ */
+static void SV_DemoWriteKeyFrame(void)
+{
+	msg_t msg;
+	int   i;
+
+	MSG_Init(&msg, buf, sizeof(buf));
+	MSG_WriteByte(&msg, demo_keyFrame);
+	MSG_WriteLong(&msg, sv.time);
+	MSG_WriteLong(&msg, Q_atoi(Info_ValueForKey(sv.configstrings[CS_WOLFINFO], "gamestate")));
+	SV_DemoWriteMessage(&msg);
+
+	// write clients userinfo
+	// note: should be before clients configstrings since clients configstrings are derived from userinfo
+	for (i = 0; i < sv_maxclients->integer; i++)
+	{
+		client_t *client = &svs.clients[i];
+
+		if (client->state >= CS_CONNECTED)
+		{
+			if (client->userinfo[0] != '\0')
+			{
+				// if player is connected and the userinfo exists, we store it
+				SV_DemoWriteClientUserinfo(client, (const char *)client->userinfo);
+			}
+		}
+	}
+
+	// write all configstrings (such as current capture score CS_SCORE1/2, etc...), including clients configstrings
+	// note: system configstrings will be filtered and excluded (there's a check function for that)
+	// and clients configstrings  will be automatically redirected to the specialized function (see the check function)
+	for (i = 0; i < MAX_CONFIGSTRINGS; i++)
+	{
+		// if the configstring pointer exists in memory (because we will check all the possible indexes,
+		// but we don't know if they really exist in memory and are used or not, so here we check for that)
+		if (sv.configstrings[i])
+		{
+			SV_DemoWriteConfigString(i, sv.configstrings[i]);
+		}
+	}
+
+	// the entities and players of this frame are delta'd against null states
+	Com_Memset(sv.demoEntities, 0, sizeof(sv.demoEntities));
+	Com_Memset(sv.demoPlayerStates, 0, sizeof(sv.demoPlayerStates));
+
+	demoNextKeyframeTime = sv.time + sv_demoKeyframes->integer * 1000;
+}
+
 /**
  * @brief Record all the entities (gentities fields) and players (player_t fields) at the end of every frame (this is the only write function to be called in every frame for sure)
  *
@@ -836,6 +914,12 @@ void SV_DemoWriteFrame(void)
 {
 	msg_t msg;
 
+	// STEP0: write a keyframe from time to time so that playback can seek
+	if (!demoNextKeyframeTime || (sv_demoKeyframes->integer > 0 && sv.time >= demoNextKeyframeTime))
+	{
+		SV_DemoWriteKeyFrame();
+	}
+
 	// STEP1: write all entities states at the end of the frame
 
 	// write entities (gentity_t->entityState_t or concretely sv.gentities[num].s, in gamecode level. instead of sv.)
@@ -1257,6 +1341,13 @@ static void SV_DemoStartPlayback(void)
 	// initialize our stuff
 	Com_Memset(sv.demoEntities, 0, sizeof(sv.demoEntities));
 	Com_Memset(sv.demoPlayerStates, 0, sizeof(sv.demoPlayerStates));
+
+	// keyframes are indexed on the first seek
+	demoStartTime        = time;
+	demoFramesOffset     = FS_FTell(sv.demoFile);
+	demoKeyframesCount   = 0;
+	demoKeyframesIndexed = qfalse;
+	demoReadingKeyframe  = qfalse;
 	Cvar_SetValue("sv_democlients", clients); // note: we need SV_Startup() to NOT use SV_ChangeMaxClients for this to work without crashing when changing fs_game
 
 	// FIXME: omnibot - this bot stuff isn't tested well (but better than before)
@@ -1305,7 +1396,6 @@ static void SV_DemoStartRecord(void)
 {
 	msg_t msg;
 	char  *info;
-	int   i;
 
 	// set democlients to 0 since it's only used for replaying demo
 	Cvar_SetValue("sv_democlients", 0);
@@ -1321,38 +1411,8 @@ static void SV_DemoStartRecord(void)
 	// write all the above into the demo file
 	SV_DemoWriteMessage(&msg);
 
-	// write initial clients userinfo
-	// note: should be before clients configstrings since clients configstrings are derived from userinfo
-	for (i = 0; i < sv_maxclients->integer; i++)
-	{
-		client_t *client = &svs.clients[i];
-
-		if (client->state >= CS_CONNECTED)
-		{
-			if (client->userinfo[0] != '\0')
-			{
-				// if player is connected and the userinfo exists, we store it
-				SV_DemoWriteClientUserinfo(client, (const char *)client->userinfo);
-			}
-		}
-	}
-
-	// write all configstrings (such as current capture score CS_SCORE1/2, etc...), including clients configstrings
-	// note: system configstrings will be filtered and excluded (there's a check function for that)
-	// and clients configstrings  will be automatically redirected to the specialized function (see the check function)
-	for (i = 0; i < MAX_CONFIGSTRINGS; i++)
-	{
-		// if the configstring pointer exists in memory (because we will check all the possible indexes,
-		// but we don't know if they really exist in memory and are used or not, so here we check for that)
-		if (sv.configstrings[i])
-		{
-			SV_DemoWriteConfigString(i, sv.configstrings[i]);
-		}
-	}
-
-	// write entities and players
-	Com_Memset(sv.demoEntities, 0, sizeof(sv.demoEntities));
-	Com_Memset(sv.demoPlayerStates, 0, sizeof(sv.demoPlayerStates));
+	// the first frame is always a keyframe, it holds initial clients userinfo, configstrings, entities and players
+	demoNextKeyframeTime = 0;
 
 	// end of frame
 	SV_DemoWriteFrame();
@@ -1669,6 +1729,26 @@ static void SV_DemoReadClientUserinfo(msg_t *msg)
 	// get userinfo
 	userinfo = MSG_ReadString(msg);
 
+	if (demoReadingKeyframe && userinfo[0])
+	{
+		demoKeyframeClients[num] = qtrue;
+	}
+
+	// keyframes repeat the userinfo of every client, don't bother the gamecode if nothing changed
+	// note: the server maintains the ip key (see SV_UserinfoChanged) which was filtered out of the demo
+	if (demoReadingKeyframe && client->demoClient && client->state >= CS_CONNECTED)
+	{
+		char keyframeUserinfo[MAX_INFO_STRING];
+
+		Q_strncpyz(keyframeUserinfo, userinfo, sizeof(keyframeUserinfo));
+		Info_SetValueForKey(keyframeUserinfo, "ip", "localhost");
+
+		if (!strcmp(client->userinfo, keyframeUserinfo))
+		{
+			return;
+		}
+	}
+
 	client->demoClient = qtrue;
 
 	entity = SV_GentityNum(num);
@@ -1825,6 +1905,70 @@ static void SV_DemoReadAllEntityShared(msg_t *msg)
 	}
 }
 
+/**
+ * @brief Read a keyframe marker and reset the demo states, the entities and players that follow are delta'd against null states
+ * @param[in] msg
+ *
+ * @note Entities linked by the demo are unlinked, those still present in the keyframe will be linked again when their entityShared_t is read.
+ */
+static void SV_DemoReadKeyFrame(msg_t *msg)
+{
+	sharedEntity_t *entity;
+	int            i;
+
+	(void) MSG_ReadLong(msg); // time
+	(void) MSG_ReadLong(msg); // gamestate
+
+	for (i = 0; i < MAX_GENTITIES; i++)
+	{
+		// don't touch real clients
+		if (i >= sv_democlients->integer && i < MAX_CLIENTS)
+		{
+			continue;
+		}
+
+		if (sv.demoEntities[i].r.linked)
+		{
+			entity = SV_GentityNum(i);
+			if (entity->r.linked)
+			{
+				SV_UnlinkEntity(entity);
+			}
+		}
+	}
+
+	Com_Memset(sv.demoEntities, 0, sizeof(sv.demoEntities));
+	Com_Memset(sv.demoPlayerStates, 0, sizeof(sv.demoPlayerStates));
+	Com_Memset(demoKeyframeClients, 0, sizeof(demoKeyframeClients));
+
+	demoReadingKeyframe = qtrue;
+}
+
+/**
+ * @brief Drop the democlients a keyframe doesn't hold anymore
+ *
+ * @details A seek skips the frames in between, including the disconnects of democlients that left meanwhile,
+ * so every democlient without userinfo in the keyframe is dropped the same way a recorded disconnect would.
+ */
+static void SV_DemoDropKeyFrameMissingClients(void)
+{
+	client_t *client;
+	int      i;
+
+	for (i = 0; i < sv_democlients->integer; i++)
+	{
+		client = &svs.clients[i];
+
+		if (!client->demoClient || client->state < CS_CONNECTED || demoKeyframeClients[i])
+		{
+			continue;
+		}
+
+		SV_DropClient(client, "disconnected");
+		SV_SetConfigstring(CS_PLAYERS + i, "");
+	}
+}
+
 /**
  * @brief Load into memory all stored demo players states and entities
  *        (which effectively overwrites the one that were previously written by the game since SV_ReadFrame is called at the very end of every game's frame iteration).
@@ -2001,6 +2145,11 @@ read_next_demo_event: // used to read next demo event
 			case demo_entityShared:
 				SV_DemoReadAllEntityShared(&msg);
 				break;
+
+			// keyframe marker, reset the states the following frame is delta'd against
+			case demo_keyFrame:
+				SV_DemoReadKeyFrame(&msg);
+				break;
 			/*
 			case demo_clientUsercmd:
 			    SV_DemoReadClientUsercmd(&msg);
@@ -2014,6 +2163,12 @@ read_next_demo_event: // used to read next demo event
 			// then release the demo frame reading here to the next server (and demo) frame
 			case demo_endFrame:
 
+				if (demoReadingKeyframe)
+				{
+					SV_DemoDropKeyFrameMissingClients();
+					demoReadingKeyframe = qfalse;
+				}
+
 				// update entities
 				SV_DemoReadRefreshEntities();     // load into memory the demo entities (overwriting any change the game may have done)
 				// set the server time
@@ -2298,6 +2453,139 @@ static void SV_CompleteDemoName(char *args, int argNum)
 	}
 }
 
+/**
+ * @brief Scan the demo file once for keyframes and store their position
+ *
+ * @details Only the demo messages are parsed, no event is replayed.
+ * The file position is restored afterwards.
+ */
+static void SV_DemoIndexKeyframes(void)
+{
+	msg_t msg;
+	int   pos, offset, len, r;
+
+	if (demoKeyframesIndexed)
+	{
+		return;
+	}
+
+	demoKeyframesIndexed = qtrue;
+	demoKeyframesCount   = 0;
+
+	pos    = FS_FTell(sv.demoFile);
+	offset = demoFramesOffset;
+	FS_Seek(sv.demoFile, offset, FS_SEEK_SET);
+
+	MSG_Init(&msg, buf, sizeof(buf));
+
+	while (demoKeyframesCount < MAX_DEMO_KEYFRAMES)
+	{
+		r = FS_Read(&len, 4, sv.demoFile);
+		if (r != 4)
+		{
+			break;
+		}
+
+		len = LittleLong(len);
+		if (len <= 0 || len > msg.maxsize)
+		{
+			break;
+		}
+
+		MSG_BeginReading(&msg);
+		msg.cursize = len;
+		r           = FS_Read(msg.data, len, sv.demoFile);
+		if (r != len)
+		{
+			break;
+		}
+
+		if (MSG_ReadByte(&msg) == demo_keyFrame)
+		{
+			demoKeyframes[demoKeyframesCount].offset    = offset;
+			demoKeyframes[demoKeyframesCount].time      = MSG_ReadLong(&msg);
+			demoKeyframes[demoKeyframesCount].gamestate = MSG_ReadLong(&msg);
+			demoKeyframesCount++;
+		}
+
+		offset += 4 + len;
+	}
+
+	FS_Seek(sv.demoFile, pos, FS_SEEK_SET);
+
+	Com_DPrintf("SV_DemoIndexKeyframes: %i keyframes in %s\n", demoKeyframesCount, sv.demoName);
+}
+
+/**
+ * @brief Seek forward in the demo being played
+ *
+ * @details Jumps to the last keyframe before the wanted time, then only the remaining frames are replayed.
+ * Demos recorded without keyframes are replayed frame by frame.
+ *
+ * @param[in] timetoreach server time to reach
+ * @param[in] stopOnGamestate stop when the gamestate changes (so it's easy to skip some parts like warmup)
+ */
+static void SV_DemoSeek(int timetoreach, qboolean stopOnGamestate)
+{
+	demoKeyframe_t *keyframe = NULL;
+	int            i, gamestate;
+
+	gamestate = Q_atoi(Info_ValueForKey(sv.configstrings[CS_WOLFINFO], "gamestate"));
+
+	SV_DemoIndexKeyframes();
+
+	for (i = 0; i < demoKeyframesCount; i++)
+	{
+		if (demoKeyframes[i].time <= sv.time)
+		{
+			continue;
+		}
+
+		// the gamestate changed before this keyframe, replay the frames in between to stop at the right time
+		if (demoKeyframes[i].time > timetoreach || (stopOnGamestate && demoKeyframes[i].gamestate != gamestate))
+		{
+			break;
+		}
+
+		keyframe = &demoKeyframes[i];
+	}
+
+	if (keyframe)
+	{
+		FS_Seek(sv.demoFile, keyframe->offset, FS_SEEK_SET);
+	}
+
+	while (sv.time < timetoreach)
+	{
+		if (SV_DemoReadFrame() || (stopOnGamestate && gamestate != Q_atoi(Info_ValueForKey(sv.configstrings[CS_WOLFINFO], "gamestate"))))
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * @brief SV_DemoCanSeek
+ * @return qtrue if a demo is being played and isn't frozen
+ */
+static qboolean SV_DemoCanSeek(void)
+{
+	if (sv.demoState != DS_PLAYBACK)
+	{
+		Com_Printf("No demo is currently being played.\n");
+		return qfalse;
+	}
+
+	// frozen demos don't advance in time
+	if (sv_freezeDemo->integer)
+	{
+		Com_Printf("Demo is frozen.\n");
+		return qfalse;
+	}
+
+	return qtrue;
+}
+
 /**
 * @brief SV_Demo_Fastforward_f
 *
@@ -2306,7 +2594,7 @@ static void SV_CompleteDemoName(char *args, int argNum)
 */
 static void SV_Demo_Fastforward_f(void)
 {
-	int timetoreach, gamestate;
+	int timetoreach;
 
 	if (Cmd_Argc() != 2)
 	{
@@ -2314,9 +2602,8 @@ static void SV_Demo_Fastforward_f(void)
 		return;
 	}
 
-	if (sv.demoState != DS_PLAYBACK)
+	if (!SV_DemoCanSeek())
 	{
-		Com_Printf("No demo is currently being played.\n");
 		return;
 	}
 
@@ -2328,16 +2615,58 @@ static void SV_Demo_Fastforward_f(void)
 		return;
 	}
 
-	timetoreach = sv.time + (timetoreach * 1000);
-	gamestate   = Q_atoi(Info_ValueForKey(sv.configstrings[CS_WOLFINFO], "gamestate"));
+	SV_DemoSeek(sv.time + (timetoreach * 1000), qtrue);
+}
 
-	while (sv.time < timetoreach)
+/**
+* @brief SV_Demo_Seek_f
+*
+* @details Seek to a position from the start of the demo, given in seconds or minutes:seconds.
+*
+*/
+static void SV_Demo_Seek_f(void)
+{
+	const char *arg, *sep;
+	int        timetoreach;
+
+	if (Cmd_Argc() != 2)
 	{
-		if (SV_DemoReadFrame() || gamestate != Q_atoi(Info_ValueForKey(sv.configstrings[CS_WOLFINFO], "gamestate")))
-		{
-			break;
-		}
+		Com_Printf("Usage: demo_seek <[minutes:]seconds>\n");
+		return;
+	}
+
+	if (!SV_DemoCanSeek())
+	{
+		return;
 	}
+
+	arg = Cmd_Argv(1);
+	sep = strchr(arg, ':');
+
+	if (sep)
+	{
+		timetoreach = Q_atoi(arg) * 60 + Q_atoi(sep + 1);
+	}
+	else
+	{
+		timetoreach = Q_atoi(arg);
+	}
+
+	if (timetoreach < 0)
+	{
+		Com_Printf("Bad argument.\n");
+		return;
+	}
+
+	timetoreach = demoStartTime + (timetoreach * 1000);
+
+	if (timetoreach <= sv.time)
+	{
+		Com_Printf("Can't seek backwards, current position is %i:%02i.\n", (sv.time - demoStartTime) / 60000, ((sv.time - demoStartTime) / 1000) % 60);
+		return;
+	}
+
+	SV_DemoSeek(timetoreach, qfalse);
 }
 
 /**
@@ -2350,6 +2679,7 @@ void SV_DemoInit(void)
 	Cmd_AddCommand("demo_autoplay", SV_Demo_AutoPlay_f, va("Plays demos from a folder. (Max %i)", MAX_DEMO_AUTOPLAY));
 	Cmd_AddCommand("demo_stop", SV_Demo_Stop_f, "Stops a demo record.");
 	Cmd_AddCommand("demo_ff", SV_Demo_Fastforward_f, "Fast-forwards a demo record.");
+	Cmd_AddCommand("demo_seek", SV_Demo_Seek_f, "Seeks to a position of a demo record.");
 }
 
 /**
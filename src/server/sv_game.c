@@ -47,8 +47,11 @@ botlib_export_t *botlib_export;
 
 static ext_trap_keys_t g_extensionTraps[] =
 {
-	{ "trap_DemoSupport_Legacy", G_DEMOSUPPORT, qfalse },
-	{ NULL,                      -1,            qfalse }
+	{ "trap_DemoSupport_Legacy",      G_DEMOSUPPORT,        qfalse },
+	{ "trap_GetTrapTable_Legacy",     G_GETTRAPTABLE,       qfalse },
+	{ "trap_CvarChanges_Legacy",      G_CVAR_CHANGES,       qfalse },
+	{ "trap_GetUserinfoValue_Legacy", G_GET_USERINFO_VALUE, qfalse },
+	{ NULL,                           -1,                   qfalse }
 };
 
 /**
@@ -420,6 +423,101 @@ void SV_GameBinaryMessageReceived(int cno, const char *buf, int buflen, int comm
 	VM_Call(gvm, GAME_MESSAGERECEIVED, cno, buf, buflen, commandTime);
 }
 
+/**
+ * @brief SV_GameTrace
+ * @param[out] results
+ * @param[in] start
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] end
+ * @param[in] passEntityNum
+ * @param[in] contentmask
+ */
+static void SV_GameTrace(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
+{
+	SV_Trace(results, start, mins, maxs, end, passEntityNum, contentmask, qfalse);
+}
+
+/**
+ * @brief SV_GameTraceCapsule
+ * @param[out] results
+ * @param[in] start
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] end
+ * @param[in] passEntityNum
+ * @param[in] contentmask
+ */
+static void SV_GameTraceCapsule(trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask)
+{
+	SV_Trace(results, start, mins, maxs, end, passEntityNum, contentmask, qtrue);
+}
+
+/**
+ * @brief SV_GameEntityContact
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] gEnt
+ * @return
+ */
+static qboolean SV_GameEntityContact(const vec3_t mins, const vec3_t maxs, const sharedEntity_t *gEnt)
+{
+	return SV_EntityContact(mins, maxs, gEnt, qfalse);
+}
+
+/**
+ * @brief SV_GameEntityContactCapsule
+ * @param[in] mins
+ * @param[in] maxs
+ * @param[in] gEnt
+ * @return
+ */
+static qboolean SV_GameEntityContactCapsule(const vec3_t mins, const vec3_t maxs, const sharedEntity_t *gEnt)
+{
+	return SV_EntityContact(mins, maxs, gEnt, qtrue);
+}
+
+/**
+ * @var sv_gameTrapTable
+ * @brief Hot traps handed to the game module, see gameTrapTable_t
+ */
+static const gameTrapTable_t sv_gameTrapTable =
+{
+	SV_GameTrace,
+	SV_GameTraceCapsule,
+	SV_PointContents,
+	SV_LinkEntity,
+	SV_UnlinkEntity,
+	SV_AreaEntities,
+	SV_GameEntityContact,
+	SV_GameEntityContactCapsule,
+	SV_inPVS,
+	SV_inPVSIgnorePortals,
+	CM_AreasConnected,
+	SV_GetUsercmd,
+	Cvar_Update,
+	Sys_Milliseconds
+};
+
+/**
+ * @brief Fills the direct trap table of the game module
+ * @param[out] table
+ * @param[in] version - GAME_TRAP_TABLE_VERSION the game was built with
+ * @param[in] size - sizeof(gameTrapTable_t) the game was built with
+ * @return qfalse if the game has to stay on the syscall
+ */
+static qboolean SV_GetGameTrapTable(gameTrapTable_t *table, int version, int size)
+{
+	if (!table || version != GAME_TRAP_TABLE_VERSION || size != sizeof(gameTrapTable_t))
+	{
+		Com_DPrintf("SV_GetGameTrapTable: game trap table version %i (%i bytes) not supported, using syscalls\n", version, size);
+		return qfalse;
+	}
+
+	Com_Memcpy(table, &sv_gameTrapTable, sizeof(gameTrapTable_t));
+	return qtrue;
+}
+
 //==============================================
 
 extern int S_RegisterSound(const char *name, qboolean compressed);
@@ -702,6 +800,12 @@ intptr_t SV_GameSystemCalls(intptr_t *args)
 	case G_DEMOSUPPORT:
 		SV_DemoSupport(VMA(1));
 		return 0;
+	case G_GETTRAPTABLE:
+		return SV_GetGameTrapTable(VMA(1), args[2], args[3]);
+	case G_CVAR_CHANGES:
+		return Cvar_Changes(VMA(1), VMA(2), args[3]);
+	case G_GET_USERINFO_VALUE:
+		return SV_GetUserinfoValue(args[1], VMA(2), VMA(3), args[4]);
 
 	case G_TRAP_GETVALUE:
 		return VM_Ext_GetValue(VMA(1), args[2], VMA(3));
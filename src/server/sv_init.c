@@ -42,6 +42,19 @@
 // we even log attacks when the server is waiting for rcon and doesn't run a map
 int attHandle = 0; // server attack log file handle
 
+/**
+ * @brief Replaces a configstring and keeps the total length of all configstrings up to date
+ * @param[in] index
+ * @param[in] val
+ */
+static void SV_ReplaceConfigstring(int index, const char *val)
+{
+	sv.configstringsTotal += (int)strlen(val) - (int)strlen(sv.configstrings[index]);
+
+	Z_Free(sv.configstrings[index]);
+	sv.configstrings[index] = CopyString(val);
+}
+
 /**
  * @brief SV_SetConfigstringNoUpdate
  * @param[in] index
@@ -66,8 +79,7 @@ void SV_SetConfigstringNoUpdate(int index, const char *val)
 	}
 
 	// change the string in sv
-	Z_Free(sv.configstrings[index]);
-	sv.configstrings[index] = CopyString(val);
+	SV_ReplaceConfigstring(index, val);
 }
 
 /**
@@ -94,9 +106,13 @@ void SV_SetConfigstring(int index, const char *val)
 	}
 
 	// change the string in sv
-	Z_Free(sv.configstrings[index]);
-	sv.configstrings[index]         = CopyString(val);
-	sv.configstringsmodified[index] = qtrue;
+	SV_ReplaceConfigstring(index, val);
+
+	if (!sv.configstringsmodified[index])
+	{
+		sv.configstringsmodified[index]                         = qtrue;
+		sv.modifiedConfigstrings[sv.numModifiedConfigstrings++] = index;
+	}
 
 	if (svcls.isTVGame && svcls.state != CA_LOADING &&
 	    (index == CS_SERVERINFO || index == CS_WOLFINFO))
@@ -113,113 +129,162 @@ void SV_SetConfigstring(int index, const char *val)
 
 #define NEXT_WARNING_TIME 5000
 
+#define MAX_CONFIGSTRING_COMMANDS (MAX_GAMESTATE_CHARS / (MAX_STRING_CHARS - 25) + 1)
+
 /**
- * @brief Updates the configstring
- * @note It's nice to know this function sends several server commands when a configstring is greater than 1000 usually BIG_INFO_STRINGs
+ * @brief SV_CompareConfigstringIndexes
+ * @param[in] a
+ * @param[in] b
+ * @return
  */
-void SV_UpdateConfigStrings(void)
+static int QDECL SV_CompareConfigstringIndexes(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+/**
+ * @brief Encodes a configstring into its "cs" command, or the "bcs0" "bcs1" ... "bcs2"
+ * sequence for long strings
+ * @param[in] index
+ * @param[out] commands - room for MAX_CONFIGSTRING_COMMANDS
+ * @return Number of commands, release each of them with SV_ReleaseServerCommand
+ */
+static int SV_EncodeConfigstring(int index, serverCommand_t **commands)
 {
-	client_t   *client;
-	int        len, i, index, sent, remaining, cstotal = 0;
+	int        len, sent, remaining, numCommands = 0;
 	int        maxChunkSize = MAX_STRING_CHARS - 24;
 	const char *cmd;
 	char       buf[MAX_STRING_CHARS];
-	static int nextWarningSysInfoTime   = 0;
-	static int nextWarningGameStateTime = 0;
 
-	for (index = 0; index < MAX_CONFIGSTRINGS; index++)
+	len = strlen(sv.configstrings[index]);
+	if (len >= maxChunkSize)
 	{
-		if (sv.configstrings[index][0])
-		{
-			// get total CS length
-			cstotal += strlen(sv.configstrings[index]);
+		sent      = 0;
+		remaining = len;
 
-			if (index == CS_SYSTEMINFO)
+		while (remaining > 0)
+		{
+			// can't be part of a gamestate anyway
+			if (numCommands == MAX_CONFIGSTRING_COMMANDS)
 			{
-				if (nextWarningSysInfoTime <= svs.time)
-				{
-					nextWarningSysInfoTime = svs.time + NEXT_WARNING_TIME;
+				Com_Printf(S_COLOR_YELLOW "WARNING: configstring %i truncated to %i chars\n", index, sent);
+				break;
+			}
 
-					// about 10% of BIG_INFO_VALUE - this grants the server will start properly
-					// but total CS limit might be reached soon when CS_SYSTEMINFO uses nearly half of total CS
-					// warn admins
-					if (strlen(sv.configstrings[index]) > BIG_INFO_VALUE - 800)
-					{
-						Com_Printf(S_COLOR_YELLOW "WARNING: Your server nearly reached a configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", (int) (BIG_INFO_VALUE - strlen(sv.configstrings[index])));
-					}
-				}
+			if (sent == 0)
+			{
+				cmd = "bcs0";
+			}
+			else if (remaining < maxChunkSize)
+			{
+				cmd = "bcs2";
 			}
+			else
+			{
+				cmd = "bcs1";
+			}
+
+			Q_strncpyz(buf, &sv.configstrings[index][sent], maxChunkSize);
+
+			commands[numCommands++] = SV_AllocServerCommand(va("%s %i \"%s\"\n", cmd, index, buf));
+
+			sent      += (maxChunkSize - 1);
+			remaining -= (maxChunkSize - 1);
 		}
+	}
+	else
+	{
+		// standard cs, just send it
+		commands[numCommands++] = SV_AllocServerCommand(va("cs %i \"%s\"\n", index, sv.configstrings[index]));
+	}
+
+	return numCommands;
+}
+
+/**
+ * @brief Sends the configstrings modified since the last call
+ * @note It's nice to know this function sends several server commands when a configstring is greater than 1000 usually BIG_INFO_STRINGs
+ */
+void SV_UpdateConfigStrings(void)
+{
+	client_t        *client;
+	int             i, j, k, index, numCommands;
+	serverCommand_t *commands[MAX_CONFIGSTRING_COMMANDS];
+	static int      nextWarningSysInfoTime   = 0;
+	static int      nextWarningGameStateTime = 0;
 
-		if (!sv.configstringsmodified[index])
+	if (sv.configstrings[CS_SYSTEMINFO] && sv.configstrings[CS_SYSTEMINFO][0] && nextWarningSysInfoTime <= svs.time)
+	{
+		nextWarningSysInfoTime = svs.time + NEXT_WARNING_TIME;
+
+		// about 10% of BIG_INFO_VALUE - this grants the server will start properly
+		// but total CS limit might be reached soon when CS_SYSTEMINFO uses nearly half of total CS
+		// warn admins
+		if (strlen(sv.configstrings[CS_SYSTEMINFO]) > BIG_INFO_VALUE - 800)
 		{
-			continue;
+			Com_Printf(S_COLOR_YELLOW "WARNING: Your server nearly reached a configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", (int) (BIG_INFO_VALUE - strlen(sv.configstrings[CS_SYSTEMINFO])));
 		}
+	}
+
+	if (!sv.numModifiedConfigstrings)
+	{
+		return;
+	}
+
+	// keep sending them in index order
+	qsort(sv.modifiedConfigstrings, sv.numModifiedConfigstrings, sizeof(sv.modifiedConfigstrings[0]), SV_CompareConfigstringIndexes);
+
+	for (k = 0; k < sv.numModifiedConfigstrings; k++)
+	{
+		index = sv.modifiedConfigstrings[k];
+
 		sv.configstringsmodified[index] = qfalse;
 
 		// send it to all the clients if we aren't
 		// spawning a new server
-		if (sv.state == SS_GAME || sv.restarting)
+		if (sv.state != SS_GAME && !sv.restarting)
 		{
-			// send the data to all relevent clients
-			for (i = 0, client = svs.clients; i < sv_maxclients->integer ; i++, client++)
-			{
-				if (client->state < CS_PRIMED)
-				{
-					continue;
-				}
-				// do not always send server info to all clients
-				if (index == CS_SERVERINFO && client->gentity && (client->gentity->r.svFlags & SVF_NOSERVERINFO))
-				{
-					continue;
-				}
+			continue;
+		}
 
-				len = strlen(sv.configstrings[index]);
-				if (len >= maxChunkSize)
-				{
-					sent      = 0;
-					remaining = len;
+		// encode once, all clients share the commands
+		numCommands = SV_EncodeConfigstring(index, commands);
 
-					while (remaining > 0)
-					{
-						if (sent == 0)
-						{
-							cmd = "bcs0";
-						}
-						else if (remaining < maxChunkSize)
-						{
-							cmd = "bcs2";
-						}
-						else
-						{
-							cmd = "bcs1";
-						}
-
-						Q_strncpyz(buf, &sv.configstrings[index][sent], maxChunkSize);
-
-						SV_SendServerCommand(client, "%s %i \"%s\"\n", cmd, index, buf);
-
-						sent      += (maxChunkSize - 1);
-						remaining -= (maxChunkSize - 1);
-					}
-				}
-				else
-				{
-					// standard cs, just send it
-					SV_SendServerCommand(client, "cs %i \"%s\"\n", index, sv.configstrings[index]);
-				}
+		// send the data to all relevent clients
+		for (i = 0, client = svs.clients; i < sv_maxclients->integer ; i++, client++)
+		{
+			if (client->state < CS_PRIMED || client->demoClient)
+			{
+				continue;
+			}
+			// do not always send server info to all clients
+			if (index == CS_SERVERINFO && client->gentity && (client->gentity->r.svFlags & SVF_NOSERVERINFO))
+			{
+				continue;
+			}
+
+			for (j = 0; j < numCommands; j++)
+			{
+				SV_AddServerCommandShared(client, commands[j]);
 			}
 		}
 
-		if (nextWarningGameStateTime <= svs.time)
+		for (j = 0; j < numCommands; j++)
 		{
-			nextWarningGameStateTime = svs.time + NEXT_WARNING_TIME;
+			SV_ReleaseServerCommand(commands[j]);
+		}
+	}
 
-			// warn admins
-			if (cstotal > MAX_GAMESTATE_CHARS - 800) // 5% of MAX_GAMESTATE_CHARS
-			{
-				Com_Printf(S_COLOR_YELLOW "WARNING: Your clients might be disconnected by configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", MAX_GAMESTATE_CHARS - cstotal);
-			}
+	sv.numModifiedConfigstrings = 0;
+
+	if (nextWarningGameStateTime <= svs.time)
+	{
+		nextWarningGameStateTime = svs.time + NEXT_WARNING_TIME;
+
+		// warn admins
+		if (sv.configstringsTotal > MAX_GAMESTATE_CHARS - 800) // 5% of MAX_GAMESTATE_CHARS
+		{
+			Com_Printf(S_COLOR_YELLOW "WARNING: Your clients might be disconnected by configstring limit [%i chars left] - reduce the ammount of maps/pk3s in path\n", MAX_GAMESTATE_CHARS - sv.configstringsTotal);
 		}
 	}
 }
@@ -256,6 +321,8 @@ void SV_GetConfigstring(int index, char *buffer, unsigned int bufferSize)
  */
 void SV_SetUserinfo(int index, const char *val)
 {
+	const char *name;
+
 	if (index < 0 || index >= sv_maxclients->integer)
 	{
 		Com_Error(ERR_DROP, "SV_SetUserinfo: bad index %i", index);
@@ -267,7 +334,14 @@ void SV_SetUserinfo(int index, const char *val)
 	}
 
 	Q_strncpyz(svs.clients[index].userinfo, val, sizeof(svs.clients[index].userinfo));
-	Q_strncpyz(svs.clients[index].name, Info_ValueForKey(val, "name"), sizeof(svs.clients[index].name));
+	SV_InvalidateUserinfo(&svs.clients[index]);
+
+	name = SV_UserinfoValue(&svs.clients[index], "name");
+	if (strncmp(svs.clients[index].name, name, sizeof(svs.clients[index].name) - 1))
+	{
+		Q_strncpyz(svs.clients[index].name, name, sizeof(svs.clients[index].name));
+		SV_QueryPlayersChanged();
+	}
 
 	// Save userinfo changes to demo (also in SV_UpdateUserinfo_f() in sv_client.c)
 	if (sv.demoState == DS_RECORDING)
@@ -296,6 +370,237 @@ void SV_GetUserinfo(int index, char *buffer, unsigned int bufferSize)
 	Q_strncpyz(buffer, svs.clients[index].userinfo, bufferSize);
 }
 
+/**
+ * @brief Marks the parsed userinfo of a client as stale, call this whenever cl->userinfo is changed
+ * @param[in,out] cl
+ */
+void SV_InvalidateUserinfo(client_t *cl)
+{
+	cl->userinfoCache.valid = qfalse;
+}
+
+/**
+ * @brief SV_UserinfoHash
+ * @param[in] key
+ * @return Case insensitive hash of key, matching the Q_stricmp compare of Info_ValueForKey
+ */
+static int SV_UserinfoHash(const char *key)
+{
+	unsigned int hash = 0;
+	int          c;
+
+	while ((c = *key++) != 0)
+	{
+		if (c >= 'A' && c <= 'Z')
+		{
+			c += 'a' - 'A';
+		}
+		hash = hash * 31 + c;
+	}
+
+	return (int)(hash & (USERINFO_HASH_SIZE - 1));
+}
+
+/**
+ * @brief SV_UserinfoCacheFind
+ * @param[in] cache
+ * @param[in] key
+ * @return Value of key, NULL if the key is not set
+ */
+static const char *SV_UserinfoCacheFind(const userinfoCache_t *cache, const char *key)
+{
+	const char *p;
+	int        i;
+
+	for (i = cache->hashTable[SV_UserinfoHash(key)]; i >= 0; i = cache->next[i])
+	{
+		if (!Q_stricmp(cache->buffer + cache->keys[i], key))
+		{
+			return cache->buffer + cache->values[i];
+		}
+	}
+
+	// keys which didn't fit into the table follow the hashed ones
+	if (cache->overflowed)
+	{
+		p = cache->buffer + cache->unhashed;
+		while (p < cache->buffer + cache->end)
+		{
+			i  = Q_stricmp(p, key);
+			p += strlen(p) + 1;
+			if (!i)
+			{
+				return p;
+			}
+			p += strlen(p) + 1;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Splits the userinfo of a client into keys and values, if it changed since the last call
+ * @param[in,out] cl
+ * @return The parsed userinfo
+ *
+ * @note Follows Info_ValueForKey, the first occurrence of a key wins and a
+ * trailing key without a value is ignored.
+ */
+const userinfoCache_t *SV_ParsedUserinfo(client_t *cl)
+{
+	userinfoCache_t *cache = &cl->userinfoCache;
+	char            *s, *key, *value;
+	const char      *v;
+	int             hash, i;
+	qboolean        last;
+
+	if (cache->valid)
+	{
+		return cache;
+	}
+
+	Q_strncpyz(cache->buffer, cl->userinfo, sizeof(cache->buffer));
+	Com_Memset(cache->hashTable, -1, sizeof(cache->hashTable));
+	cache->numKeys    = 0;
+	cache->overflowed = qfalse;
+	cache->unhashed   = 0;
+	cache->end        = 0;
+
+	s = cache->buffer;
+	if (*s == '\\')
+	{
+		s++;
+	}
+
+	while (1)
+	{
+		key = s;
+		while (*s && *s != '\\')
+		{
+			s++;
+		}
+		if (!*s)
+		{
+			break;
+		}
+		*s++ = 0;
+
+		value = s;
+		while (*s && *s != '\\')
+		{
+			s++;
+		}
+		last = (*s == 0);
+		*s   = 0;
+
+		if (cache->overflowed)
+		{
+			cache->end = (short)(s + 1 - cache->buffer);
+		}
+		else
+		{
+			hash = SV_UserinfoHash(key);
+
+			for (i = cache->hashTable[hash]; i >= 0; i = cache->next[i])
+			{
+				if (!Q_stricmp(cache->buffer + cache->keys[i], key))
+				{
+					break;
+				}
+			}
+
+			if (i < 0)
+			{
+				if (cache->numKeys == MAX_USERINFO_KEYS)
+				{
+					cache->overflowed = qtrue;
+					cache->unhashed   = (short)(key - cache->buffer);
+					cache->end        = (short)(s + 1 - cache->buffer);
+				}
+				else
+				{
+					i                       = cache->numKeys++;
+					cache->keys[i]          = (short)(key - cache->buffer);
+					cache->values[i]        = (short)(value - cache->buffer);
+					cache->next[i]          = cache->hashTable[hash];
+					cache->hashTable[hash]  = (short)i;
+				}
+			}
+		}
+
+		if (last)
+		{
+			break;
+		}
+		s++;
+	}
+
+	cache->valid = qtrue;
+
+	// hot keys
+	// no pointers, client_t is copied around by SV_ChangeMaxClients
+	v           = SV_UserinfoCacheFind(cache, "name");
+	cache->name = v ? (short)(v - cache->buffer) : -1;
+
+	v              = SV_UserinfoCacheFind(cache, "rate");
+	cache->hasRate = (v && *v);
+	cache->rate    = cache->hasRate ? Q_atoi(v) : 0;
+
+	v               = SV_UserinfoCacheFind(cache, "snaps");
+	cache->hasSnaps = (v && *v);
+	cache->snaps    = cache->hasSnaps ? Q_atoi(v) : 0;
+
+	return cache;
+}
+
+/**
+ * @brief Looks up a key in the parsed userinfo of a client
+ * @param[in,out] cl
+ * @param[in] key
+ * @return The value, "" if the key is not set. Valid until the userinfo changes.
+ */
+const char *SV_UserinfoValue(client_t *cl, const char *key)
+{
+	const char *value;
+
+	if (!key)
+	{
+		return "";
+	}
+
+	value = SV_UserinfoCacheFind(SV_ParsedUserinfo(cl), key);
+
+	return value ? value : "";
+}
+
+/**
+ * @brief Copies a single userinfo value of a client, cheaper than SV_GetUserinfo followed by Info_ValueForKey
+ * @param[in] index
+ * @param[in] key
+ * @param[out] buffer
+ * @param[in] bufferSize
+ * @return Length of the value, may be larger than the copied string
+ */
+int SV_GetUserinfoValue(int index, const char *key, char *buffer, int bufferSize)
+{
+	const char *value;
+
+	if (bufferSize < 1)
+	{
+		Com_Error(ERR_DROP, "SV_GetUserinfoValue: bufferSize == %i", bufferSize);
+	}
+	if (index < 0 || index >= sv_maxclients->integer)
+	{
+		Com_Error(ERR_DROP, "SV_GetUserinfoValue: bad index %i", index);
+	}
+
+	value = SV_UserinfoValue(&svs.clients[index], key);
+	Q_strncpyz(buffer, value, bufferSize);
+
+	return (int)strlen(value);
+}
+
 /**
  * @brief Entity baselines are used to compress non-delta messages
  * to the clients -- only the fields that differ from the
@@ -455,6 +760,15 @@ void SV_ChangeMaxClients(void)
 		}
 	}
 
+	// release the commands of the clients which aren't copied over
+	for (i = 0 ; i < oldMaxClients ; i++)
+	{
+		if (svs.clients[i].state < CS_CONNECTED)
+		{
+			SV_FreeReliableCommands(&svs.clients[i]);
+		}
+	}
+
 	// free old clients arrays
 	//Z_Free( svs.clients );
 	Com_Dealloc(svs.clients);      // avoid trying to allocate large chunk on a fragmented zone
@@ -614,6 +928,15 @@ void SV_DemoChangeMaxClients(void)
 		Com_Memset(&oldClients[i], 0, sizeof(client_t));
 	}
 
+	// release the commands of the clients which aren't copied over
+	for (i = 0 ; i < oldMaxClients ; i++)
+	{
+		if (svs.clients[i].state < CS_CONNECTED)
+		{
+			SV_FreeReliableCommands(&svs.clients[i]);
+		}
+	}
+
 	// free old clients arrays
 	// avoid trying to allocate large chunk on a fragmented zone
 	Com_Dealloc(svs.clients);
@@ -956,6 +1279,10 @@ void SV_SpawnServer(const char *server)
 	SV_SetConfigstring(CS_WOLFINFO, Cvar_InfoString(CVAR_WOLFINFO));
 	cvar_modifiedFlags &= ~CVAR_WOLFINFO;
 
+	// new map, new clients array
+	SV_QueryInfoChanged();
+	SV_QueryPlayersChanged();
+
 	// any media configstring setting now should issue a warning
 	// and any configstring changes should be reliably transmitted
 	// to all clients
@@ -1213,14 +1540,17 @@ void SV_Init(void)
 	sv_protectLogInterval = Cvar_Get("sv_protectLogInterval", "1000", CVAR_ARCHIVE);
 	SV_InitAttackLog();
 
+	sv_queryThread = Cvar_Get("sv_queryThread", "0", CVAR_ARCHIVE);
+
 	// init the server side demo recording stuff
 	// serverside demo recording variables
-	sv_demoState    = Cvar_Get("sv_demoState", "0", CVAR_ROM);
-	sv_democlients  = Cvar_Get("sv_democlients", "0", CVAR_ROM);
-	sv_autoDemo     = Cvar_Get("sv_autoDemo", "0", CVAR_ARCHIVE);
-	sv_freezeDemo   = Cvar_Get("cl_freezeDemo", "0", CVAR_TEMP); // port from client-side to freeze server-side demos
-	sv_demoTolerant = Cvar_Get("sv_demoTolerant", "0", CVAR_ARCHIVE);
-	sv_demopath     = Cvar_Get("sv_demopath", "", CVAR_ARCHIVE);
+	sv_demoState     = Cvar_Get("sv_demoState", "0", CVAR_ROM);
+	sv_democlients   = Cvar_Get("sv_democlients", "0", CVAR_ROM);
+	sv_autoDemo      = Cvar_Get("sv_autoDemo", "0", CVAR_ARCHIVE);
+	sv_freezeDemo    = Cvar_Get("cl_freezeDemo", "0", CVAR_TEMP); // port from client-side to freeze server-side demos
+	sv_demoTolerant  = Cvar_Get("sv_demoTolerant", "0", CVAR_ARCHIVE);
+	sv_demopath      = Cvar_Get("sv_demopath", "", CVAR_ARCHIVE);
+	sv_demoKeyframes = Cvar_Get("sv_demoKeyframes", "30", CVAR_ARCHIVE);
 
 	// init the botlib here because we need the pre-compiler in the UI
 	SV_BotInitBotLib();
@@ -1231,14 +1561,15 @@ void SV_Init(void)
 
 	sv_serverTimeReset = Cvar_GetAndDescribe("sv_serverTimeReset", "0", CVAR_ARCHIVE_ND, "Reset server time on map change.");
 
-	sv_etltv_maxslaves  = Cvar_GetAndDescribe("sv_etltv_maxslaves", "0", CVAR_ARCHIVE_ND, "Number of ettv slaves allowed to connect.");
-	sv_etltv_password   = Cvar_GetAndDescribe("sv_etltv_password", "", CVAR_ARCHIVE_ND, "Password for ettv slaves. Must be set, or no slaves will be able to connect.");
-	sv_etltv_autorecord = Cvar_Get("sv_etltv_autorecord", "0", CVAR_ARCHIVE_ND);
-	sv_etltv_autoplay   = Cvar_Get("sv_etltv_autoplay", "0", CVAR_ARCHIVE_ND);
-	sv_etltv_clientname = Cvar_GetAndDescribe("sv_etltv_clientname", "ETLTV", CVAR_ARCHIVE_ND, "Name of the ETLTV client.");
-	sv_etltv_delay      = Cvar_GetAndDescribe("sv_etltv_delay", "0", CVAR_INIT, "Delay feed by number of seconds.");
-	sv_etltv_shownet    = Cvar_Get("sv_etltv_shownet", "0", CVAR_ARCHIVE_ND);
-	sv_etltv_queue_ms   = Cvar_Get("ettv_queue_ms", "-1", CVAR_ROM); // ettv_queue_ms for ettv backward compatibility
+	sv_etltv_maxslaves       = Cvar_GetAndDescribe("sv_etltv_maxslaves", "0", CVAR_ARCHIVE_ND, "Number of ettv slaves allowed to connect.");
+	sv_etltv_password        = Cvar_GetAndDescribe("sv_etltv_password", "", CVAR_ARCHIVE_ND, "Password for ettv slaves. Must be set, or no slaves will be able to connect.");
+	sv_etltv_autorecord      = Cvar_Get("sv_etltv_autorecord", "0", CVAR_ARCHIVE_ND);
+	sv_etltv_autoplay        = Cvar_Get("sv_etltv_autoplay", "0", CVAR_ARCHIVE_ND);
+	sv_etltv_clientname      = Cvar_GetAndDescribe("sv_etltv_clientname", "ETLTV", CVAR_ARCHIVE_ND, "Name of the ETLTV client.");
+	sv_etltv_delay           = Cvar_GetAndDescribe("sv_etltv_delay", "0", CVAR_INIT, "Delay feed by number of seconds.");
+	sv_etltv_shownet         = Cvar_Get("sv_etltv_shownet", "0", CVAR_ARCHIVE_ND);
+	sv_etltv_sharedSnapshots = Cvar_GetAndDescribe("sv_etltv_sharedSnapshots", "0", CVAR_ARCHIVE_ND, "Encode entities and playerstates once for all ettv slaves on the same delta base. Slaves don't receive the playerstates of other slaves.");
+	sv_etltv_queue_ms        = Cvar_Get("ettv_queue_ms", "-1", CVAR_ROM); // ettv_queue_ms for ettv backward compatibility
 
 #if defined(FEATURE_IRC_SERVER) && defined(DEDICATED)
 	IRC_Init();
@@ -1326,6 +1657,7 @@ void SV_Shutdown(const char *finalmsg)
 
 	SV_RemoveOperatorCommands();
 	SV_MasterShutdown();
+	SV_QueryShutdown();
 	SV_ShutdownGameProgs();
 
 	// SV_ShutdownGameProgs calls SV_DemoStopAll();
@@ -1341,6 +1673,7 @@ void SV_Shutdown(const char *finalmsg)
 		for (index = 0; index < sv_maxclients->integer; index++)
 		{
 			SV_Netchan_ClearQueue(&svs.clients[index]);
+			SV_FreeReliableCommands(&svs.clients[index]);
 		}
 
 		//Z_Free( svs.clients );
@@ -111,6 +111,7 @@ cvar_t *sv_protect;     // 0 - unprotected
                         // 4 - prints attack info to console (when ioquake3 or OPenWolf method is set)
 cvar_t *sv_protectLog;  // name of log file
 cvar_t *sv_protectLogInterval; // how often to write attack log entries
+cvar_t *sv_queryThread;        // answer getstatus/getinfo on a separate thread, dedicated only
 
 #ifdef FEATURE_ANTICHEAT
 cvar_t *sv_wh_active;
@@ -124,6 +125,7 @@ cvar_t *sv_demoState;
 cvar_t *sv_autoDemo;
 cvar_t *sv_freezeDemo;  // to freeze server-side demos
 cvar_t *sv_demoTolerant;
+cvar_t *sv_demoKeyframes;
 
 cvar_t *sv_ipMaxClients;
 
@@ -136,6 +138,7 @@ cvar_t *sv_etltv_autoplay;
 cvar_t *sv_etltv_clientname;
 cvar_t *sv_etltv_delay;
 cvar_t *sv_etltv_shownet;
+cvar_t *sv_etltv_sharedSnapshots;
 cvar_t *sv_etltv_queue_ms;
 
 static void SVC_Status(const netadr_t *from, qboolean force);
@@ -184,13 +187,84 @@ static char *SV_ExpandNewlines(char *in)
 }
 
 /**
- * @brief The given command will be transmitted to the client, and is guaranteed
- * to not have future snapshot_t executed before it is executed
- *
- * @param[in,out] client
+ * @brief Copies a reliable command into a shared buffer
  * @param[in] cmd
+ * @return The command with a single reference, release it with SV_ReleaseServerCommand
  */
-void SV_AddServerCommand(client_t *client, const char *cmd)
+serverCommand_t *SV_AllocServerCommand(const char *cmd)
+{
+	serverCommand_t *command;
+	int             length = (int)strlen(cmd);
+
+	// keep the limit of the former per client MAX_STRING_CHARS slots
+	if (length > MAX_STRING_CHARS - 1)
+	{
+		length = MAX_STRING_CHARS - 1;
+	}
+
+	command = Com_Allocate(sizeof(serverCommand_t) + length);
+	if (!command)
+	{
+		Com_Error(ERR_FATAL, "SV_AllocServerCommand: couldn't allocate %i bytes", length);
+	}
+
+	command->refCount = 1;
+	command->length   = length;
+	Com_Memcpy(command->string, cmd, length);
+	command->string[length] = '\0';
+
+	return command;
+}
+
+/**
+ * @brief SV_ReleaseServerCommand
+ * @param[in,out] command
+ */
+void SV_ReleaseServerCommand(serverCommand_t *command)
+{
+	if (--command->refCount == 0)
+	{
+		Com_Dealloc(command);
+	}
+}
+
+/**
+ * @brief SV_ReliableCommand
+ * @param[in] client
+ * @param[in] sequence
+ * @return Command text stored for sequence, "" if the slot was never used
+ */
+const char *SV_ReliableCommand(const client_t *client, int sequence)
+{
+	const serverCommand_t *command = client->reliableCommands[sequence & (MAX_RELIABLE_COMMANDS - 1)];
+
+	return command ? command->string : "";
+}
+
+/**
+ * @brief Drops the references of the reliable window, must be called before a client_t is cleared or freed
+ * @param[in,out] client
+ */
+void SV_FreeReliableCommands(client_t *client)
+{
+	int i;
+
+	for (i = 0; i < MAX_RELIABLE_COMMANDS; i++)
+	{
+		if (client->reliableCommands[i])
+		{
+			SV_ReleaseServerCommand(client->reliableCommands[i]);
+			client->reliableCommands[i] = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Adds a reference of command to the reliable window of client
+ * @param[in,out] client
+ * @param[in] command
+ */
+void SV_AddServerCommandShared(client_t *client, serverCommand_t *command)
 {
 	int index;
 
@@ -206,16 +280,36 @@ void SV_AddServerCommand(client_t *client, const char *cmd)
 		Com_Printf("===== pending server commands =====\n");
 		for (i = client->reliableAcknowledge + 1 ; i <= client->reliableSequence ; i++)
 		{
-			Com_Printf("cmd %5d: %s\n", i, client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]);
+			Com_Printf("cmd %5d: %s\n", i, SV_ReliableCommand(client, i));
 		}
 
-		Com_Printf("cmd %5d: %s\n", i, cmd);
+		Com_Printf("cmd %5d: %s\n", i, command->string);
 		SV_DropClient(client, "Server command overflow");
 		return;
 	}
 
 	index = client->reliableSequence & (MAX_RELIABLE_COMMANDS - 1);
-	Q_strncpyz(client->reliableCommands[index], cmd, sizeof(client->reliableCommands[index]));
+	if (client->reliableCommands[index])
+	{
+		SV_ReleaseServerCommand(client->reliableCommands[index]);
+	}
+	command->refCount++;
+	client->reliableCommands[index] = command;
+}
+
+/**
+ * @brief The given command will be transmitted to the client, and is guaranteed
+ * to not have future snapshot_t executed before it is executed
+ *
+ * @param[in,out] client
+ * @param[in] cmd
+ */
+void SV_AddServerCommand(client_t *client, const char *cmd)
+{
+	serverCommand_t *command = SV_AllocServerCommand(cmd);
+
+	SV_AddServerCommandShared(client, command);
+	SV_ReleaseServerCommand(command);
 }
 
 /**
@@ -229,10 +323,11 @@ void SV_AddServerCommand(client_t *client, const char *cmd)
  */
 void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 {
-	va_list  argptr;
-	byte     message[MAX_MSGLEN];
-	client_t *client;
-	int      j;
+	va_list         argptr;
+	byte            message[MAX_MSGLEN];
+	client_t        *client;
+	serverCommand_t *command;
+	int             j;
 
 	va_start(argptr, fmt);
 	Q_vsnprintf((char *)message, sizeof(message), fmt, argptr);
@@ -279,7 +374,9 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 		SV_DemoWriteServerCommand((char *)message);
 	}
 
-	// send the data to all relevant clients
+	// send the data to all relevant clients, they all share a single copy
+	command = SV_AllocServerCommand((char *)message);
+
 	for (j = 0, client = svs.clients; j < sv_maxclients->integer ; j++, client++)
 	{
 		if (client->state < CS_PRIMED)
@@ -292,8 +389,10 @@ void QDECL SV_SendServerCommand(client_t *cl, const char *fmt, ...)
 			continue;
 		}
 
-		SV_AddServerCommand(client, (char *)message);
+		SV_AddServerCommandShared(client, command);
 	}
+
+	SV_ReleaseServerCommand(command);
 }
 
 /*
@@ -577,9 +676,8 @@ CONNECTIONLESS COMMANDS
 ==============================================================================
 */
 
-static leakyBucket_t buckets[MAX_BUCKETS];
-static leakyBucket_t *bucketHashes[MAX_HASHES];
-leakyBucket_t        outboundLeakyBucket;
+static leakyBucketTable_t svcBuckets;
+leakyBucket_t             outboundLeakyBucket;
 
 /**
  * @brief SVC_HashForAddress
@@ -626,19 +724,20 @@ static long SVC_HashForAddress(const netadr_t *address)
 
 /**
  * @brief Find or allocate a bucket for an address
+ * @param[in,out] table
  * @param[in] address
  * @param[in] burst
  * @param[in] period
- * @return
+ * @return The bucket, NULL if the table is full
  */
-static leakyBucket_t *SVC_BucketForAddress(const netadr_t *address, int burst, int period)
+static leakyBucket_t *SVC_BucketForAddress(leakyBucketTable_t *table, const netadr_t *address, int burst, int period)
 {
 	leakyBucket_t *bucket = NULL;
 	int           i;
 	long          hash = SVC_HashForAddress(address);
 	int           now  = Sys_Milliseconds();
 
-	for (bucket = bucketHashes[hash]; bucket; bucket = bucket->next)
+	for (bucket = table->hashes[hash]; bucket; bucket = bucket->next)
 	{
 		switch (bucket->type)
 		{
@@ -666,7 +765,7 @@ static leakyBucket_t *SVC_BucketForAddress(const netadr_t *address, int burst, i
 	{
 		int interval;
 
-		bucket   = &buckets[i];
+		bucket   = &table->buckets[i];
 		interval = now - bucket->lastTime;
 
 		// Reclaim expired buckets
@@ -678,7 +777,7 @@ static leakyBucket_t *SVC_BucketForAddress(const netadr_t *address, int burst, i
 			}
 			else
 			{
-				bucketHashes[bucket->hash] = bucket->next;
+				table->hashes[bucket->hash] = bucket->next;
 			}
 
 			if (bucket->next != NULL)
@@ -709,36 +808,31 @@ static leakyBucket_t *SVC_BucketForAddress(const netadr_t *address, int burst, i
 			bucket->hash     = hash;
 
 			// Add to the head of the relevant hash chain
-			bucket->next = bucketHashes[hash];
-			if (bucketHashes[hash] != NULL)
+			bucket->next = table->hashes[hash];
+			if (table->hashes[hash] != NULL)
 			{
-				bucketHashes[hash]->prev = bucket;
+				table->hashes[hash]->prev = bucket;
 			}
 
-			bucket->prev       = NULL;
-			bucketHashes[hash] = bucket;
+			bucket->prev        = NULL;
+			table->hashes[hash] = bucket;
 
 			return bucket;
 		}
 	}
 
-	// Couldn't allocate a bucket for this address
-	// Write the info to the attack log since this is relevant information as the system is malfunctioning
-	SV_WriteAttackLogD(va("SVC_BucketForAddress: Could not allocate a bucket for client from %s\n", NET_AdrToString(address)));
-
 	return NULL;
 }
 
 /**
- * @brief SVC_RateLimit
+ * @brief Leaks the bucket and checks whether it overflows, without any logging
+ * so it can be used from the query thread too
  * @param[in,out] bucket
  * @param[in] burst
  * @param[in] period
- * @return
- *
- * @note Don't call if sv_protect 1 (SVP_IOQ3) flag is not set!
+ * @return qtrue if the limit is exceeded
  */
-qboolean SVC_RateLimit(leakyBucket_t *bucket, int burst, int period)
+qboolean SVC_RateLimitQuiet(leakyBucket_t *bucket, int burst, int period)
 {
 	if (bucket != NULL)
 	{
@@ -763,15 +857,49 @@ qboolean SVC_RateLimit(leakyBucket_t *bucket, int burst, int period)
 			bucket->burst++;
 			return qfalse;
 		}
-		else
-		{
-			SV_WriteAttackLogD(va("SVC_RateLimit: burst limit exceeded for bucket: %i limit: %i\n", bucket->burst, burst));
-		}
 	}
 
 	return qtrue;
 }
 
+/**
+ * @brief SVC_RateLimit
+ * @param[in,out] bucket
+ * @param[in] burst
+ * @param[in] period
+ * @return
+ *
+ * @note Don't call if sv_protect 1 (SVP_IOQ3) flag is not set!
+ */
+qboolean SVC_RateLimit(leakyBucket_t *bucket, int burst, int period)
+{
+	if (!SVC_RateLimitQuiet(bucket, burst, period))
+	{
+		return qfalse;
+	}
+
+	if (bucket != NULL)
+	{
+		SV_WriteAttackLogD(va("SVC_RateLimit: burst limit exceeded for bucket: %i limit: %i\n", bucket->burst, burst));
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief Rate limit for a particular address in a separate bucket table,
+ * without any logging
+ * @param[in,out] table
+ * @param[in] from
+ * @param[in] burst
+ * @param[in] period
+ * @return qtrue if the limit is exceeded
+ */
+qboolean SVC_RateLimitAddressQuiet(leakyBucketTable_t *table, const netadr_t *from, int burst, int period)
+{
+	return SVC_RateLimitQuiet(SVC_BucketForAddress(table, from, burst, period), burst, period);
+}
+
 /**
  * @brief Rate limit for a particular address
  * @param from
@@ -783,66 +911,45 @@ qboolean SVC_RateLimit(leakyBucket_t *bucket, int burst, int period)
  */
 qboolean SVC_RateLimitAddress(const netadr_t *from, int burst, int period)
 {
-	leakyBucket_t *bucket = SVC_BucketForAddress(from, burst, period);
+	leakyBucket_t *bucket = SVC_BucketForAddress(&svcBuckets, from, burst, period);
+
+	if (!bucket)
+	{
+		// Couldn't allocate a bucket for this address
+		// Write the info to the attack log since this is relevant information as the system is malfunctioning
+		SV_WriteAttackLogD(va("SVC_BucketForAddress: Could not allocate a bucket for client from %s\n", NET_AdrToString(from)));
+	}
 
 	return SVC_RateLimit(bucket, burst, period);
 }
 
 /**
- * @brief Send serverinfo cvars, etc to master servers when game complete or
- * by request of getstatus calls.
- *
- * Useful for tracking global player stats.
- *
- * @param[in] from
- * @param[in] force toggle rate limit checks
+ * @brief Builds the serverinfo part of a statusResponse, the challenge and
+ * version keys are added per request by SV_FormatStatusResponse
+ * @param[out] info MAX_INFO_STRING sized buffer
  */
-static void SVC_Status(const netadr_t *from, qboolean force)
+static void SV_BuildStatusInfo(char *info)
+{
+	Q_strncpyz(info, Cvar_InfoString(CVAR_SERVERINFO | CVAR_SERVERINFO_NOUPDATE), MAX_INFO_STRING);
+	Info_RemoveKey(info, "challenge");
+	Info_RemoveKey(info, "version");
+}
+
+/**
+ * @brief Builds the player lines of a statusResponse
+ * @param[out] players
+ * @param[in] size
+ */
+static void SV_BuildStatusPlayers(char *players, unsigned int size)
 {
 	char          player[1024];
-	char          status[MAX_MSGLEN];
 	int           i;
 	client_t      *cl;
 	playerState_t *ps;
-	unsigned int  statusLength;
+	unsigned int  statusLength = 0;
 	unsigned int  playerLength;
-	char          infostring[MAX_INFO_STRING];
 
-	if (!force && (sv_protect->integer & SVP_IOQ3))
-	{
-		// Prevent using getstatus as an amplifier
-		if (SVC_RateLimitAddress(from, 10, 1000))
-		{
-			SV_WriteAttackLog(va("SVC_Status: rate limit from %s exceeded, dropping request\n",
-			                     NET_AdrToString(from)));
-			return;
-		}
-
-		// Allow getstatus to be DoSed relatively easily, but prevent
-		// excess outbound bandwidth usage when being flooded inbound
-		if (SVC_RateLimit(&outboundLeakyBucket, 10, 100))
-		{
-			SV_WriteAttackLog("SVC_Status: rate limit exceeded, dropping request\n");
-			return;
-		}
-	}
-
-	// A maximum challenge length of 128 should be more than plenty.
-	if (strlen(Cmd_Argv(1)) > 128)
-	{
-		SV_WriteAttackLog(va("SVC_Status: challenge length exceeded from %s, dropping request\n", NET_AdrToString(from)));
-		return;
-	}
-
-	Q_strncpyz(infostring, Cvar_InfoString(CVAR_SERVERINFO | CVAR_SERVERINFO_NOUPDATE), sizeof(infostring));
-
-	// echo back the parameter to status. so master servers can use it as a challenge
-	// to prevent timed spoofed reply packets that add ghost servers
-	Info_SetValueForKey(infostring, "challenge", Cmd_Argv(1));
-	Info_SetValueForKey(infostring, "version", ET_VERSION);
-
-	status[0]    = 0;
-	statusLength = 0;
+	players[0] = 0;
 
 	for (i = 0 ; i < sv_maxclients->integer ; i++)
 	{
@@ -853,58 +960,25 @@ static void SVC_Status(const netadr_t *from, qboolean force)
 			Com_sprintf(player, sizeof(player), "%i %i \"%s\"\n",
 			            ps->persistant[PERS_SCORE], cl->ping, cl->name);
 			playerLength = strlen(player);
-			if (statusLength + playerLength >= sizeof(status))
+			if (statusLength + playerLength >= size)
 			{
 				break;      // can't hold any more
 			}
 
-			Q_strcat(status, sizeof(status), player);
+			Com_Memcpy(players + statusLength, player, playerLength + 1);
 			statusLength += playerLength;
 		}
 	}
-
-	NET_OutOfBandPrint(NS_SERVER, from, "statusResponse\n%s\n%s", infostring, status);
 }
 
 /**
- * @brief Responds with a short info message that should be enough to determine
- * if a user is interested in a server to do a full status
- *
- * @param[in] from
+ * @brief Builds an infoResponse without the challenge
+ * @param[out] info MAX_INFO_STRING sized buffer
  */
-static void SVC_Info(const netadr_t *from)
+static void SV_BuildInfo(char *info)
 {
 	int  i, clients = 0, humans = 0;
 	char *tmpString;
-	char infostring[MAX_INFO_STRING];
-
-	if (sv_protect->integer & SVP_IOQ3)
-	{
-		// Prevent using getinfo as an amplifier
-		if (SVC_RateLimitAddress(from, 10, 1000))
-		{
-			SV_WriteAttackLog(va("SVC_Info: rate limit from %s exceeded, dropping request\n",
-			                     NET_AdrToString(from)));
-			return;
-		}
-
-		// Allow getinfo to be DoSed relatively easily, but prevent
-		// excess outbound bandwidth usage when being flooded inbound
-		if (SVC_RateLimit(&outboundLeakyBucket, 10, 100))
-		{
-			SV_WriteAttackLog("SVC_Info: rate limit exceeded, dropping request\n");
-			return;
-		}
-	}
-
-	// Check whether Cmd_Argv(1) has a sane length. This was not done in the original Quake3 version which led
-	// to the Infostring bug discovered by Luigi Auriemma. See http://aluigi.altervista.org/ for the advisory.
-	// A maximum challenge length of 128 should be more than plenty.
-	if (strlen(Cmd_Argv(1)) > 128)
-	{
-		SV_WriteAttackLog(va("SVC_Info: challenge length from %s exceeded, dropping request\n", NET_AdrToString(from)));
-		return;
-	}
 
 	// count private clients too
 	for (i = 0 ; i < sv_maxclients->integer ; i++)
@@ -919,130 +993,469 @@ static void SVC_Info(const netadr_t *from)
 		}
 	}
 
-	infostring[0] = 0;
+	info[0] = 0;
 
-	// echo back the parameter to status. so servers can use it as a challenge
-	// to prevent timed spoofed reply packets that add ghost servers
-	Info_SetValueForKey(infostring, "challenge", Cmd_Argv(1));
-
-	Info_SetValueForKey(infostring, "version", ET_VERSION);
-	Info_SetValueForKey(infostring, "protocol", va("%i", PROTOCOL_VERSION));
-	Info_SetValueForKey(infostring, "hostname", sv_hostname->string);
-	Info_SetValueForKey(infostring, "serverload", va("%i", svs.serverLoad));
-	Info_SetValueForKey(infostring, "mapname", sv_mapname->string);
-	Info_SetValueForKey(infostring, "clients", va("%i", clients));
-	Info_SetValueForKey(infostring, "humans", va("%i", humans));
-	Info_SetValueForKey(infostring, "sv_maxclients", va("%i", sv_maxclients->integer - sv_privateClients->integer - sv_democlients->integer));
-	Info_SetValueForKey(infostring, "sv_privateclients", va("%i", sv_privateClients->integer));
-	Info_SetValueForKey(infostring, "gametype", va("%i", sv_gametype->integer));
-	Info_SetValueForKey(infostring, "pure", va("%i", sv_pure->integer));
+	Info_SetValueForKey(info, "version", ET_VERSION);
+	Info_SetValueForKey(info, "protocol", va("%i", PROTOCOL_VERSION));
+	Info_SetValueForKey(info, "hostname", sv_hostname->string);
+	Info_SetValueForKey(info, "serverload", va("%i", svs.serverLoad));
+	Info_SetValueForKey(info, "mapname", sv_mapname->string);
+	Info_SetValueForKey(info, "clients", va("%i", clients));
+	Info_SetValueForKey(info, "humans", va("%i", humans));
+	Info_SetValueForKey(info, "sv_maxclients", va("%i", sv_maxclients->integer - sv_privateClients->integer - sv_democlients->integer));
+	Info_SetValueForKey(info, "sv_privateclients", va("%i", sv_privateClients->integer));
+	Info_SetValueForKey(info, "gametype", va("%i", sv_gametype->integer));
+	Info_SetValueForKey(info, "pure", va("%i", sv_pure->integer));
 
 	if (sv_minPing->integer)
 	{
-		Info_SetValueForKey(infostring, "minPing", va("%i", sv_minPing->integer));
+		Info_SetValueForKey(info, "minPing", va("%i", sv_minPing->integer));
 	}
 	if (sv_maxPing->integer)
 	{
-		Info_SetValueForKey(infostring, "maxPing", va("%i", sv_maxPing->integer));
+		Info_SetValueForKey(info, "maxPing", va("%i", sv_maxPing->integer));
 	}
 
 	tmpString = Cvar_VariableString("fs_game");
 	if (*tmpString)
 	{
-		Info_SetValueForKey(infostring, "game", tmpString);
+		Info_SetValueForKey(info, "game", tmpString);
 	}
 
-	Info_SetValueForKey(infostring, "friendlyFire", va("%i", sv_friendlyFire->integer));
-	Info_SetValueForKey(infostring, "maxlives", va("%i", sv_maxlives->integer ? 1 : 0));
-	Info_SetValueForKey(infostring, "needpass", va("%i", sv_needpass->integer ? 1 : 0));
-	Info_SetValueForKey(infostring, "gamename", GAMENAME_STRING);
+	Info_SetValueForKey(info, "friendlyFire", va("%i", sv_friendlyFire->integer));
+	Info_SetValueForKey(info, "maxlives", va("%i", sv_maxlives->integer ? 1 : 0));
+	Info_SetValueForKey(info, "needpass", va("%i", sv_needpass->integer ? 1 : 0));
+	Info_SetValueForKey(info, "gamename", GAMENAME_STRING);
 
 	tmpString = Cvar_VariableString("g_antilag");
 	if (*tmpString)
 	{
-		Info_SetValueForKey(infostring, "g_antilag", tmpString);
+		Info_SetValueForKey(info, "g_antilag", tmpString);
 	}
 
 	tmpString = Cvar_VariableString("g_heavyWeaponRestriction");
 	if (*tmpString)
 	{
-		Info_SetValueForKey(infostring, "weaprestrict", tmpString);
+		Info_SetValueForKey(info, "weaprestrict", tmpString);
 	}
 
 	tmpString = Cvar_VariableString("g_balancedteams");
 	if (*tmpString)
 	{
-		Info_SetValueForKey(infostring, "balancedteams", tmpString);
+		Info_SetValueForKey(info, "balancedteams", tmpString);
 	}
 
 	tmpString = Cvar_VariableString("g_oss");
 	if (*tmpString)
 	{
-		Info_SetValueForKey(infostring, "oss", tmpString);
+		Info_SetValueForKey(info, "oss", tmpString);
 	}
-
-	NET_OutOfBandPrint(NS_SERVER, from, "infoResponse\n%s", infostring);
 }
 
 /**
- * @brief SV_FlushRedirect
- * @param[in] outputbuf
+ * @brief Formats an info key the way Info_SetValueForKey would append it,
+ * silently skipping values it would refuse
+ * @param[out] out
+ * @param[in] size
+ * @param[in] infoLength length of the info string the key is appended to
+ * @param[in] key
+ * @param[in] value
  */
-static void SV_FlushRedirect(char *outputbuf)
+static void SV_FormatInfoKey(char *out, int size, int infoLength, const char *key, const char *value)
 {
-	NET_OutOfBandPrint(NS_SERVER, &svs.redirectAddress, "print\n%s", outputbuf);
+	out[0] = 0;
+
+	if (!value[0] || strchr(value, '\\') || strchr(value, ';') || strchr(value, '\"'))
+	{
+		return;
+	}
+
+	Com_sprintf(out, size, "\\%s\\%s", key, value);
+
+	if (infoLength + strlen(out) >= MAX_INFO_STRING)
+	{
+		out[0] = 0;
+	}
 }
 
 /**
- * @brief DRDoS stands for "Distributed Reflected Denial of Service".
- * See here: http://www.lemuria.org/security/application-drdos.html
+ * @brief Formats a complete statusResponse packet with the challenge of the request
  *
- * If the address isn't NA_IP, it's automatically denied.
+ * Doesn't touch any shared state so the query thread can use it.
  *
- * @return qfalse if we're good.
- * otherwise qtrue means we need to block.
+ * @param[out] packet
+ * @param[in] size
+ * @param[in] info from SV_BuildStatusInfo
+ * @param[in] players from SV_BuildStatusPlayers
+ * @param[in] challenge echoed back so master servers can use it to prevent
+ * timed spoofed reply packets that add ghost servers
+ * @return Packet length
+ */
+int SV_FormatStatusResponse(char *packet, int size, const char *info, const char *players, const char *challenge)
+{
+	char challengeKey[MAX_INFO_STRING];
+	char versionKey[MAX_INFO_STRING];
+	int  infoLength = strlen(info);
+
+	SV_FormatInfoKey(challengeKey, sizeof(challengeKey), infoLength, "challenge", challenge);
+	SV_FormatInfoKey(versionKey, sizeof(versionKey), infoLength + strlen(challengeKey), "version", ET_VERSION);
+
+	Com_sprintf(packet, size, "\xff\xff\xff\xffstatusResponse\n%s%s%s\n%s", info, challengeKey, versionKey, players);
+
+	return strlen(packet);
+}
+
+/**
+ * @brief Formats a complete infoResponse packet with the challenge of the request
  *
- * @note Don't call this if sv_protect 2 flag is not set!
+ * Doesn't touch any shared state so the query thread can use it.
+ *
+ * @param[out] packet
+ * @param[in] size
+ * @param[in] info from SV_BuildInfo
+ * @param[in] challenge
+ * @return Packet length
  */
-static qboolean SV_CheckDRDoS(netadr_t from)
+int SV_FormatInfoResponse(char *packet, int size, const char *info, const char *challenge)
 {
-	int        i;
-	int        globalCount;
-	int        specificCount;
-	int        timeNow;
-	receipt_t  *receipt;
-	netadr_t   exactFrom;
-	int        oldest;
-	int        oldestTime;
-	static int lastGlobalLogTime   = 0;
-	static int lastSpecificLogTime = 0;
+	char challengeKey[MAX_INFO_STRING];
 
-	// Usually the network is smart enough to not allow incoming UDP packets
-	// with a source address being a spoofed LAN address.  Even if that's not
-	// the case, sending packets to other hosts in the LAN is not a big deal.
-	// NA_LOOPBACK qualifies as a LAN address.
-	if (Sys_IsLANAddress(&from))
+	SV_FormatInfoKey(challengeKey, sizeof(challengeKey), strlen(info), "challenge", challenge);
+
+	Com_sprintf(packet, size, "\xff\xff\xff\xffinfoResponse\n%s%s", challengeKey, info);
+
+	return strlen(packet);
+}
+
+static unsigned int queryInfoVersion    = 1;  ///< serverinfo, systeminfo and server load
+static unsigned int queryPlayersVersion = 1;  ///< player list, names, scores and pings
+
+/**
+ * @struct queryCache_t
+ * @brief Pre-rendered getstatus/getinfo bodies and the versions they were built for
+ */
+typedef struct
+{
+	unsigned int statusInfoVersion;
+	unsigned int statusPlayersVersion;
+	unsigned int infoVersion;
+	unsigned int infoPlayersVersion;
+
+	char statusInfo[MAX_INFO_STRING];
+	char statusPlayers[MAX_MSGLEN];
+	char info[MAX_INFO_STRING];
+} queryCache_t;
+
+static queryCache_t queryCache;
+
+/**
+ * @brief Invalidates the cached serverinfo parts of the query responses
+ */
+void SV_QueryInfoChanged(void)
+{
+	queryInfoVersion++;
+}
+
+/**
+ * @brief Invalidates the cached player parts of the query responses
+ */
+void SV_QueryPlayersChanged(void)
+{
+	queryPlayersVersion++;
+}
+
+/**
+ * @brief SV_QueryVersion
+ * @return A number that changes whenever any of the query responses changes
+ */
+unsigned int SV_QueryVersion(void)
+{
+	return queryInfoVersion + queryPlayersVersion;
+}
+
+/**
+ * @brief Cvars modified since the last frame haven't bumped the version yet
+ * @return qtrue if the cached serverinfo can't be trusted
+ */
+static qboolean SV_QueryInfoPending(void)
+{
+	return (cvar_modifiedFlags & (CVAR_SERVERINFO | CVAR_SERVERINFO_NOUPDATE | CVAR_SYSTEMINFO)) != 0;
+}
+
+/**
+ * @brief Catches score and ping changes, and clients that got connected or
+ * freed without passing SV_DirectConnect or SV_DropClient
+ */
+void SV_UpdateQueryPlayers(void)
+{
+	static struct
 	{
-		return qfalse;
+		qboolean connected;
+		int score;
+		int ping;
+	} last[MAX_CLIENTS];
+	int      i;
+	client_t *cl;
+	qboolean connected;
+	int      score, ping;
+	qboolean changed = qfalse;
+
+	for (i = 0, cl = svs.clients; i < sv_maxclients->integer; i++, cl++)
+	{
+		connected = cl->state >= CS_CONNECTED;
+		score     = connected ? SV_GameClientNum(i)->persistant[PERS_SCORE] : 0;
+		ping      = connected ? cl->ping : 0;
+
+		if (connected != last[i].connected || score != last[i].score || ping != last[i].ping)
+		{
+			last[i].connected = connected;
+			last[i].score     = score;
+			last[i].ping      = ping;
+			changed           = qtrue;
+		}
 	}
 
-	timeNow   = svs.time;
-	exactFrom = from;
+	if (changed)
+	{
+		SV_QueryPlayersChanged();
+	}
+}
 
-	// Time has wrapped
-	if (lastGlobalLogTime > timeNow || lastSpecificLogTime > timeNow)
+/**
+ * @brief SV_StatusInfo
+ * @return The serverinfo part of a statusResponse, rebuilt only if it changed
+ */
+const char *SV_StatusInfo(void)
+{
+	if (queryCache.statusInfoVersion != queryInfoVersion || SV_QueryInfoPending())
 	{
-		lastGlobalLogTime   = 0;
-		lastSpecificLogTime = 0;
+		SV_BuildStatusInfo(queryCache.statusInfo);
+		queryCache.statusInfoVersion = queryInfoVersion;
+	}
 
-		// just setting time to 1 (cannot be 0 as then globalCount would not be counted)
-		for (i = 0; i < MAX_INFO_RECEIPTS; i++)
+	return queryCache.statusInfo;
+}
+
+/**
+ * @brief SV_StatusPlayers
+ * @return The player lines of a statusResponse, rebuilt only if they changed
+ */
+const char *SV_StatusPlayers(void)
+{
+	if (queryCache.statusPlayersVersion != queryPlayersVersion)
+	{
+		SV_BuildStatusPlayers(queryCache.statusPlayers, sizeof(queryCache.statusPlayers));
+		queryCache.statusPlayersVersion = queryPlayersVersion;
+	}
+
+	return queryCache.statusPlayers;
+}
+
+/**
+ * @brief SV_Info
+ * @return The infoResponse without challenge, rebuilt only if it changed
+ */
+const char *SV_Info(void)
+{
+	if (queryCache.infoVersion != queryInfoVersion || queryCache.infoPlayersVersion != queryPlayersVersion
+	    || SV_QueryInfoPending())
+	{
+		SV_BuildInfo(queryCache.info);
+		queryCache.infoVersion        = queryInfoVersion;
+		queryCache.infoPlayersVersion = queryPlayersVersion;
+	}
+
+	return queryCache.info;
+}
+
+/**
+ * @brief Sends a statusResponse built from the cached bodies
+ * @param[in] from
+ * @param[in] challenge
+ */
+static void SV_SendStatusResponse(const netadr_t *from, const char *challenge)
+{
+	char packet[MAX_MSGLEN];
+	int  length;
+
+	length = SV_FormatStatusResponse(packet, sizeof(packet), SV_StatusInfo(), SV_StatusPlayers(), challenge);
+	NET_SendPacket(NS_SERVER, length, packet, from);
+}
+
+/**
+ * @brief Sends an infoResponse built from the cached body
+ * @param[in] from
+ * @param[in] challenge
+ */
+static void SV_SendInfoResponse(const netadr_t *from, const char *challenge)
+{
+	char packet[MAX_INFO_STRING + 256];
+	int  length;
+
+	length = SV_FormatInfoResponse(packet, sizeof(packet), SV_Info(), challenge);
+	NET_SendPacket(NS_SERVER, length, packet, from);
+}
+
+/**
+ * @brief Answers count getstatus and getinfo queries to the loopback address,
+ * once from the cache and once rebuilding every response, and prints the throughput
+ * @param[in] count
+ */
+void SV_QueryBenchmark(int count)
+{
+	netadr_t adr;
+	int      i, pass, type, start, msec;
+
+	Com_Memset(&adr, 0, sizeof(adr));
+	adr.type = NA_LOOPBACK;
+
+	for (type = 0; type < 2; type++)
+	{
+		for (pass = 0; pass < 2; pass++)
 		{
-			if (svs.infoReceipts[i].time)
+			start = Sys_Milliseconds();
+
+			for (i = 0; i < count; i++)
 			{
-				svs.infoReceipts[i].time = 1; // hack it so we count globalCount correctly
+				if (pass)
+				{
+					SV_QueryInfoChanged();
+					SV_QueryPlayersChanged();
+				}
+
+				if (type == 0)
+				{
+					SV_SendStatusResponse(&adr, "benchmark");
+				}
+				else
+				{
+					SV_SendInfoResponse(&adr, "benchmark");
+				}
 			}
+
+			msec = Sys_Milliseconds() - start;
+
+			Com_Printf("%s %-9s: %i queries in %i msec (%i/s)\n", type == 0 ? "getstatus" : "getinfo  ",
+			           pass ? "rebuilt" : "cached", count, msec, msec > 0 ? (int)(count * 1000LL / msec) : count * 1000);
+		}
+	}
+}
+
+/**
+ * @brief Send serverinfo cvars, etc to master servers when game complete or
+ * by request of getstatus calls.
+ *
+ * Useful for tracking global player stats.
+ *
+ * @param[in] from
+ * @param[in] force toggle rate limit checks
+ */
+static void SVC_Status(const netadr_t *from, qboolean force)
+{
+	if (!force && (sv_protect->integer & SVP_IOQ3))
+	{
+		// Prevent using getstatus as an amplifier
+		if (SVC_RateLimitAddress(from, 10, 1000))
+		{
+			SV_WriteAttackLog(va("SVC_Status: rate limit from %s exceeded, dropping request\n",
+			                     NET_AdrToString(from)));
+			return;
+		}
+
+		// Allow getstatus to be DoSed relatively easily, but prevent
+		// excess outbound bandwidth usage when being flooded inbound
+		if (SVC_RateLimit(&outboundLeakyBucket, 10, 100))
+		{
+			SV_WriteAttackLog("SVC_Status: rate limit exceeded, dropping request\n");
+			return;
+		}
+	}
+
+	// A maximum challenge length of 128 should be more than plenty.
+	if (strlen(Cmd_Argv(1)) > 128)
+	{
+		SV_WriteAttackLog(va("SVC_Status: challenge length exceeded from %s, dropping request\n", NET_AdrToString(from)));
+		return;
+	}
+
+	SV_SendStatusResponse(from, Cmd_Argv(1));
+}
+
+/**
+ * @brief Responds with a short info message that should be enough to determine
+ * if a user is interested in a server to do a full status
+ *
+ * @param[in] from
+ */
+static void SVC_Info(const netadr_t *from)
+{
+	if (sv_protect->integer & SVP_IOQ3)
+	{
+		// Prevent using getinfo as an amplifier
+		if (SVC_RateLimitAddress(from, 10, 1000))
+		{
+			SV_WriteAttackLog(va("SVC_Info: rate limit from %s exceeded, dropping request\n",
+			                     NET_AdrToString(from)));
+			return;
 		}
+
+		// Allow getinfo to be DoSed relatively easily, but prevent
+		// excess outbound bandwidth usage when being flooded inbound
+		if (SVC_RateLimit(&outboundLeakyBucket, 10, 100))
+		{
+			SV_WriteAttackLog("SVC_Info: rate limit exceeded, dropping request\n");
+			return;
+		}
+	}
+
+	// Check whether Cmd_Argv(1) has a sane length. This was not done in the original Quake3 version which led
+	// to the Infostring bug discovered by Luigi Auriemma. See http://aluigi.altervista.org/ for the advisory.
+	// A maximum challenge length of 128 should be more than plenty.
+	if (strlen(Cmd_Argv(1)) > 128)
+	{
+		SV_WriteAttackLog(va("SVC_Info: challenge length from %s exceeded, dropping request\n", NET_AdrToString(from)));
+		return;
+	}
+
+	SV_SendInfoResponse(from, Cmd_Argv(1));
+}
+
+/**
+ * @brief SV_FlushRedirect
+ * @param[in] outputbuf
+ */
+static void SV_FlushRedirect(char *outputbuf)
+{
+	NET_OutOfBandPrint(NS_SERVER, &svs.redirectAddress, "print\n%s", outputbuf);
+}
+
+/**
+ * @brief Counts the getinfo/getstatus receipts of the last two seconds and
+ * records a new one if the request may be answered
+ *
+ * Doesn't log anything so the query thread can use it with its own receipts.
+ *
+ * @param[in,out] receipts MAX_INFO_RECEIPTS entries
+ * @param[in] from
+ * @param[in] timeNow
+ * @return RECEIPT_OK, or why the request has to be blocked
+ */
+receiptCheck_t SV_CheckInfoReceipts(receipt_t *receipts, netadr_t from, int timeNow)
+{
+	int       i;
+	int       globalCount;
+	int       specificCount;
+	receipt_t *receipt;
+	int       oldest;
+	int       oldestTime;
+
+	// Usually the network is smart enough to not allow incoming UDP packets
+	// with a source address being a spoofed LAN address.  Even if that's not
+	// the case, sending packets to other hosts in the LAN is not a big deal.
+	// NA_LOOPBACK qualifies as a LAN address.
+	if (Sys_IsLANAddress(&from))
+	{
+		return RECEIPT_OK;
 	}
 
 	if (from.type == NA_IP)
@@ -1057,7 +1470,7 @@ static qboolean SV_CheckDRDoS(netadr_t from)
 	// Count receipts in last 2 seconds.
 	globalCount   = 0;
 	specificCount = 0;
-	receipt       = &svs.infoReceipts[0];
+	receipt       = &receipts[0];
 	oldest        = 0;
 	oldestTime    = 0x7fffffff;
 	for (i = 0; i < MAX_INFO_RECEIPTS; i++, receipt++)
@@ -1088,30 +1501,73 @@ static qboolean SV_CheckDRDoS(netadr_t from)
 
 	if (globalCount == MAX_INFO_RECEIPTS)   // All receipts happened in last 2 seconds.
 	{
+		return RECEIPT_FLOOD;
+	}
+	if (specificCount >= 3)   // Already sent 3 to this IP in last 2 seconds.
+	{
+		return RECEIPT_ADDRESS_FLOOD;
+	}
+
+	receipt       = &receipts[oldest];
+	receipt->adr  = from;
+	receipt->time = timeNow;
+	return RECEIPT_OK;
+}
+
+/**
+ * @brief DRDoS stands for "Distributed Reflected Denial of Service".
+ * See here: http://www.lemuria.org/security/application-drdos.html
+ *
+ * If the address isn't NA_IP, it's automatically denied.
+ *
+ * @return qfalse if we're good.
+ * otherwise qtrue means we need to block.
+ *
+ * @note Don't call this if sv_protect 2 flag is not set!
+ */
+static qboolean SV_CheckDRDoS(netadr_t from)
+{
+	int        i;
+	int        timeNow = svs.time;
+	static int lastGlobalLogTime   = 0;
+	static int lastSpecificLogTime = 0;
+
+	// Time has wrapped
+	if (lastGlobalLogTime > timeNow || lastSpecificLogTime > timeNow)
+	{
+		lastGlobalLogTime   = 0;
+		lastSpecificLogTime = 0;
+
+		// just setting time to 1 (cannot be 0 as then globalCount would not be counted)
+		for (i = 0; i < MAX_INFO_RECEIPTS; i++)
+		{
+			if (svs.infoReceipts[i].time)
+			{
+				svs.infoReceipts[i].time = 1; // hack it so we count globalCount correctly
+			}
+		}
+	}
+
+	switch (SV_CheckInfoReceipts(svs.infoReceipts, from, timeNow))
+	{
+	case RECEIPT_FLOOD:
 		if (lastGlobalLogTime + 1000 <= timeNow)  // Limit one log every second.
 		{
 			SV_WriteAttackLog("Detected flood of getinfo/getstatus connectionless packets\n");
 			lastGlobalLogTime = timeNow;
 		}
-
 		return qtrue;
-	}
-	if (specificCount >= 3)   // Already sent 3 to this IP in last 2 seconds.
-	{
+	case RECEIPT_ADDRESS_FLOOD:
 		if (lastSpecificLogTime + 1000 <= timeNow)   // Limit one log every second.
 		{
 			SV_WriteAttackLog(va("Possible DRDoS attack to address %s, ignoring getinfo/getstatus connectionless packet\n",
-			                     NET_AdrToString(&exactFrom)));
+			                     NET_AdrToString(&from)));
 			lastSpecificLogTime = timeNow;
 		}
-
 		return qtrue;
+	default:
+		return qfalse;
 	}
-
-	receipt       = &svs.infoReceipts[oldest];
-	receipt->adr  = from;
-	receipt->time = timeNow;
-	return qfalse;
 }
 
 /**
@@ -1243,6 +1699,11 @@ static void SV_ConnectionlessPacket(const netadr_t *from, msg_t *msg)
 			return;
 		}
 
+		if (SV_QueueQuery(from, QUERY_STATUS, Cmd_Argv(1)))
+		{
+			return;
+		}
+
 		if ((sv_protect->integer & SVP_OWOLF) && SV_CheckDRDoS(*from))
 		{
 			return;
@@ -1258,6 +1719,11 @@ static void SV_ConnectionlessPacket(const netadr_t *from, msg_t *msg)
 			return;
 		}
 
+		if (SV_QueueQuery(from, QUERY_INFO, Cmd_Argv(1)))
+		{
+			return;
+		}
+
 		if ((sv_protect->integer & SVP_OWOLF) && SV_CheckDRDoS(*from))
 		{
 			return;
@@ -1723,6 +2189,7 @@ void SV_Frame(int msec)
 	int        frameMsec;
 	char       mapname[MAX_QPATH];
 	int        frameStartTime = 0;
+	int        serverLoad;
 	static int start, end;
 
 	start           = Sys_Milliseconds();
@@ -1774,6 +2241,8 @@ void SV_Frame(int msec)
 		frameStartTime = Sys_Milliseconds();
 	}
 
+	serverLoad = svs.serverLoad;
+
 	// if it isn't time for the next frame, do nothing
 	if (sv_fps->integer < 1)
 	{
@@ -1815,6 +2284,12 @@ void SV_Frame(int msec)
 		return;
 	}
 
+	// the frame consumes the cvar modifications, the query responses have to follow them
+	if (cvar_modifiedFlags & (CVAR_SERVERINFO | CVAR_SERVERINFO_NOUPDATE | CVAR_SYSTEMINFO))
+	{
+		SV_QueryInfoChanged();
+	}
+
 	if (svcls.isTVGame)
 	{
 		SV_CL_Frame(frameMsec);
@@ -1824,9 +2299,15 @@ void SV_Frame(int msec)
 		SV_Frame_Ext(frameMsec);
 	}
 
+	// bump the query response versions on score and ping changes
+	SV_UpdateQueryPlayers();
+
 	// send a heartbeat to the master if needed
 	SV_MasterHeartbeat(HEARTBEAT_GAME);
 
+	// republish the getstatus/getinfo responses for the query thread
+	SV_QueryFrame();
+
 #ifdef FEATURE_TRACKER
 	Tracker_Frame(msec);
 #endif
@@ -1882,6 +2363,11 @@ void SV_Frame(int msec)
 		svs.serverLoad = -1;
 	}
 
+	if (svs.serverLoad != serverLoad)
+	{
+		SV_QueryInfoChanged();
+	}
+
 	// collect timing statistics
 	// - the above 2.60 performance thingy is just inaccurate (30 seconds 'stats')
 	//   to give good warning messages and is only done for dedicated
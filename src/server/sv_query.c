@@ -0,0 +1,327 @@
+/*
+ * Wolfenstein: Enemy Territory GPL Source Code
+ * Copyright (C) 1999-2010 id Software LLC, a ZeniMax Media company.
+ *
+ * ET: Legacy
+ * Copyright (C) 2012-2024 ET:Legacy team <mail@etlegacy.com>
+ *
+ * This file is part of ET: Legacy - http://www.etlegacy.com
+ *
+ * ET: Legacy is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ET: Legacy is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with ET: Legacy. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * In addition, Wolfenstein: Enemy Territory GPL Source Code is also
+ * subject to certain additional terms. You should have received a copy
+ * of these additional terms immediately following the terms and conditions
+ * of the GNU General Public License which accompanied the source code.
+ * If not, please request a copy in writing from id Software at the address below.
+ *
+ * id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+ */
+/**
+ * @file sv_query.c
+ * @brief Answers getstatus and getinfo queries on a separate thread
+ *
+ * SV_ConnectionlessPacket hands the queries over with SV_QueueQuery and
+ * SV_QueryFrame republishes the cached response bodies whenever their
+ * version changes. The query thread applies the sv_protect limits with its
+ * own buckets and receipts and sends the responses itself, so floods of
+ * queries no longer eat into the server frame.
+ */
+
+#include "server.h"
+
+#define MAX_QUEUED_QUERIES  256
+#define MAX_QUERY_CHALLENGE 128
+
+/**
+ * @struct queuedQuery_t
+ * @brief
+ */
+typedef struct
+{
+	netadr_t from;
+	queryType_t type;
+	char challenge[MAX_QUERY_CHALLENGE + 1];
+} queuedQuery_t;
+
+/**
+ * @struct queryThread_t
+ * @brief State shared between the main thread and the query thread
+ */
+typedef struct
+{
+	void *thread;
+	void *mutex;                            ///< protects everything below
+	void *wake;                             ///< posted once per queued query
+	qboolean quit;
+
+	queuedQuery_t queue[MAX_QUEUED_QUERIES];
+	unsigned int head;                      ///< next query to answer
+	unsigned int tail;                      ///< next free slot
+
+	unsigned int version;                   ///< SV_QueryVersion of the published bodies, 0 if none yet
+	char statusInfo[MAX_INFO_STRING];
+	char statusPlayers[MAX_MSGLEN];
+	char info[MAX_INFO_STRING];
+
+	int dropped;                            ///< rate limited or queue full since the last SV_QueryFrame
+} queryThread_t;
+
+static queryThread_t query;
+
+// only touched by the query thread
+static leakyBucketTable_t queryBuckets;
+static leakyBucket_t      queryOutboundBucket;
+static receipt_t          queryReceipts[MAX_INFO_RECEIPTS];
+
+/**
+ * @brief Applies the sv_protect limits of the main thread to a query
+ * @param[in] q
+ * @return qtrue if the query may be answered
+ */
+static qboolean SV_QueryAllowed(const queuedQuery_t *q)
+{
+	int protect = sv_protect->integer;
+
+	if ((protect & SVP_OWOLF) && SV_CheckInfoReceipts(queryReceipts, q->from, Sys_Milliseconds()) != RECEIPT_OK)
+	{
+		return qfalse;
+	}
+
+	if (protect & SVP_IOQ3)
+	{
+		// Prevent using getstatus/getinfo as an amplifier
+		if (SVC_RateLimitAddressQuiet(&queryBuckets, &q->from, 10, 1000))
+		{
+			return qfalse;
+		}
+
+		// Allow queries to be DoSed relatively easily, but prevent
+		// excess outbound bandwidth usage when being flooded inbound
+		if (SVC_RateLimitQuiet(&queryOutboundBucket, 10, 100))
+		{
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief SV_QueryThread
+ * @param arg - unused
+ */
+static void SV_QueryThread(void *arg)
+{
+	static char   statusInfo[MAX_INFO_STRING];
+	static char   statusPlayers[MAX_MSGLEN];
+	static char   info[MAX_INFO_STRING];
+	static char   packet[MAX_MSGLEN];
+	unsigned int  version = 0;
+	int           length;
+	queuedQuery_t q;
+
+	while (1)
+	{
+		Sys_SemaphoreWait(query.wake);
+
+		if (query.quit)
+		{
+			return;
+		}
+
+		Sys_LockMutex(query.mutex);
+
+		q = query.queue[query.head % MAX_QUEUED_QUERIES];
+		query.head++;
+
+		if (version != query.version)
+		{
+			Q_strncpyz(statusInfo, query.statusInfo, sizeof(statusInfo));
+			Q_strncpyz(statusPlayers, query.statusPlayers, sizeof(statusPlayers));
+			Q_strncpyz(info, query.info, sizeof(info));
+			version = query.version;
+		}
+
+		Sys_UnlockMutex(query.mutex);
+
+		if (!SV_QueryAllowed(&q))
+		{
+			Sys_LockMutex(query.mutex);
+			query.dropped++;
+			Sys_UnlockMutex(query.mutex);
+			continue;
+		}
+
+		if (q.type == QUERY_STATUS)
+		{
+			length = SV_FormatStatusResponse(packet, sizeof(packet), statusInfo, statusPlayers, q.challenge);
+		}
+		else
+		{
+			length = SV_FormatInfoResponse(packet, sizeof(packet), info, q.challenge);
+		}
+
+		Sys_SendPacketQuiet(length, packet, &q.from);
+	}
+}
+
+/**
+ * @brief Starts the query thread
+ * @return qfalse on failure
+ */
+static qboolean SV_QueryStart(void)
+{
+	Com_Memset(&query, 0, sizeof(query));
+	Com_Memset(&queryBuckets, 0, sizeof(queryBuckets));
+	Com_Memset(&queryOutboundBucket, 0, sizeof(queryOutboundBucket));
+	Com_Memset(queryReceipts, 0, sizeof(queryReceipts));
+
+	query.mutex = Sys_CreateMutex();
+	query.wake  = Sys_CreateSemaphore(0);
+
+	if (query.mutex && query.wake)
+	{
+		query.thread = Sys_CreateThread(SV_QueryThread, NULL);
+	}
+
+	if (!query.thread)
+	{
+		Com_Printf(S_COLOR_YELLOW "WARNING: SV_QueryStart: failed to create the query thread\n");
+		SV_QueryShutdown();
+		return qfalse;
+	}
+
+	Com_Printf("Answering getstatus/getinfo queries on a separate thread\n");
+	return qtrue;
+}
+
+/**
+ * @brief Stops the query thread, queries are answered by the main thread again
+ */
+void SV_QueryShutdown(void)
+{
+	if (query.thread)
+	{
+		query.quit = qtrue;
+		Sys_SemaphorePost(query.wake);
+		Sys_JoinThread(query.thread);
+	}
+
+	if (query.mutex)
+	{
+		Sys_DestroyMutex(query.mutex);
+	}
+	if (query.wake)
+	{
+		Sys_DestroySemaphore(query.wake);
+	}
+
+	Com_Memset(&query, 0, sizeof(query));
+}
+
+/**
+ * @brief Starts or stops the query thread following sv_queryThread and
+ * republishes the response bodies if they changed
+ */
+void SV_QueryFrame(void)
+{
+	unsigned int version;
+	const char   *statusInfo, *statusPlayers, *info;
+	int          dropped;
+
+	if (!com_dedicated->integer || !sv_queryThread->integer)
+	{
+		if (query.thread)
+		{
+			SV_QueryShutdown();
+		}
+		return;
+	}
+
+	if (!query.thread && !SV_QueryStart())
+	{
+		Cvar_Set("sv_queryThread", "0");
+		return;
+	}
+
+	// query.version is only written by this thread
+	version = SV_QueryVersion();
+
+	if (query.version != version)
+	{
+		statusInfo    = SV_StatusInfo();
+		statusPlayers = SV_StatusPlayers();
+		info          = SV_Info();
+
+		Sys_LockMutex(query.mutex);
+		Q_strncpyz(query.statusInfo, statusInfo, sizeof(query.statusInfo));
+		Q_strncpyz(query.statusPlayers, statusPlayers, sizeof(query.statusPlayers));
+		Q_strncpyz(query.info, info, sizeof(query.info));
+		query.version = version;
+		Sys_UnlockMutex(query.mutex);
+	}
+
+	Sys_LockMutex(query.mutex);
+
+	dropped       = query.dropped;
+	query.dropped = 0;
+
+	Sys_UnlockMutex(query.mutex);
+
+	if (dropped)
+	{
+		SV_WriteAttackLog(va("SV_QueryFrame: dropped %i getstatus/getinfo queries\n", dropped));
+	}
+}
+
+/**
+ * @brief Hands a getstatus or getinfo query over to the query thread
+ * @param[in] from
+ * @param[in] type
+ * @param[in] challenge
+ * @return qfalse if the main thread has to answer it
+ */
+qboolean SV_QueueQuery(const netadr_t *from, queryType_t type, const char *challenge)
+{
+	queuedQuery_t *q;
+
+	// nothing published yet, loopback and bots stay on the main thread,
+	// too long challenges get logged there
+	if (!query.thread || !query.version || (from->type != NA_IP && from->type != NA_IP6)
+	    || strlen(challenge) > MAX_QUERY_CHALLENGE)
+	{
+		return qfalse;
+	}
+
+	Sys_LockMutex(query.mutex);
+
+	if (query.tail - query.head >= MAX_QUEUED_QUERIES)
+	{
+		query.dropped++;
+		Sys_UnlockMutex(query.mutex);
+		return qtrue;
+	}
+
+	q       = &query.queue[query.tail % MAX_QUEUED_QUERIES];
+	q->from = *from;
+	q->type = type;
+	Q_strncpyz(q->challenge, challenge, sizeof(q->challenge));
+	query.tail++;
+
+	Sys_UnlockMutex(query.mutex);
+
+	Sys_SemaphorePost(query.wake);
+	return qtrue;
+}
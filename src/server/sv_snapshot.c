@@ -160,9 +160,10 @@ static void SV_EmitPacketEntities(client_t *client, clientSnapshot_t *from, clie
 /**
 * @brief Writes delta updates of playerstates to the message.
 * @param[in] client
-* @param[in] msg
+* @param[in] msg NULL to only store the playerstates in the client frame (the encoded data is shared, see SV_ETTV_EmitSharedPayload)
+* @param[in] shared skip all tv clients instead of only this one, so that the data is the same for all tv clients
 */
-static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg)
+static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg, qboolean shared)
 {
 	ettvClientSnapshot_t *frame, *oldframe = NULL;
 	client_t             *cl;
@@ -172,14 +173,20 @@ static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg)
 
 	if (client->deltaMessage <= 0 || client->state != CS_ACTIVE)
 	{
-		Com_DPrintf("%s: Non-Delta request from client. (deltaMessage: %d, state: %d)\n", client->name, client->deltaMessage, client->state);
+		if (msg)
+		{
+			Com_DPrintf("%s: Non-Delta request from client. (deltaMessage: %d, state: %d)\n", client->name, client->deltaMessage, client->state);
+		}
 	}
 	else if (client->netchan.outgoingSequence - client->deltaMessage < (PACKET_BACKUP - 3))
 	{
 		oldframe = client->ettvClientFrame[client->deltaMessage & PACKET_MASK];;
 	}
 
-	MSG_WriteByte(msg, svc_ettv_playerstates);
+	if (msg)
+	{
+		MSG_WriteByte(msg, svc_ettv_playerstates);
+	}
 
 	if (!svcls.isTVGame)
 	{
@@ -188,14 +195,19 @@ static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg)
 			cl             = &svs.clients[i];
 			frame[i].valid = qfalse;
 
-			if (cl->state == CS_ACTIVE && client != cl)
+			if (cl->state == CS_ACTIVE && client != cl && !(shared && cl->ettvClient))
 			{
-				// clientnum
-				MSG_WriteByte(msg, i);
-
 				frame[i].ps    = *SV_GameClientNum(i);
 				frame[i].valid = qtrue;
 
+				if (!msg)
+				{
+					continue;
+				}
+
+				// clientnum
+				MSG_WriteByte(msg, i);
+
 				if (!oldframe || !oldframe[i].valid)
 				{
 					MSG_WriteDeltaPlayerstate(msg, NULL, &frame[i].ps);
@@ -217,11 +229,16 @@ static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg)
 
 			if (SV_CL_GetPlayerstate(i, &frame[i].ps))
 			{
+				frame[i].valid = qtrue;
+
+				if (!msg)
+				{
+					continue;
+				}
+
 				// clientnum
 				MSG_WriteByte(msg, i);
 
-				frame[i].valid = qtrue;
-
 				if (!oldframe || !oldframe[i].valid)
 				{
 					MSG_WriteDeltaPlayerstate(msg, NULL, &frame[i].ps);
@@ -236,8 +253,166 @@ static void SV_ETTV_EmitPlayerstates(client_t *client, msg_t *msg)
 		}
 	}
 
-	// end of svc_ettv_playerstates
-	MSG_WriteByte(msg, 255);
+	if (msg)
+	{
+		// end of svc_ettv_playerstates
+		MSG_WriteByte(msg, 255);
+	}
+}
+
+#define ETTV_SHARED_PAYLOADS 4
+
+/**
+ * @struct ettvSharedPayload_s
+ * @brief Encoded packet entities and playerstates of a snapshot, shared by all tv clients on the same delta base
+ */
+typedef struct ettvSharedPayload_s
+{
+	int time;                           ///< svs.time of the snapshot, 0 if unused
+	int entitiesDeltaTime;              ///< server time of the snapshot the entities are delta'd from, -1 for none
+	int playerstatesDeltaTime;          ///< server time of the snapshot the playerstates are delta'd from, -1 for none
+	int strip;
+
+	int numEntities;
+	int entities[MAX_GENTITIES];
+	int numDeltaEntities;
+	int deltaEntities[MAX_GENTITIES];
+
+	msg_t msg;
+	byte data[MAX_MSGLEN];
+} ettvSharedPayload_t;
+
+static ettvSharedPayload_t ettvSharedPayloads[ETTV_SHARED_PAYLOADS];
+static int                 ettvSharedPayloadNext;
+
+/**
+ * @brief SV_ETTV_SnapshotEntitiesEqual
+ * @param[in] frame
+ * @param[in] numEntities
+ * @param[in] entities
+ * @return qtrue if the frame holds the same entities
+ */
+static qboolean SV_ETTV_SnapshotEntitiesEqual(clientSnapshot_t *frame, int numEntities, const int *entities)
+{
+	int i;
+
+	if (!frame)
+	{
+		return numEntities == 0;
+	}
+
+	if (frame->num_entities != numEntities)
+	{
+		return qfalse;
+	}
+
+	for (i = 0; i < numEntities; i++)
+	{
+		if (svs.snapshotEntities[(frame->first_entity + i) % svs.numSnapshotEntities].number != entities[i])
+		{
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/**
+ * @brief SV_ETTV_StoreSnapshotEntities
+ * @param[in] frame
+ * @param[out] entities
+ * @return number of entities
+ */
+static int SV_ETTV_StoreSnapshotEntities(clientSnapshot_t *frame, int *entities)
+{
+	int i;
+
+	if (!frame)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < frame->num_entities; i++)
+	{
+		entities[i] = svs.snapshotEntities[(frame->first_entity + i) % svs.numSnapshotEntities].number;
+	}
+
+	return frame->num_entities;
+}
+
+/**
+ * @brief Writes the packet entities and playerstates of a tv client snapshot
+ *
+ * @details Tv clients receive all entities and playerstates, so clients acknowledging the same snapshot
+ * get the same delta. It is encoded once per server frame and delta base, and appended as is to the
+ * messages of the other clients, only the snapshot header and the tv client own playerstate are encoded per client.
+ *
+ * @param[in] client
+ * @param[in] oldframe
+ * @param[in] frame
+ * @param[in,out] msg
+ */
+static void SV_ETTV_EmitSharedPayload(client_t *client, clientSnapshot_t *oldframe, clientSnapshot_t *frame, msg_t *msg)
+{
+	ettvSharedPayload_t *payload;
+	int                 entitiesDeltaTime, playerstatesDeltaTime;
+	int                 i;
+
+	entitiesDeltaTime = oldframe ? oldframe->serverTime : -1;
+
+	// same conditions as SV_ETTV_EmitPlayerstates
+	if (client->deltaMessage > 0 && client->state == CS_ACTIVE &&
+	    client->netchan.outgoingSequence - client->deltaMessage < (PACKET_BACKUP - 3))
+	{
+		playerstatesDeltaTime = client->frames[client->deltaMessage & PACKET_MASK].serverTime;
+	}
+	else
+	{
+		playerstatesDeltaTime = -1;
+	}
+
+	for (i = 0; i < ETTV_SHARED_PAYLOADS; i++)
+	{
+		payload = &ettvSharedPayloads[i];
+
+		if (payload->time == svs.time &&
+		    payload->entitiesDeltaTime == entitiesDeltaTime &&
+		    payload->playerstatesDeltaTime == playerstatesDeltaTime &&
+		    payload->strip == msg->strip &&
+		    SV_ETTV_SnapshotEntitiesEqual(frame, payload->numEntities, payload->entities) &&
+		    SV_ETTV_SnapshotEntitiesEqual(oldframe, payload->numDeltaEntities, payload->deltaEntities))
+		{
+			SV_ETTV_EmitPlayerstates(client, NULL, qtrue);
+			MSG_WriteBitstream(msg, &payload->msg);
+			return;
+		}
+	}
+
+	// encode a new one, replacing the oldest
+	payload               = &ettvSharedPayloads[ettvSharedPayloadNext];
+	ettvSharedPayloadNext = (ettvSharedPayloadNext + 1) % ETTV_SHARED_PAYLOADS;
+
+	MSG_Init(&payload->msg, payload->data, sizeof(payload->data));
+	payload->msg.strip = msg->strip;
+
+	SV_EmitPacketEntities(client, oldframe, frame, &payload->msg);
+	SV_ETTV_EmitPlayerstates(client, &payload->msg, qtrue);
+
+	if (payload->msg.overflowed)
+	{
+		payload->time   = 0;
+		msg->overflowed = qtrue;
+		return;
+	}
+
+	payload->time                  = svs.time;
+	payload->entitiesDeltaTime     = entitiesDeltaTime;
+	payload->playerstatesDeltaTime = playerstatesDeltaTime;
+	payload->strip                 = msg->strip;
+	payload->numEntities           = SV_ETTV_StoreSnapshotEntities(frame, payload->entities);
+	payload->numDeltaEntities      = SV_ETTV_StoreSnapshotEntities(oldframe, payload->deltaEntities);
+
+	MSG_WriteBitstream(msg, &payload->msg);
 }
 #endif // DEDICATED
 
@@ -338,14 +513,25 @@ static void SV_WriteSnapshotToClient(client_t *client, msg_t *msg)
 	//Com_Printf( "Playerstate delta size: %f\n", ((msg->cursize - sz) * sv_fps->integer) / 8.f );
 	//}
 
-	// delta encode the entities
-	SV_EmitPacketEntities(client, oldframe, frame, msg);
-
 #ifdef DEDICATED
-	if (client->ettvClient && client->state > CS_ZOMBIE)
+	if (client->ettvClient && client->state > CS_ZOMBIE && sv_etltv_sharedSnapshots->integer)
 	{
-		SV_ETTV_EmitPlayerstates(client, msg);
+		// delta encode the entities and playerstates, shared with the other tv clients
+		SV_ETTV_EmitSharedPayload(client, oldframe, frame, msg);
 	}
+	else
+	{
+		// delta encode the entities
+		SV_EmitPacketEntities(client, oldframe, frame, msg);
+
+		if (client->ettvClient && client->state > CS_ZOMBIE)
+		{
+			SV_ETTV_EmitPlayerstates(client, msg, qfalse);
+		}
+	}
+#else
+	// delta encode the entities
+	SV_EmitPacketEntities(client, oldframe, frame, msg);
 #endif // DEDICATED
 
 	client->parseEntitiesNum += frame->num_entities;
@@ -376,7 +562,7 @@ void SV_UpdateServerCommandsToClient(client_t *client, msg_t *msg)
 	{
 		MSG_WriteByte(msg, svc_serverCommand);
 		MSG_WriteLong(msg, i);
-		MSG_WriteString(msg, client->reliableCommands[i & (MAX_RELIABLE_COMMANDS - 1)]);
+		MSG_WriteString(msg, SV_ReliableCommand(client, i));
 	}
 
 	client->reliableSent = client->reliableSequence;
@@ -785,7 +971,8 @@ static void SV_BuildClientSnapshot(client_t *client)
 	sv.snapshotCounter++;
 
 	// this is the frame we are creating
-	frame = &client->frames[client->netchan.outgoingSequence & PACKET_MASK];
+	frame             = &client->frames[client->netchan.outgoingSequence & PACKET_MASK];
+	frame->serverTime = sv.time;
 
 	// clear everything in this snapshot
 	entityNumbers.numSnapshotEntities = 0;
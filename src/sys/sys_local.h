@@ -53,6 +53,9 @@ void GLimp_FlashWindow(int);
 void GLimp_Init(glconfig_t *glConfig, const char *glConfigString);
 void GLimp_Shutdown(void);
 void GLimp_EndFrame(void);
+void GLimp_MakeCurrent(qboolean current);
+void GLimp_SwapWindow(void);
+void GLimp_UpdateWindow(void);
 void GLimp_SetGamma(unsigned char red[256], unsigned char green[256], unsigned char blue[256]);
 qboolean GLimp_SplashImage(qboolean (*LoadSplashImage)(const char *name, byte *data, unsigned int size, unsigned int width, unsigned int height, uint8_t bytes));
 
@@ -55,6 +55,7 @@
 #include <libgen.h>
 #include <fcntl.h>
 #include <sys/wait.h>
+#include <pthread.h>
 #ifdef  __ANDROID__
 #include <jni.h>
 #if defined(__ANDROID_API__) >= 33
@@ -272,6 +273,25 @@ int Sys_Milliseconds(void)
 	return curtime;
 }
 
+/**
+ * @brief Sys_Microseconds
+ * @return current system time in usec, with the same origin as Sys_Milliseconds
+ * so that Sys_Milliseconds() == Sys_Microseconds() / 1000
+ */
+long long Sys_Microseconds(void)
+{
+	struct timespec time;
+
+	if (!sys_timeBase)
+	{
+		Sys_Milliseconds();
+	}
+
+	clock_gettime(clockid, &time);
+
+	return ((long long)time.tv_sec * 1000000 + time.tv_nsec / 1000) - (long long)sys_timeBase * 1000;
+}
+
 /**
  * @param[in,out] v Vector
  */
@@ -767,6 +787,225 @@ void Sys_Sleep(int msec)
 	}
 }
 
+/**
+ * @struct sysThread_t
+ * @brief Entry point and argument handed to a new thread
+ */
+typedef struct
+{
+	pthread_t thread;
+	void (*function)(void *arg);
+	void *arg;
+} sysThread_t;
+
+/**
+ * @struct sysSemaphore_t
+ * @brief Counting semaphore, unnamed POSIX semaphores are not available on every platform
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	int value;
+} sysSemaphore_t;
+
+/**
+ * @brief Sys_ThreadMain
+ * @param[in] arg
+ * @return
+ */
+static void *Sys_ThreadMain(void *arg)
+{
+	sysThread_t *thread = (sysThread_t *)arg;
+
+	thread->function(thread->arg);
+	return NULL;
+}
+
+/**
+ * @brief Starts function(arg) on a new thread
+ * @param[in] function
+ * @param[in] arg
+ * @return Thread handle for Sys_JoinThread or NULL on failure
+ */
+void *Sys_CreateThread(void (*function)(void *arg), void *arg)
+{
+	sysThread_t *thread = calloc(1, sizeof(sysThread_t));
+
+	if (!thread)
+	{
+		return NULL;
+	}
+
+	thread->function = function;
+	thread->arg      = arg;
+
+	if (pthread_create(&thread->thread, NULL, Sys_ThreadMain, thread) != 0)
+	{
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+/**
+ * @brief Waits for a thread to return and releases its handle
+ * @param[in] thread
+ */
+void Sys_JoinThread(void *thread)
+{
+	if (!thread)
+	{
+		return;
+	}
+
+	pthread_join(((sysThread_t *)thread)->thread, NULL);
+	free(thread);
+}
+
+/**
+ * @brief Sys_CreateMutex
+ * @return
+ */
+void *Sys_CreateMutex(void)
+{
+	pthread_mutex_t *mutex = calloc(1, sizeof(pthread_mutex_t));
+
+	if (mutex && pthread_mutex_init(mutex, NULL) != 0)
+	{
+		free(mutex);
+		return NULL;
+	}
+
+	return mutex;
+}
+
+/**
+ * @brief Sys_DestroyMutex
+ * @param[in] mutex
+ */
+void Sys_DestroyMutex(void *mutex)
+{
+	if (!mutex)
+	{
+		return;
+	}
+
+	pthread_mutex_destroy((pthread_mutex_t *)mutex);
+	free(mutex);
+}
+
+/**
+ * @brief Sys_LockMutex
+ * @param[in] mutex
+ */
+void Sys_LockMutex(void *mutex)
+{
+	pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+/**
+ * @brief Sys_UnlockMutex
+ * @param[in] mutex
+ */
+void Sys_UnlockMutex(void *mutex)
+{
+	pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+/**
+ * @brief Sys_CreateSemaphore
+ * @param[in] value Initial count
+ * @return
+ */
+void *Sys_CreateSemaphore(int value)
+{
+	sysSemaphore_t *sem = calloc(1, sizeof(sysSemaphore_t));
+
+	if (!sem)
+	{
+		return NULL;
+	}
+
+	if (pthread_mutex_init(&sem->mutex, NULL) != 0)
+	{
+		free(sem);
+		return NULL;
+	}
+
+	if (pthread_cond_init(&sem->cond, NULL) != 0)
+	{
+		pthread_mutex_destroy(&sem->mutex);
+		free(sem);
+		return NULL;
+	}
+
+	sem->value = value;
+
+	return sem;
+}
+
+/**
+ * @brief Sys_DestroySemaphore
+ * @param[in] semaphore
+ */
+void Sys_DestroySemaphore(void *semaphore)
+{
+	sysSemaphore_t *sem = (sysSemaphore_t *)semaphore;
+
+	if (!sem)
+	{
+		return;
+	}
+
+	pthread_cond_destroy(&sem->cond);
+	pthread_mutex_destroy(&sem->mutex);
+	free(sem);
+}
+
+/**
+ * @brief Increments the count and wakes up one waiting thread
+ * @param[in] semaphore
+ */
+void Sys_SemaphorePost(void *semaphore)
+{
+	sysSemaphore_t *sem = (sysSemaphore_t *)semaphore;
+
+	pthread_mutex_lock(&sem->mutex);
+	sem->value++;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->mutex);
+}
+
+/**
+ * @brief Blocks until the count is positive and decrements it
+ * @param[in] semaphore
+ */
+void Sys_SemaphoreWait(void *semaphore)
+{
+	sysSemaphore_t *sem = (sysSemaphore_t *)semaphore;
+
+	pthread_mutex_lock(&sem->mutex);
+	while (sem->value <= 0)
+	{
+		pthread_cond_wait(&sem->cond, &sem->mutex);
+	}
+	sem->value--;
+	pthread_mutex_unlock(&sem->mutex);
+}
+
+/**
+ * @brief Sys_NumCPUs
+ * @return Number of online logical processors
+ */
+int Sys_NumCPUs(void)
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return count > 0 ? (int)count : 1;
+}
+
 /**
  * @brief Displays an error message and writes the error into crashlog.txt
  * @param[in] error Error String
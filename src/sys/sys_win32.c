@@ -772,6 +772,176 @@ void Sys_Sleep(int msec)
 #endif
 }
 
+/**
+ * @struct sysThread_t
+ * @brief Entry point and argument handed to a new thread
+ */
+typedef struct
+{
+	HANDLE handle;
+	void (*function)(void *arg);
+	void *arg;
+} sysThread_t;
+
+/**
+ * @brief Sys_ThreadMain
+ * @param[in] arg
+ * @return
+ */
+static DWORD WINAPI Sys_ThreadMain(LPVOID arg)
+{
+	sysThread_t *thread = (sysThread_t *)arg;
+
+	thread->function(thread->arg);
+	return 0;
+}
+
+/**
+ * @brief Starts function(arg) on a new thread
+ * @param[in] function
+ * @param[in] arg
+ * @return Thread handle for Sys_JoinThread or NULL on failure
+ */
+void *Sys_CreateThread(void (*function)(void *arg), void *arg)
+{
+	sysThread_t *thread = calloc(1, sizeof(sysThread_t));
+
+	if (!thread)
+	{
+		return NULL;
+	}
+
+	thread->function = function;
+	thread->arg      = arg;
+	thread->handle   = CreateThread(NULL, 0, Sys_ThreadMain, thread, 0, NULL);
+
+	if (!thread->handle)
+	{
+		free(thread);
+		return NULL;
+	}
+
+	return thread;
+}
+
+/**
+ * @brief Waits for a thread to return and releases its handle
+ * @param[in] thread
+ */
+void Sys_JoinThread(void *thread)
+{
+	if (!thread)
+	{
+		return;
+	}
+
+	WaitForSingleObject(((sysThread_t *)thread)->handle, INFINITE);
+	CloseHandle(((sysThread_t *)thread)->handle);
+	free(thread);
+}
+
+/**
+ * @brief Sys_CreateMutex
+ * @return
+ */
+void *Sys_CreateMutex(void)
+{
+	CRITICAL_SECTION *mutex = calloc(1, sizeof(CRITICAL_SECTION));
+
+	if (mutex)
+	{
+		InitializeCriticalSection(mutex);
+	}
+
+	return mutex;
+}
+
+/**
+ * @brief Sys_DestroyMutex
+ * @param[in] mutex
+ */
+void Sys_DestroyMutex(void *mutex)
+{
+	if (!mutex)
+	{
+		return;
+	}
+
+	DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+	free(mutex);
+}
+
+/**
+ * @brief Sys_LockMutex
+ * @param[in] mutex
+ */
+void Sys_LockMutex(void *mutex)
+{
+	EnterCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/**
+ * @brief Sys_UnlockMutex
+ * @param[in] mutex
+ */
+void Sys_UnlockMutex(void *mutex)
+{
+	LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/**
+ * @brief Sys_CreateSemaphore
+ * @param[in] value Initial count
+ * @return
+ */
+void *Sys_CreateSemaphore(int value)
+{
+	return CreateSemaphore(NULL, value, MAXLONG, NULL);
+}
+
+/**
+ * @brief Sys_DestroySemaphore
+ * @param[in] semaphore
+ */
+void Sys_DestroySemaphore(void *semaphore)
+{
+	if (semaphore)
+	{
+		CloseHandle((HANDLE)semaphore);
+	}
+}
+
+/**
+ * @brief Increments the count and wakes up one waiting thread
+ * @param[in] semaphore
+ */
+void Sys_SemaphorePost(void *semaphore)
+{
+	ReleaseSemaphore((HANDLE)semaphore, 1, NULL);
+}
+
+/**
+ * @brief Blocks until the count is positive and decrements it
+ * @param[in] semaphore
+ */
+void Sys_SemaphoreWait(void *semaphore)
+{
+	WaitForSingleObject((HANDLE)semaphore, INFINITE);
+}
+
+/**
+ * @brief Sys_NumCPUs
+ * @return Number of logical processors
+ */
+int Sys_NumCPUs(void)
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+
+	return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
 /**
  * @brief Display an error message
  * @param[in] error